@@ -0,0 +1,180 @@
+/***************************************************************************
+                          testchebyshevcache.cpp  -
+                             -------------------
+    begin                : Sat Mar 11 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "testchebyshevcache.h"
+
+#include <cmath>
+
+#include <QThread>
+
+namespace {
+
+// Evaluates a cache at the given times from its own thread
+class QueryThread : public QThread
+{
+public:
+    QueryThread( ChebyshevCache *cache, const ChebyshevCache::Function &f, const QVector<double> &times ) :
+        m_Cache( cache ), m_Function( f ), m_Times( times ) {}
+
+protected:
+    void run() {
+        double value;
+        foreach ( double t, m_Times )
+            m_Cache->evaluate( t, &value, m_Function );
+    }
+
+private:
+    ChebyshevCache *m_Cache;
+    ChebyshevCache::Function m_Function;
+    QVector<double> m_Times;
+};
+
+}
+
+TestChebyshevCache::TestChebyshevCache() : QObject()
+{
+}
+
+TestChebyshevCache::~TestChebyshevCache()
+{
+}
+
+void TestChebyshevCache::polynomialIsExact()
+{
+    // A polynomial of degree lower than the order is reproduced exactly
+    ChebyshevCache cache( 4.0, 6, 2 );
+    ChebyshevCache::Function f = []( double t, double *v ) {
+        v[0] = 3.0 - 2.0*t + 0.5*t*t*t;
+        v[1] = 1.0e5 + t;
+    };
+
+    for ( double t = -10.0; t < 10.0; t += 0.37 ) {
+        double expected[2], values[2];
+        f( t, expected );
+        cache.evaluate( t, values, f );
+        QVERIFY( fabs( values[0] - expected[0] ) < 1e-9 * ( 1.0 + fabs( expected[0] ) ) );
+        QVERIFY( fabs( values[1] - expected[1] ) < 1e-9 * expected[1] );
+    }
+}
+
+void TestChebyshevCache::periodicAccuracy()
+{
+    // Segments covering an eighth of the period, as used for the planets
+    const double period = 87.97;
+    ChebyshevCache cache( period / 8.0, 12, 1 );
+    ChebyshevCache::Function f = [period]( double t, double *v ) {
+        double M = 2.0 * M_PI * t / period;
+        v[0] = M + 0.41 * sin( M ) + 0.04 * sin( 2.0 * M ) + 0.005 * sin( 3.0 * M );
+    };
+
+    for ( double t = 0.0; t < 2.0 * period; t += 0.113 ) {
+        double expected, value;
+        f( t, &expected );
+        cache.evaluate( t, &value, f );
+        QVERIFY( fabs( value - expected ) < 1e-10 );
+    }
+}
+
+void TestChebyshevCache::fitsOncePerSegment()
+{
+    int calls = 0;
+    ChebyshevCache cache( 1.0, 8, 1 );
+    ChebyshevCache::Function f = [&calls]( double t, double *v ) {
+        ++calls;
+        v[0] = sin( t );
+    };
+
+    double value;
+    for ( int i = 0; i < 100; ++i )
+        cache.evaluate( 0.005 * i, &value, f );
+    QCOMPARE( calls, 9 );
+    QCOMPARE( cache.segmentCount(), 1 );
+
+    cache.evaluate( 1.5, &value, f );
+    QCOMPARE( calls, 18 );
+    QCOMPARE( cache.segmentCount(), 2 );
+}
+
+void TestChebyshevCache::skipsScatteredQueries()
+{
+    int calls = 0;
+    ChebyshevCache cache( 1.0, 8, 1 );
+    ChebyshevCache::Function f = [&calls]( double t, double *v ) {
+        ++calls;
+        v[0] = sin( t );
+    };
+
+    double value;
+    cache.evaluate( 0.5, &value, f );
+    cache.evaluate( 10.5, &value, f );
+    QCOMPARE( calls, 18 );
+
+    // Two misses far apart in a row: evaluated directly, nothing cached
+    cache.evaluate( 20.5, &value, f );
+    QCOMPARE( calls, 19 );
+    QCOMPARE( value, sin( 20.5 ) );
+    cache.evaluate( 30.5, &value, f );
+    QCOMPARE( calls, 20 );
+    QCOMPARE( cache.segmentCount(), 2 );
+
+    // Back to nearby queries, the segment is fitted
+    cache.evaluate( 30.6, &value, f );
+    QCOMPARE( calls, 29 );
+    QCOMPARE( cache.segmentCount(), 3 );
+}
+
+void TestChebyshevCache::followsMissesPerThread()
+{
+    int calls = 0;
+    ChebyshevCache cache( 1.0, 8, 1 );
+    ChebyshevCache::Function f = [&calls]( double t, double *v ) {
+        ++calls;
+        v[0] = sin( t );
+    };
+
+    double value;
+    cache.evaluate( 0.5, &value, f );
+    QCOMPARE( calls, 9 );
+
+    // Another thread queries scattered times until it evaluates directly
+    QueryThread other( &cache, f, QVector<double>() << 10.5 << 20.5 << 30.5 );
+    other.start();
+    QVERIFY( other.wait() );
+    QCOMPARE( calls, 28 );
+    QCOMPARE( cache.segmentCount(), 3 );
+
+    // This thread still fits next to its own previous miss
+    cache.evaluate( 1.5, &value, f );
+    QCOMPARE( calls, 37 );
+    QCOMPARE( cache.segmentCount(), 4 );
+}
+
+void TestChebyshevCache::evictsSegments()
+{
+    ChebyshevCache cache( 1.0, 4, 1, 4 );
+    ChebyshevCache::Function f = []( double t, double *v ) { v[0] = t; };
+
+    double value;
+    for ( int i = 0; i < 10; ++i )
+        cache.evaluate( i + 0.5, &value, f );
+    QCOMPARE( cache.segmentCount(), 4 );
+
+    cache.clear();
+    QCOMPARE( cache.segmentCount(), 0 );
+}
+
+QTEST_GUILESS_MAIN(TestChebyshevCache)
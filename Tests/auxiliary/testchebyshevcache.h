@@ -0,0 +1,48 @@
+/***************************************************************************
+                          testchebyshevcache.h  -
+                             -------------------
+    begin                : Sat Mar 11 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTCHEBYSHEVCACHE_H
+#define TESTCHEBYSHEVCACHE_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "auxiliary/chebyshevcache.h"
+
+/**
+ * @class TestChebyshevCache
+ * @short Tests for ChebyshevCache
+ */
+
+class TestChebyshevCache : public QObject {
+
+    Q_OBJECT
+
+public:
+    TestChebyshevCache();
+    ~TestChebyshevCache();
+
+private slots:
+    void polynomialIsExact();
+    void periodicAccuracy();
+    void fitsOncePerSegment();
+    void skipsScatteredQueries();
+    void followsMissesPerThread();
+    void evictsSegments();
+};
+
+#endif
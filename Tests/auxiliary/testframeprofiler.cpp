@@ -0,0 +1,106 @@
+/***************************************************************************
+                          testframeprofiler.cpp  -
+                             -------------------
+    begin                : Sun Mar 26 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "testframeprofiler.h"
+
+#include <QThread>
+
+// Find the line of the report for a section, and split its values
+static QStringList reportValues( const QString &report, const QString &name )
+{
+    foreach ( const QString &line, report.split( '\n' ) ) {
+        if ( line.startsWith( name + ": " ) )
+            return line.mid( name.length() + 2 ).split( ' ' );
+    }
+    return QStringList();
+}
+
+TestFrameProfiler::TestFrameProfiler() : QObject()
+{
+}
+
+TestFrameProfiler::~TestFrameProfiler()
+{
+}
+
+void TestFrameProfiler::cleanup()
+{
+    FrameProfiler::Instance()->setEnabled( false );
+}
+
+void TestFrameProfiler::disabledRecordsNothing()
+{
+    FrameProfiler *profiler = FrameProfiler::Instance();
+    profiler->setEnabled( false );
+
+    profiler->beginFrame();
+    profiler->addCount( "stars drawn", 10 );
+    profiler->endFrame();
+
+    QCOMPARE( profiler->frameCount(), 0 );
+    QVERIFY( reportValues( profiler->report(), "stars drawn" ).isEmpty() );
+}
+
+void TestFrameProfiler::countersPerFrame()
+{
+    FrameProfiler *profiler = FrameProfiler::Instance();
+    profiler->setEnabled( true );
+
+    // Counters are summed within a frame: last, average and maximum
+    const int counts[] = { 10, 30, 20 };
+    for ( int count : counts ) {
+        profiler->beginFrame();
+        profiler->addCount( "stars drawn", count / 2 );
+        profiler->addCount( "stars drawn", count - count / 2 );
+        profiler->endFrame();
+    }
+    QCOMPARE( profiler->frameCount(), 3 );
+    QCOMPARE( reportValues( profiler->report(), "stars drawn" ), QStringList() << "20" << "20" << "30" );
+
+    // A counter missing from a frame counts as zero
+    profiler->beginFrame();
+    profiler->endFrame();
+    QCOMPARE( reportValues( profiler->report(), "stars drawn" ), QStringList() << "0" << "15" << "30" );
+
+    // Enabling again starts afresh
+    profiler->setEnabled( true );
+    QCOMPARE( profiler->frameCount(), 0 );
+    QVERIFY( reportValues( profiler->report(), "stars drawn" ).isEmpty() );
+}
+
+void TestFrameProfiler::timersAddUp()
+{
+    FrameProfiler *profiler = FrameProfiler::Instance();
+    profiler->setEnabled( true );
+
+    profiler->beginFrame();
+    {
+        FrameProfiler::Timer timer( "draw stars" );
+        QThread::msleep( 20 );
+    }
+    profiler->endFrame();
+
+    QString report = profiler->report();
+    QStringList stars = reportValues( report, "draw stars" );
+    QStringList frame = reportValues( report, "frame" );
+    QCOMPARE( stars.size(), 3 );
+    QCOMPARE( frame.size(), 3 );
+    QVERIFY( stars[0].toDouble() >= 19.0 );
+    QVERIFY( frame[0].toDouble() >= stars[0].toDouble() );
+}
+
+QTEST_GUILESS_MAIN(TestFrameProfiler)
@@ -0,0 +1,46 @@
+/***************************************************************************
+                          testframeprofiler.h  -
+                             -------------------
+    begin                : Sun Mar 26 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTFRAMEPROFILER_H
+#define TESTFRAMEPROFILER_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "auxiliary/frameprofiler.h"
+
+/**
+ * @class TestFrameProfiler
+ * @short Tests for FrameProfiler
+ */
+
+class TestFrameProfiler : public QObject {
+
+    Q_OBJECT
+
+public:
+    TestFrameProfiler();
+    ~TestFrameProfiler();
+
+private slots:
+    void cleanup();
+    void disabledRecordsNothing();
+    void countersPerFrame();
+    void timersAddUp();
+};
+
+#endif
@@ -0,0 +1,102 @@
+/***************************************************************************
+                          testobjectnameindex.cpp  -
+                             -------------------
+    begin                : Sun Apr 16 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "testobjectnameindex.h"
+
+// The names of the entries found, the objects themselves are not needed
+static QStringList names( const QVector<ObjectNameIndex::Entry> &entries )
+{
+    QStringList result;
+    foreach ( const ObjectNameIndex::Entry &entry, entries )
+        result.append( entry.first );
+    return result;
+}
+
+TestObjectNameIndex::TestObjectNameIndex() : QObject()
+{
+}
+
+TestObjectNameIndex::~TestObjectNameIndex()
+{
+}
+
+void TestObjectNameIndex::initTestCase()
+{
+    QHash<int, QVector<ObjectNameIndex::Entry> > lists;
+    const SkyObject *none = 0;
+    lists[0] << qMakePair( QString( "NGC 224" ), none )
+             << qMakePair( QString( "NGC 2244" ), none )
+             << qMakePair( QString( "M 31" ), none );
+    lists[1] << qMakePair( QString( "Andromeda Galaxy" ), none )
+             << qMakePair( QString( "Barnard's Star" ), none );
+    lists[2] << qMakePair( QString::fromUtf8( "Pollux" ), none )
+             << qMakePair( QString::fromUtf8( "Alpha Cen" ), none )
+             << qMakePair( QString::fromUtf8( "Ganymède" ), none );
+    m_Index.build( lists );
+    QCOMPARE( m_Index.size(), 8 );
+}
+
+void TestObjectNameIndex::normalize_data()
+{
+    QTest::addColumn<QString>( "name" );
+    QTest::addColumn<QString>( "key" );
+
+    QTest::newRow( "catalog" ) << "NGC 224" << "ngc224";
+    QTest::newRow( "punctuation" ) << "Barnard's Star" << "barnardsstar";
+    QTest::newRow( "diacritics" ) << QString::fromUtf8( "Ganymède" ) << "ganymede";
+    QTest::newRow( "empty" ) << "" << "";
+}
+
+void TestObjectNameIndex::normalize()
+{
+    QFETCH( QString, name );
+    QFETCH( QString, key );
+    QCOMPARE( ObjectNameIndex::normalize( name ), key );
+}
+
+void TestObjectNameIndex::findSubstring()
+{
+    QCOMPARE( names( m_Index.find( "ngc-224" ) ).toSet(), QSet<QString>() << "NGC 224" << "NGC 2244" );
+    QCOMPARE( names( m_Index.find( "GALAXY" ) ), QStringList() << "Andromeda Galaxy" );
+    QCOMPARE( names( m_Index.find( "ganymede" ) ), QStringList() << QString::fromUtf8( "Ganymède" ) );
+    QVERIFY( m_Index.find( "galaxies" ).isEmpty() );
+    // All the trigrams are there, but not in that order
+    QVERIFY( m_Index.find( "lluxpo" ).isEmpty() );
+}
+
+void TestObjectNameIndex::findShortText()
+{
+    QCOMPARE( names( m_Index.find( "m 3" ) ), QStringList() << "M 31" );
+    QCOMPARE( m_Index.find( QString() ).size(), m_Index.size() );
+}
+
+void TestObjectNameIndex::findPrefix()
+{
+    QCOMPARE( names( m_Index.findPrefix( "ngc 22" ) ), QStringList() << "NGC 224" << "NGC 2244" );
+    QCOMPARE( names( m_Index.findPrefix( "a" ) ), QStringList() << "Alpha Cen" << "Andromeda Galaxy" );
+    QVERIFY( m_Index.findPrefix( "galaxy" ).isEmpty() );
+}
+
+void TestObjectNameIndex::filterTypes()
+{
+    QCOMPARE( names( m_Index.find( "a", QList<int>() << 1 ) ).toSet(),
+              QSet<QString>() << "Andromeda Galaxy" << "Barnard's Star" );
+    QCOMPARE( names( m_Index.findPrefix( "a", QList<int>() << 2 ) ), QStringList() << "Alpha Cen" );
+    QVERIFY( m_Index.find( "ngc", QList<int>() << 1 << 2 ).isEmpty() );
+}
+
+QTEST_GUILESS_MAIN(TestObjectNameIndex)
@@ -0,0 +1,52 @@
+/***************************************************************************
+                          testobjectnameindex.h  -
+                             -------------------
+    begin                : Sun Apr 16 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTOBJECTNAMEINDEX_H
+#define TESTOBJECTNAMEINDEX_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "auxiliary/objectnameindex.h"
+
+/**
+ * @class TestObjectNameIndex
+ * @short Tests for ObjectNameIndex
+ */
+
+class TestObjectNameIndex : public QObject {
+
+    Q_OBJECT
+
+public:
+    TestObjectNameIndex();
+    ~TestObjectNameIndex();
+
+private slots:
+    void initTestCase();
+    void normalize_data();
+    void normalize();
+    void findSubstring();
+    void findShortText();
+    void findPrefix();
+    void filterTypes();
+
+private:
+    ObjectNameIndex m_Index;
+};
+
+#endif
@@ -0,0 +1,202 @@
+/***************************************************************************
+                          benchskyrender.cpp  -
+                             -------------------
+    begin                : Sat Apr 01 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "benchskyrender.h"
+
+#include <QApplication>
+#include <QImage>
+
+#ifdef Q_OS_LINUX
+#include <QFile>
+#endif
+
+#include "kstarsdata.h"
+#include "skycomponents/skymapcomposite.h"
+#include "skymap.h"
+#include "Options.h"
+#include "colorscheme.h"
+#include "simclock.h"
+#include "ksnumbers.h"
+#include "kstarsdatetime.h"
+#include "projections/projector.h"
+#include "auxiliary/frameprofiler.h"
+
+// Size of the rendered images, a common desktop sky map
+static const int imageWidth = 1280;
+static const int imageHeight = 800;
+
+// Memory of the process in kilobytes from /proc/self/status, or -1 if unknown:
+// VmRSS is the current resident memory, VmHWM its peak so far
+static long memoryStatus( const char *field )
+{
+#ifdef Q_OS_LINUX
+    QFile status( "/proc/self/status" );
+    if ( status.open( QIODevice::ReadOnly ) ) {
+        const QByteArray prefix = QByteArray( field ) + ':';
+        foreach ( const QByteArray &line, status.readAll().split( '\n' ) ) {
+            if ( line.startsWith( prefix ) )
+                return line.mid( prefix.size() ).simplified().split( ' ' ).value( 0 ).toLong();
+        }
+    }
+#else
+    Q_UNUSED( field )
+#endif
+    return -1;
+}
+
+BenchSkyRender::BenchSkyRender() : QObject(), m_Data( 0 ), m_Map( 0 ), m_Draw( 0 )
+{
+}
+
+BenchSkyRender::~BenchSkyRender()
+{
+}
+
+void BenchSkyRender::initTestCase()
+{
+    // Same initialization as the --dump mode of KStars
+    m_Data = KStarsData::Create();
+    QVERIFY( m_Data->initialize() );
+    m_Data->skyComposite()->waitForLoading();
+    m_Data->setLocationFromOptions();
+    m_Data->colorScheme()->loadFromConfig();
+
+    // Views are given in equatorial coordinates, and must not depend on the settings of the machine
+    Options::setUseAltAz( false );
+    Options::setShowGround( false );
+    Options::setParallelRendering( true );
+    Options::setShowFrameProfile( false );
+
+    // The sky map is shown on the offscreen platform, so that its drawing widget gets
+    // its size, and frames go through SkyMapQDraw::paintEvent() like on the screen
+    m_Map = SkyMap::Create();
+    m_Map->resize( imageWidth, imageHeight );
+    m_Map->show();
+    qApp->processEvents();
+    m_Draw = dynamic_cast<QWidget *>( m_Map->getSkyMapDrawAbstract() );
+    QVERIFY( m_Draw );
+    QCOMPARE( m_Draw->size(), QSize( imageWidth, imageHeight ) );
+
+    qDebug() << "Resident memory after loading the catalogs:" << memoryStatus( "VmRSS" ) << "kB, peak"
+             << memoryStatus( "VmHWM" ) << "kB";
+}
+
+void BenchSkyRender::cleanupTestCase()
+{
+    FrameProfiler::Instance()->setEnabled( false );
+    delete m_Map;
+    delete m_Data;
+}
+
+void BenchSkyRender::renderView_data()
+{
+    QTest::addColumn<QDateTime>( "utc" );
+    QTest::addColumn<double>( "ra" );       // hours
+    QTest::addColumn<double>( "dec" );      // degrees
+    QTest::addColumn<double>( "zoom" );     // pixels per radian
+    QTest::addColumn<int>( "projection" );
+
+    QDateTime epoch( QDate( 2017, 3, 20 ), QTime( 22, 0, 0 ), Qt::UTC );
+    QDateTime future( QDate( 2042, 9, 1 ), QTime( 3, 30, 0 ), Qt::UTC );
+
+    // Star-rich fields: the galactic center, and Cygnus along the Milky Way
+    QTest::newRow( "galactic center, whole sky" ) << epoch << 17.76 << -29.0 << 250.0 << int( Projector::Lambert );
+    QTest::newRow( "galactic center, 10 degrees" ) << epoch << 17.76 << -29.0 << 8000.0 << int( Projector::Lambert );
+    QTest::newRow( "galactic center, 1 degree" ) << epoch << 17.76 << -29.0 << 80000.0 << int( Projector::Lambert );
+    QTest::newRow( "cygnus, stereographic" ) << epoch << 20.7 << 42.0 << 1000.0 << int( Projector::Stereographic );
+
+    // Star-poor fields: the north galactic pole
+    QTest::newRow( "galactic pole, whole sky" ) << epoch << 12.85 << 27.1 << 250.0 << int( Projector::Lambert );
+    QTest::newRow( "galactic pole, 1 degree" ) << epoch << 12.85 << 27.1 << 80000.0 << int( Projector::Lambert );
+
+    // Other projections, and a time far from the epoch of the catalogs
+    QTest::newRow( "orion, orthographic" ) << epoch << 5.58 << -5.4 << 2000.0 << int( Projector::Orthographic );
+    QTest::newRow( "orion, gnomonic, 2042" ) << future << 5.58 << -5.4 << 2000.0 << int( Projector::Gnomonic );
+    QTest::newRow( "equator, equirectangular" ) << epoch << 0.0 << 0.0 << 250.0 << int( Projector::Equirectangular );
+    QTest::newRow( "ecliptic, azimuthal equidistant, 2042" ) << future << 6.0 << 23.4 << 500.0 << int( Projector::AzimuthalEquidistant );
+}
+
+void BenchSkyRender::renderView()
+{
+    QFETCH( QDateTime, utc );
+    QFETCH( double, ra );
+    QFETCH( double, dec );
+    QFETCH( double, zoom );
+    QFETCH( int, projection );
+
+    long memoryBefore = memoryStatus( "VmRSS" );
+    setView( utc, ra, dec, zoom, projection );
+
+    QImage image( imageWidth, imageHeight, QImage::Format_ARGB32_Premultiplied );
+
+    // The first frame loads the star blocks and the textures of the field, it is not timed
+    render( image );
+
+    FrameProfiler *profiler = FrameProfiler::Instance();
+    profiler->setEnabled( true );
+    QBENCHMARK {
+        render( image );
+    }
+
+    qDebug() << qPrintable( profiler->report() );
+    long memory = memoryStatus( "VmRSS" );
+    if ( memory >= 0 )
+        qDebug() << "Resident memory:" << memory << "kB," << memory - memoryBefore << "kB more than before this view,"
+                 << "peak" << memoryStatus( "VmHWM" ) << "kB";
+    profiler->setEnabled( false );
+}
+
+void BenchSkyRender::setView( const QDateTime &utc, double ra, double dec, double zoom, int projection )
+{
+    Options::setProjection( projection );
+    Options::setZoomFactor( zoom );
+
+    m_Data->clock()->setUTC( KStarsDateTime( utc ) );
+    m_Data->setFullTimeUpdate();
+    m_Data->updateTime( m_Data->geo() );
+
+    SkyPoint dest( ra, dec );
+    dest.apparentCoord( J2000, m_Data->updateNum()->julianDay() );
+    m_Map->setDestination( dest );
+    m_Map->destination()->EquatorialToHorizontal( m_Data->lst(), m_Data->geo()->lat() );
+    m_Map->setFocus( m_Map->destination() );
+    m_Map->focus()->EquatorialToHorizontal( m_Data->lst(), m_Data->geo()->lat() );
+
+    qApp->processEvents();
+    m_Map->setupProjector();
+}
+
+void BenchSkyRender::render( QImage &image )
+{
+    // A full frame: all the layers of SkyMapQDraw are drawn again, the independent
+    // ones on the thread pool. paintEvent() takes care of the frame profiler.
+    m_Map->forceUpdate();
+    m_Draw->render( &image );
+}
+
+int main( int argc, char *argv[] )
+{
+    // Render without a display
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+    // Keep the configuration of the user out of the measurements
+    QStandardPaths::setTestModeEnabled( true );
+
+    QApplication app( argc, argv );
+    BenchSkyRender bench;
+    return QTest::qExec( &bench, argc, argv );
+}
@@ -0,0 +1,69 @@
+/***************************************************************************
+                          benchskyrender.h  -
+                             -------------------
+    begin                : Sat Apr 01 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef BENCHSKYRENDER_H
+#define BENCHSKYRENDER_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+class KStarsData;
+class SkyMap;
+
+/**
+ * @class BenchSkyRender
+ * @short Benchmark of the rendering of the sky map
+ *
+ * The catalogs are loaded as in the --dump mode of KStars, and a set of
+ * views is rendered offscreen to a QImage through SkyMapQDraw::paintEvent(),
+ * with parallel rendering enabled. For each view, the time of a full frame
+ * is measured by QBENCHMARK, and the breakdown of the frame by FrameProfiler
+ * and the resident memory of the process, its change over the view and
+ * its peak so far are printed.
+ *
+ * It does not need a display, the offscreen platform is used unless
+ * QT_QPA_PLATFORM is set.
+ */
+
+class BenchSkyRender : public QObject {
+
+    Q_OBJECT
+
+public:
+    BenchSkyRender();
+    ~BenchSkyRender();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void renderView_data();
+    void renderView();
+
+private:
+    /** Set the time, the focus and the projection of the sky map */
+    void setView( const QDateTime &utc, double ra, double dec, double zoom, int projection );
+
+    /** Draw all the layers of the sky map once, and copy the sky map to @p image */
+    void render( QImage &image );
+
+    KStarsData *m_Data;
+    SkyMap *m_Map;
+    QWidget *m_Draw;    // the SkyMapQDraw of m_Map
+};
+
+#endif
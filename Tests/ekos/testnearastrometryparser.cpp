@@ -0,0 +1,137 @@
+/***************************************************************************
+                          testnearastrometryparser.cpp  -
+                             -------------------
+    begin                : Sat Apr 15 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "testnearastrometryparser.h"
+
+#include <complex>
+#include <random>
+
+using Ekos::NearAstrometryParser;
+
+typedef std::complex<double> Complex;
+
+// Size of the synthetic image, in pixels
+static const double imageWidth = 1000;
+static const double imageHeight = 700;
+
+// Stars spread over a square of the tangent plane, brightest first
+static QVector<NearAstrometryParser::CatalogStar> makeCatalog( std::mt19937 &random, int count, double halfSize )
+{
+    std::uniform_real_distribution<double> position( -halfSize, halfSize );
+    QVector<NearAstrometryParser::CatalogStar> catalog;
+    for ( int i = 0; i < count; ++i ) {
+        NearAstrometryParser::CatalogStar star;
+        star.pos = QPointF( position( random ), position( random ) );
+        star.mag = 5.0 + 10.0 * i / count;
+        catalog.append( star );
+    }
+    return catalog;
+}
+
+TestNearAstrometryParser::TestNearAstrometryParser() : QObject()
+{
+}
+
+TestNearAstrometryParser::~TestNearAstrometryParser()
+{
+}
+
+void TestNearAstrometryParser::recoversTransform_data()
+{
+    QTest::addColumn<double>( "scale" );        // tangent plane pixels per image pixel
+    QTest::addColumn<double>( "rotation" );     // degrees
+    QTest::addColumn<bool>( "flipped" );
+    QTest::addColumn<QPointF>( "center" );      // center of the image on the tangent plane
+
+    QTest::newRow( "aligned" ) << 1.0 << 0.0 << false << QPointF( 0, 0 );
+    QTest::newRow( "rotated, off center" ) << 1.0 << 35.0 << false << QPointF( 120, -80 );
+    QTest::newRow( "rotated, flipped" ) << 1.0 << 200.0 << true << QPointF( -60, 150 );
+    QTest::newRow( "larger scale, flipped" ) << 1.03 << -72.0 << true << QPointF( 250, 40 );
+    QTest::newRow( "smaller scale" ) << 0.97 << 118.0 << false << QPointF( -200, -170 );
+}
+
+void TestNearAstrometryParser::recoversTransform()
+{
+    QFETCH( double, scale );
+    QFETCH( double, rotation );
+    QFETCH( bool, flipped );
+    QFETCH( QPointF, center );
+
+    std::mt19937 random( 42 );
+    QVector<NearAstrometryParser::CatalogStar> catalog = makeCatalog( random, 500, 1500 );
+
+    // Image the catalog stars through the inverse of the transform the matcher looks for,
+    // in the order of their brightness
+    const Complex m = std::polar( scale, rotation * M_PI / 180.0 );
+    const Complex t( center.x(), center.y() );
+    std::normal_distribution<double> noise( 0.0, 0.5 );
+    QVector<QPointF> image;
+    int inField = 0;
+    foreach ( const NearAstrometryParser::CatalogStar &star, catalog ) {
+        Complex z = ( Complex( star.pos.x(), star.pos.y() ) - t ) / m;
+        if ( flipped )
+            z = std::conj( z );
+        if ( qAbs( z.real() ) > imageWidth / 2 || qAbs( z.imag() ) > imageHeight / 2 )
+            continue;
+        // Some stars are not detected
+        if ( ++inField % 7 == 0 )
+            continue;
+        image.append( QPointF( z.real() + noise( random ), z.imag() + noise( random ) ) );
+    }
+    QVERIFY( image.size() > 20 );
+
+    // Hot pixels and satellites among the brightest detections
+    std::uniform_real_distribution<double> x( -imageWidth / 2, imageWidth / 2 ), y( -imageHeight / 2, imageHeight / 2 );
+    image.insert( 1, QPointF( x( random ), y( random ) ) );
+    image.insert( 4, QPointF( x( random ), y( random ) ) );
+    image.insert( 9, QPointF( x( random ), y( random ) ) );
+    // The solver passes the 40 brightest detections
+    if ( image.size() > 40 )
+        image.resize( 40 );
+
+    QAtomicInt abort;
+    NearAstrometryParser::Match match;
+    QVERIFY( NearAstrometryParser::matchStars( image, catalog, abort, match ) );
+
+    QCOMPARE( match.flipped, flipped );
+    QVERIFY( match.matches >= image.size() - 3 - 1 );
+
+    Complex found( match.mRe, match.mIm );
+    QVERIFY( qAbs( std::abs( found ) - scale ) < 2e-3 );
+    double error = std::arg( found / m ) * 180.0 / M_PI;
+    QVERIFY2( qAbs( error ) < 0.1, qPrintable( QString( "Rotation off by %1 degrees" ).arg( error ) ) );
+    QVERIFY( qAbs( match.tRe - center.x() ) < 1.0 );
+    QVERIFY( qAbs( match.tIm - center.y() ) < 1.0 );
+}
+
+void TestNearAstrometryParser::tooFewStars()
+{
+    std::mt19937 random( 42 );
+    QVector<NearAstrometryParser::CatalogStar> catalog = makeCatalog( random, 500, 1500 );
+
+    QVector<QPointF> image;
+    for ( int i = 0; i < 5; ++i )
+        image.append( catalog[ i ].pos );
+
+    QAtomicInt abort;
+    NearAstrometryParser::Match match;
+    QVERIFY( !NearAstrometryParser::matchStars( image, catalog, abort, match ) );
+    QVERIFY( !NearAstrometryParser::matchStars( QVector<QPointF>(), catalog, abort, match ) );
+    QCOMPARE( match.matches, 0 );
+}
+
+QTEST_GUILESS_MAIN( TestNearAstrometryParser )
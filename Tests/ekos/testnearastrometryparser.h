@@ -0,0 +1,48 @@
+/***************************************************************************
+                          testnearastrometryparser.h  -
+                             -------------------
+    begin                : Sat Apr 15 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTNEARASTROMETRYPARSER_H
+#define TESTNEARASTROMETRYPARSER_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "ekos/align/nearastrometryparser.h"
+
+/**
+ * @class TestNearAstrometryParser
+ * @short Tests for the star matching of Ekos::NearAstrometryParser
+ *
+ * The image stars are taken from a synthetic catalog field through a known
+ * transform, with noise, missing stars and spurious detections.
+ */
+
+class TestNearAstrometryParser : public QObject {
+
+    Q_OBJECT
+
+public:
+    TestNearAstrometryParser();
+    ~TestNearAstrometryParser();
+
+private slots:
+    void recoversTransform_data();
+    void recoversTransform();
+    void tooFewStars();
+};
+
+#endif
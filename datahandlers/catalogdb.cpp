@@ -25,6 +25,7 @@
 #include "skycomponent.h"
 #include "skyobject.h"
 
+#include <QAtomicInt>
 #include <QVariant>
 #include <QHash>
 #include <QSqlTableModel>
@@ -45,6 +46,7 @@ bool CatalogDB::Initialize() {
       first_run = true;
   }
   skydb_.setDatabaseName(dbfile);
+  dbfile_ = dbfile;
   if (!skydb_.open()) {
           qWarning() << i18n("Unable to open DSO database file!");
           qWarning() << LastError();
@@ -53,6 +55,18 @@ bool CatalogDB::Initialize() {
       if (first_run == true) {
           FirstRun();
       }
+      // Databases created by older versions lack the index of the
+      // positions, which the fuzzy matching of the new entries relies on
+      QSqlQuery index_query(skydb_);
+      if (!index_query.exec("CREATE INDEX IF NOT EXISTS DSOPosition "
+                            "ON DSO (Dec, RA)")) {
+          qDebug() << index_query.lastError();
+      }
+      // Catalogs are read by the designations of their ID
+      if (!index_query.exec("CREATE INDEX IF NOT EXISTS DesignationCatalog "
+                            "ON ObjectDesignation (id_Catalog)")) {
+          qDebug() << index_query.lastError();
+      }
   }
   skydb_.close();
   return true;
@@ -241,34 +255,52 @@ void CatalogDB::ClearDSOEntries(int catalog_id) {
     skydb_.close();
 }
 
-int CatalogDB::FindFuzzyEntry(const double ra, const double dec,
-                              const double magnitude) {
+CatalogDB::EntryQueries::EntryQueries(const QSqlDatabase &db)
+  : find_dso(db), add_dso(db), add_designation(db) {
   /*
    * FIXME (spacetime): Match the incoming entry with the ones from the db
    * with certain fuzz. If found, store it in rowuid
    * This Fuzz has not been established after due discussion
   */
-  //skydb_.open();
-  QSqlTableModel dsoentries(0, skydb_);
+  // The bounds are on the columns themselves, so that the DSOPosition
+  // index narrows the search down to a strip of declination
+  find_dso.prepare("SELECT UID FROM DSO WHERE "
+                   "Dec BETWEEN :dec_min AND :dec_max AND "
+                   "RA BETWEEN :ra_min AND :ra_max AND "
+                   "Magnitude BETWEEN :mag_min AND :mag_max LIMIT 1");
+  add_dso.prepare("INSERT INTO DSO (RA, Dec, Type, Magnitude, PositionAngle,"
+                  " MajorAxis, MinorAxis, Flux) VALUES (:RA, :Dec, :Type,"
+                  " :Magnitude, :PositionAngle, :MajorAxis, :MinorAxis,"
+                  " :Flux)");
+  add_designation.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO,"
+                          " LongName, IDNumber) VALUES (:catid, :rowuid,"
+                          " :longname, :id)");
+}
 
-  QString filter =
-    "((RA - " + QString().setNum(ra) + ") between -0.0016 and 0.0016) and "
-    "((Dec - " + QString().setNum(dec) + ") between -0.0016 and 0.0016) and"
-    "((Magnitude - " + QString().setNum(magnitude) + ") between -0.1 and 0.1)";
-//   qDebug() << filter;
-  dsoentries.setTable("DSO");
-  dsoentries.setFilter(filter);
-  dsoentries.select();
+int CatalogDB::FindFuzzyEntry(const double ra, const double dec,
+                              const double magnitude) {
+  //skydb_.open();
+  EntryQueries queries(skydb_);
+  return FindFuzzyEntry(queries.find_dso, ra, dec, magnitude);
+}
 
-  int entry_count = dsoentries.rowCount();
-  QSqlRecord record = dsoentries.record(0);
+int CatalogDB::FindFuzzyEntry(QSqlQuery &find_query, const double ra,
+                              const double dec, const double magnitude) {
+  find_query.bindValue(":ra_min", ra - 0.0016);
+  find_query.bindValue(":ra_max", ra + 0.0016);
+  find_query.bindValue(":dec_min", dec - 0.0016);
+  find_query.bindValue(":dec_max", dec + 0.0016);
+  find_query.bindValue(":mag_min", magnitude - 0.1);
+  find_query.bindValue(":mag_max", magnitude + 0.1);
 
   int returnval = -1;
-  if (entry_count > 0)
-    returnval = record.value("UID").toInt();
-
-  dsoentries.clear();
-  //skydb_.close();
+  if (!find_query.exec()) {
+    qWarning() << find_query.lastQuery();
+    qWarning() << find_query.lastError();
+  } else if (find_query.next()) {
+    returnval = find_query.value(0).toInt();
+  }
+  find_query.finish();
 //   qDebug() << returnval;
   return returnval;
 }
@@ -279,12 +311,34 @@ bool CatalogDB::AddEntry(const CatalogEntryData& catalog_entry, int catid) {
         qWarning() << LastError();
         return false;
     }
-    bool retVal = _AddEntry( catalog_entry, catid );
+    EntryQueries queries( skydb_ );
+    bool retVal = _AddEntry( catalog_entry, catid, queries );
     skydb_.close();
     return retVal;
 }
 
-bool CatalogDB::_AddEntry(const CatalogEntryData& catalog_entry, int catid)
+int CatalogDB::AddEntries(const QList<CatalogEntryData>& catalog_entries, int catid) {
+    if( ! skydb_.open() ) {
+        qWarning() << "Failed to open database to add catalog entries!";
+        qWarning() << LastError();
+        return 0;
+    }
+    skydb_.transaction();
+
+    EntryQueries queries( skydb_ );
+    int added = 0;
+    foreach( const CatalogEntryData &catalog_entry, catalog_entries ) {
+        if( _AddEntry( catalog_entry, catid, queries ) )
+            ++added;
+    }
+
+    skydb_.commit();
+    skydb_.close();
+    return added;
+}
+
+bool CatalogDB::_AddEntry(const CatalogEntryData& catalog_entry, int catid,
+                          EntryQueries &queries)
 {
   // Verification step
   // If RA, Dec are Null, it denotes an invalid object and should not be written
@@ -306,15 +360,12 @@ bool CatalogDB::_AddEntry(const CatalogEntryData& catalog_entry, int catid)
   // out the lastInsertId
 
   // Part 2: Fuzzy Match or Create New Entry
-  int rowuid = FindFuzzyEntry(catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
+  int rowuid = FindFuzzyEntry(queries.find_dso, catalog_entry.ra,
+                              catalog_entry.dec, catalog_entry.magnitude);
   //skydb_.open();
 
   if ( rowuid == -1) { //i.e. No fuzzy match found. Proceed to add new entry
-    QSqlQuery add_query(skydb_);
-    add_query.prepare("INSERT INTO DSO (RA, Dec, Type, Magnitude, PositionAngle,"
-                      " MajorAxis, MinorAxis, Flux) VALUES (:RA, :Dec, :Type,"
-                      " :Magnitude, :PositionAngle, :MajorAxis, :MinorAxis,"
-                      " :Flux)");
+    QSqlQuery &add_query = queries.add_dso;
     add_query.bindValue(":RA", catalog_entry.ra);
     add_query.bindValue(":Dec", catalog_entry.dec);
     add_query.bindValue(":Type", catalog_entry.type);
@@ -331,7 +382,7 @@ bool CatalogDB::_AddEntry(const CatalogEntryData& catalog_entry, int catid)
 
     // Find UID of the Row just added
     rowuid = add_query.lastInsertId().toInt();
-    add_query.clear();
+    add_query.finish();
   }
   int ID = catalog_entry.ID;
 
@@ -349,10 +400,9 @@ bool CatalogDB::_AddEntry(const CatalogEntryData& catalog_entry, int catid)
 
   // Part 3: Add in Object Designation
   //skydb_.open();
-  QSqlQuery add_od(skydb_);
+  QSqlQuery auto_id_od(skydb_);
+  QSqlQuery &add_od = ( ID >= 0 ) ? queries.add_designation : auto_id_od;
   if( ID >= 0 ) {
-      add_od.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
-                     ", IDNumber) VALUES (:catid, :rowuid, :longname, :id)");
       add_od.bindValue(":id", ID);
   }
   else{
@@ -372,7 +422,7 @@ bool CatalogDB::_AddEntry(const CatalogEntryData& catalog_entry, int catid)
       qWarning() << skydb_.lastError();
       retVal = false;
   }
-  add_od.clear();
+  add_od.finish();
   //skydb_.close();
 
   return retVal;
@@ -464,6 +514,7 @@ bool CatalogDB::AddCatalogContents(const QString& fname) {
 
       skydb_.open();
       skydb_.transaction();
+      EntryQueries queries(skydb_);
 
       QHash<QString, QVariant> row_content;
       while (catalog_text_parser.HasNextRow())
@@ -487,7 +538,7 @@ bool CatalogDB::AddCatalogContents(const QString& fname) {
         catalog_entry.minor_axis = row_content["Mn"].toFloat();
         catalog_entry.flux = row_content["Flux"].toFloat();
 
-        _AddEntry(catalog_entry, catid);
+        _AddEntry(catalog_entry, catid, queries);
       }
 
       skydb_.commit();
@@ -783,6 +834,60 @@ void CatalogDB::GetAllObjects(const QString &catalog,
         qWarning() << get_query.lastError();
     }
 
+    ReadObjects(get_query, sky_list, object_names, catalog_ptr,
+                includeCatalogDesignation);
+
+    get_query.clear();
+    skydb_.close();
+}
+
+void CatalogDB::GetObjectsInDecRange(int catalog_id, double dec_min,
+                                     double dec_max,
+                                     QList< SkyObject* > &sky_list,
+                                     QList < QPair <int, QString> > &object_names,
+                                     CatalogComponent *catalog_ptr,
+                                     bool includeCatalogDesignation) {
+    // Connections may only be used by the thread which created them
+    static QAtomicInt connections;
+    QString connection_name = QString("skydb_reader_%1").arg(connections.fetchAndAddRelaxed(1));
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connection_name);
+        db.setDatabaseName(dbfile_);
+        if (!db.open()) {
+            qWarning() << i18n("Unable to open DSO database file!");
+            qWarning() << db.lastError();
+        } else {
+            QSqlQuery get_query(db);
+            get_query.prepare("SELECT Epoch, Type, RA, Dec, Magnitude, Prefix, "
+                              "IDNumber, LongName, MajorAxis, MinorAxis, "
+                              "PositionAngle, Flux FROM ObjectDesignation JOIN DSO "
+                              "JOIN Catalog WHERE Catalog.id = :catID AND "
+                              "ObjectDesignation.id_Catalog = Catalog.id AND "
+                              "ObjectDesignation.UID_DSO = DSO.UID AND "
+                              "DSO.Dec >= :dec_min AND DSO.Dec < :dec_max");
+            get_query.bindValue(":catID", catalog_id);
+            get_query.bindValue(":dec_min", dec_min);
+            get_query.bindValue(":dec_max", dec_max);
+
+            if (!get_query.exec()) {
+                qWarning() << get_query.lastQuery();
+                qWarning() << get_query.lastError();
+            }
+
+            ReadObjects(get_query, sky_list, object_names, catalog_ptr,
+                        includeCatalogDesignation);
+            get_query.clear();
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connection_name);
+}
+
+void CatalogDB::ReadObjects(QSqlQuery &get_query,
+                            QList< SkyObject* > &sky_list,
+                            QList < QPair <int, QString> > &object_names,
+                            CatalogComponent *catalog_ptr,
+                            bool includeCatalogDesignation) {
     while (get_query.next()) {
 
         int cat_epoch = get_query.value(0).toInt();
@@ -855,9 +960,6 @@ void CatalogDB::GetAllObjects(const QString &catalog,
             object_names.append(qMakePair<int,QString>(iType, lname));
         }
     }
-
-    get_query.clear();
-    skydb_.close();
 }
 
 
@@ -144,6 +144,29 @@ class CatalogDB {
                      CatalogComponent *catalog_pointer,
                      bool includeCatalogDesignation = true );
 
+  /**
+   * @brief Creates the objects of a catalog whose declination lies in
+   * [dec_min, dec_max), like GetAllObjects() does for the whole catalog.
+   * This lets a catalog be read by bands of declination.
+   *
+   * @note This method may be called from any thread, as it reads the
+   * database through a connection of its own.
+   *
+   * @param catalog_id ID of the catalog, as returned by FindCatalog()
+   * @param dec_min lower bound of the declination, in degrees
+   * @param dec_max upper bound of the declination, in degrees
+   * @param sky_list List of the skyobjects created (appends)
+   * @param names List of the names of the objects created (appends)
+   * @param catalog_pointer pointer to the catalogcomponent objects
+   * @param includeCatalogDesignation see GetAllObjects()
+   * @return void
+   **/
+  void GetObjectsInDecRange(int catalog_id, double dec_min, double dec_max,
+                            QList< SkyObject* > &sky_list,
+                            QList < QPair <int, QString> > &object_names,
+                            CatalogComponent *catalog_pointer,
+                            bool includeCatalogDesignation = true );
+
   /**
    * @brief Get information about the catalog like Prefix etc
    *
@@ -165,6 +188,18 @@ class CatalogDB {
    **/
   bool AddEntry(const CatalogEntryData &catalog_entry, int catid);
 
+  /**
+   * @brief Used to add many cross referenced entries into the database
+   * at once, in a single transaction
+   *
+   * @note This public method opens and closes the database.
+   *
+   * @param catalog_entries Data structures with entry details
+   * @param catid Category ID in the database
+   * @return the number of entries which were added
+   **/
+  int AddEntries(const QList<CatalogEntryData> &catalog_entries, int catid);
+
   /**
    * @brief Returns database ID of the required catalog.
    * Returns -1 if not found.
@@ -183,6 +218,18 @@ class CatalogDB {
   void AddCatalog(const CatalogData& catalog_data);
 
  private:
+  /**
+   * @brief The statements used by _AddEntry(), prepared once on the opened
+   * DB and reused for all the entries added until it is closed
+   **/
+  struct EntryQueries {
+    explicit EntryQueries(const QSqlDatabase &db);
+
+    QSqlQuery find_dso;
+    QSqlQuery add_dso;
+    QSqlQuery add_designation;
+  };
+
   /**
    * @brief Used to add a cross referenced entry into the database
    *
@@ -191,9 +238,29 @@ class CatalogDB {
    *
    * @param catalog_entry Data structure with entry details
    * @param catid Category ID in the database
+   * @param queries Statements prepared on the opened DB
    * @return false if adding was unsuccessful
    **/
-  bool _AddEntry(const CatalogEntryData &catalog_entry, int catid);
+  bool _AddEntry(const CatalogEntryData &catalog_entry, int catid,
+                 EntryQueries &queries);
+
+  /**
+   * @brief FindFuzzyEntry() with a prepared statement
+   *
+   * @param find_query Statement prepared by EntryQueries
+   **/
+  int FindFuzzyEntry(QSqlQuery &find_query, const double ra, const double dec,
+                     const double magnitude);
+
+  /**
+   * @brief Creates the objects of the rows selected by an executed
+   * query of GetAllObjects() or GetObjectsInDecRange()
+   **/
+  static void ReadObjects(QSqlQuery &get_query,
+                          QList< SkyObject* > &sky_list,
+                          QList < QPair <int, QString> > &object_names,
+                          CatalogComponent *catalog_pointer,
+                          bool includeCatalogDesignation);
 
   /**
    * @brief Database object for the sky object. Assigned and Initialized by
@@ -201,6 +268,12 @@ class CatalogDB {
    **/
   QSqlDatabase skydb_;
 
+  /**
+   * @brief Path of the database file, for the connections of the other
+   *        threads. Assigned by Initialize()
+   **/
+  QString dbfile_;
+
   /**
    * @brief Returns the last error the database encountered
    *
@@ -0,0 +1,132 @@
+/***************************************************************************
+                    chebyshevcache.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat Mar 11 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "chebyshevcache.h"
+
+#include <cmath>
+
+#include <QMutexLocker>
+#include <QThread>
+
+ChebyshevCache::ChebyshevCache( double span, int order, int dimension, int maxSegments ) :
+    m_Span( span ), m_Order( order ), m_Dimension( dimension ), m_MaxSegments( maxSegments )
+{
+}
+
+void ChebyshevCache::evaluate( double t, double *values, const Function &f )
+{
+    qint64 key = qint64( std::floor( t / m_Span ) );
+    Qt::HANDLE thread = QThread::currentThreadId();
+    QVector<double> coeffs;
+    int farMisses = 0;
+
+    {
+        QMutexLocker locker( &m_Mutex );
+        coeffs = m_Segments.value( key );
+        if ( coeffs.isEmpty() ) {
+            // Queries jumping from segment to segment, e.g. with a fast clock, would each pay for a fit
+            QHash<Qt::HANDLE, Miss>::const_iterator last = m_Misses.constFind( thread );
+            if ( last != m_Misses.constEnd() && qAbs( key - last->key ) > 1 )
+                farMisses = last->farMisses + 1;
+        } else {
+            m_Misses.remove( thread );
+        }
+    }
+
+    if ( farMisses >= 2 ) {
+        f( t, values );
+
+        QMutexLocker locker( &m_Mutex );
+        Miss miss = { key, farMisses };
+        m_Misses.insert( thread, miss );
+        return;
+    }
+
+    if ( coeffs.isEmpty() ) {
+        // Fit outside of the lock, other threads may keep using the cache meanwhile
+        coeffs = fit( key, f );
+
+        QMutexLocker locker( &m_Mutex );
+        if ( m_Segments.size() >= m_MaxSegments ) {
+            // Evict the segment farthest in time: queries usually move steadily in time
+            QHash<qint64, QVector<double> >::iterator farthest = m_Segments.begin();
+            for ( QHash<qint64, QVector<double> >::iterator it = m_Segments.begin(); it != m_Segments.end(); ++it ) {
+                if ( qAbs( it.key() - key ) > qAbs( farthest.key() - key ) )
+                    farthest = it;
+            }
+            m_Segments.erase( farthest );
+        }
+        m_Segments.insert( key, coeffs );
+        Miss miss = { key, farMisses };
+        m_Misses.insert( thread, miss );
+    }
+
+    // Clenshaw's recurrence on x in [-1, 1]
+    double x = 2.0 * ( t / m_Span - key ) - 1.0;
+    double x2 = 2.0 * x;
+    const double *c = coeffs.constData();
+    for ( int d = 0; d < m_Dimension; ++d, c += m_Order + 1 ) {
+        double b1 = 0.0, b2 = 0.0;
+        for ( int j = m_Order; j >= 1; --j ) {
+            double b0 = x2 * b1 - b2 + c[j];
+            b2 = b1;
+            b1 = b0;
+        }
+        values[d] = x * b1 - b2 + 0.5 * c[0];
+    }
+}
+
+QVector<double> ChebyshevCache::fit( qint64 key, const Function &f ) const
+{
+    const int n = m_Order + 1;
+    QVector<double> samples( n * m_Dimension );
+    QVector<double> coeffs( n * m_Dimension, 0.0 );
+    QVector<double> value( m_Dimension );
+
+    // Sample at the Chebyshev nodes of the segment
+    for ( int k = 0; k < n; ++k ) {
+        double x = std::cos( M_PI * ( k + 0.5 ) / n );
+        f( m_Span * ( key + 0.5 * ( x + 1.0 ) ), value.data() );
+        for ( int d = 0; d < m_Dimension; ++d )
+            samples[d * n + k] = value[d];
+    }
+
+    for ( int j = 0; j < n; ++j ) {
+        for ( int k = 0; k < n; ++k ) {
+            double w = std::cos( M_PI * j * ( k + 0.5 ) / n );
+            for ( int d = 0; d < m_Dimension; ++d )
+                coeffs[d * n + j] += w * samples[d * n + k];
+        }
+    }
+    for ( int i = 0; i < coeffs.size(); ++i )
+        coeffs[i] *= 2.0 / n;
+
+    return coeffs;
+}
+
+void ChebyshevCache::clear()
+{
+    QMutexLocker locker( &m_Mutex );
+    m_Segments.clear();
+    m_Misses.clear();
+}
+
+int ChebyshevCache::segmentCount() const
+{
+    QMutexLocker locker( &m_Mutex );
+    return m_Segments.size();
+}
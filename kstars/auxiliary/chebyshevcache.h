@@ -0,0 +1,119 @@
+/***************************************************************************
+                     chebyshevcache.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat Mar 11 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CHEBYSHEVCACHE_H
+#define CHEBYSHEVCACHE_H
+
+#include <functional>
+
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+/**
+ * @class ChebyshevCache
+ * @short Caches a smooth vector function of time as piecewise Chebyshev polynomials.
+ *
+ * Time is divided into segments of fixed length. The first time a segment is queried,
+ * the expensive function is evaluated at the Chebyshev nodes of the segment and the
+ * coefficients of the interpolating polynomial are stored. Further queries in that segment
+ * are answered from the coefficients with Clenshaw's recurrence.
+ *
+ * This is used to avoid summing the full VSOP87 series of the planets and the lunar
+ * series for every position. The components of the function must be continuous, e.g.
+ * longitudes must not be reduced to [0, 360).
+ *
+ * Queries scattered over time, as with a fast clock, would pay for a fit each. So when a query
+ * misses the cache far from the previous miss, which itself was far from the one before, the
+ * function is evaluated directly instead. A query missing again near the previous miss fits its
+ * segment, and a hit starts over. The misses are followed for each thread on its own, so that
+ * callers on other threads do not change the choice.
+ *
+ * The cache can be shared between threads.
+ *
+ * @author The KStars Team
+ */
+class ChebyshevCache {
+
+public:
+
+    /**
+     * @short The function being approximated
+     * It computes all the components of the function at the given time.
+     */
+    typedef std::function<void ( double t, double *values )> Function;
+
+    /**
+     * @short Constructor
+     * @param span the length of a segment, in the unit of time of the function
+     * @param order the degree of the polynomials
+     * @param dimension the number of components of the function
+     * @param maxSegments the maximum number of segments kept in memory
+     */
+    ChebyshevCache( double span, int order, int dimension = 3, int maxSegments = 64 );
+
+    /**
+     * @short Evaluate the function from the cache
+     * The segment containing @p t is fitted from @p f first, if it is not cached yet,
+     * unless the queries are scattered, see above.
+     * @param t the time
+     * @param values array of dimension() values filled with the result
+     * @param f the function being approximated
+     */
+    void evaluate( double t, double *values, const Function &f );
+
+    /**
+     * @short Remove all cached segments
+     */
+    void clear();
+
+    /** @return the length of a segment */
+    inline double span() const { return m_Span; }
+
+    /** @return the number of components of the function */
+    inline int dimension() const { return m_Dimension; }
+
+    /** @return the number of segments currently cached */
+    int segmentCount() const;
+
+private:
+
+    /**
+     * @short Compute the coefficients of a segment
+     * @param key the index of the segment
+     * @param f the function being approximated
+     * @return the coefficients, the order()+1 coefficients of each component one after the other
+     */
+    QVector<double> fit( qint64 key, const Function &f ) const;
+
+    double m_Span;
+    int m_Order;
+    int m_Dimension;
+    int m_MaxSegments;
+
+    // The last query of a thread which was not in a cached segment
+    struct Miss {
+        qint64 key;         // its segment
+        int farMisses;      // number of misses in a row, up to it, each far from the one before
+    };
+
+    QHash<qint64, QVector<double> > m_Segments;
+    QHash<Qt::HANDLE, Miss> m_Misses;
+    mutable QMutex m_Mutex;
+};
+
+#endif
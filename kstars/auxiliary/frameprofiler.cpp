@@ -0,0 +1,151 @@
+/***************************************************************************
+                    frameprofiler.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun Mar 26 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "frameprofiler.h"
+
+#include <QMutexLocker>
+#include <QStringList>
+
+// Name of the duration of the whole frame, from beginFrame() to endFrame()
+static const char * const frameSection = "frame";
+
+FrameProfiler::Timer::Timer( const char *section ) :
+    m_Section( FrameProfiler::Instance()->isEnabled() ? section : 0 )
+{
+    if ( m_Section )
+        m_Timer.start();
+}
+
+FrameProfiler::Timer::~Timer()
+{
+    if ( m_Section )
+        FrameProfiler::Instance()->addTime( m_Section, m_Timer.nsecsElapsed() );
+}
+
+FrameProfiler *FrameProfiler::Instance()
+{
+    static FrameProfiler profiler;
+    return &profiler;
+}
+
+FrameProfiler::FrameProfiler() :
+    m_Enabled( 0 ), m_Frames( 0 )
+{
+}
+
+void FrameProfiler::setEnabled( bool enabled )
+{
+    QMutexLocker locker( &m_Mutex );
+    m_Entries.clear();
+    m_Frames = 0;
+    m_FrameTimer.invalidate();
+    m_Enabled.store( enabled ? 1 : 0 );
+}
+
+void FrameProfiler::beginFrame()
+{
+    if ( !isEnabled() )
+        return;
+    QMutexLocker locker( &m_Mutex );
+    m_FrameTimer.start();
+}
+
+void FrameProfiler::endFrame()
+{
+    if ( !isEnabled() )
+        return;
+    QMutexLocker locker( &m_Mutex );
+    if ( !m_FrameTimer.isValid() )
+        return;
+    qint64 elapsed = m_FrameTimer.nsecsElapsed();
+    m_FrameTimer.invalidate();
+
+    Entry &frame = m_Entries[ QByteArray( frameSection ) ];
+    frame.isTime = true;
+    frame.current = elapsed;
+
+    // Sections which did not run in this frame count as zero
+    for ( QMap<QByteArray, Entry>::iterator it = m_Entries.begin(); it != m_Entries.end(); ++it ) {
+        Entry &entry = it.value();
+        entry.last = entry.current;
+        entry.total += entry.current;
+        entry.max = qMax( entry.max, entry.current );
+        entry.current = 0;
+    }
+    ++m_Frames;
+}
+
+void FrameProfiler::addTime( const char *section, qint64 nsecs )
+{
+    add( section, nsecs, true );
+}
+
+void FrameProfiler::addCount( const char *counter, qint64 count )
+{
+    add( counter, count, false );
+}
+
+void FrameProfiler::add( const char *name, qint64 value, bool isTime )
+{
+    if ( !isEnabled() )
+        return;
+    QMutexLocker locker( &m_Mutex );
+    // Look up without copying the name, it is only copied when first inserted
+    QMap<QByteArray, Entry>::iterator it = m_Entries.find( QByteArray::fromRawData( name, qstrlen( name ) ) );
+    if ( it == m_Entries.end() ) {
+        Entry entry = { isTime, 0, 0, 0, 0 };
+        it = m_Entries.insert( QByteArray( name ), entry );
+    }
+    it.value().current += value;
+}
+
+int FrameProfiler::frameCount() const
+{
+    QMutexLocker locker( &m_Mutex );
+    return m_Frames;
+}
+
+QString FrameProfiler::report() const
+{
+    QMutexLocker locker( &m_Mutex );
+    if ( !isEnabled() )
+        return QString( "profiling disabled" );
+    if ( m_Frames == 0 )
+        return QString( "no frame recorded" );
+
+    QStringList lines;
+    lines << QString( "%1 frames, in ms: last avg max" ).arg( m_Frames );
+    // Durations first, then counters
+    for ( int pass = 0; pass < 2; ++pass ) {
+        for ( QMap<QByteArray, Entry>::const_iterator it = m_Entries.constBegin(); it != m_Entries.constEnd(); ++it ) {
+            const Entry &entry = it.value();
+            if ( entry.isTime != ( pass == 0 ) )
+                continue;
+            if ( entry.isTime )
+                lines << QString( "%1: %2 %3 %4" ).arg( QString::fromLatin1( it.key() ) )
+                                                  .arg( entry.last * 1.e-6, 0, 'f', 2 )
+                                                  .arg( entry.total * 1.e-6 / m_Frames, 0, 'f', 2 )
+                                                  .arg( entry.max * 1.e-6, 0, 'f', 2 );
+            else
+                lines << QString( "%1: %2 %3 %4" ).arg( QString::fromLatin1( it.key() ) )
+                                                  .arg( entry.last )
+                                                  .arg( double( entry.total ) / m_Frames, 0, 'f', 0 )
+                                                  .arg( entry.max );
+        }
+    }
+    return lines.join( '\n' );
+}
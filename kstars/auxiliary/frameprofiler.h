@@ -0,0 +1,124 @@
+/***************************************************************************
+                     frameprofiler.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun Mar 26 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+
+/**
+ * @class FrameProfiler
+ * @short Collects the time spent in the sections of a sky map frame.
+ *
+ * The drawing and updating code reports durations and counters by name, e.g.
+ * with a FrameProfiler::Timer on the stack. The values are summed until
+ * endFrame() is called, and the report gives for each of them the value of
+ * the last frame, the average and the maximum over all the frames since the
+ * profiler was enabled.
+ *
+ * The profiler does nothing until it is enabled, so the instrumented code
+ * only costs a test of a flag. Values may be reported from any thread.
+ *
+ * @author The KStars Team
+ */
+class FrameProfiler {
+
+public:
+
+    /**
+     * @class Timer
+     * @short Adds the time elapsed during its lifetime to a section of the frame
+     */
+    class Timer {
+    public:
+        /**
+         * @param section the name of the section. It must remain valid until the
+         * timer is destroyed, a string literal is expected.
+         */
+        explicit Timer( const char *section );
+        ~Timer();
+
+    private:
+        const char *m_Section;
+        QElapsedTimer m_Timer;
+    };
+
+    /** @return the instance of the profiler */
+    static FrameProfiler *Instance();
+
+    /** @return true if the values reported are recorded */
+    inline bool isEnabled() const { return m_Enabled.load(); }
+
+    /**
+     * @short Enable or disable the profiler
+     * All the values recorded so far are discarded.
+     */
+    void setEnabled( bool enabled );
+
+    /** @short Start timing the drawing of a frame */
+    void beginFrame();
+
+    /** @short Record the values of the frame and start a new one */
+    void endFrame();
+
+    /**
+     * @short Add a duration to a section of the current frame
+     * @param section the name of the section
+     * @param nsecs the duration, in nanoseconds
+     */
+    void addTime( const char *section, qint64 nsecs );
+
+    /**
+     * @short Add to a counter of the current frame
+     * @param counter the name of the counter
+     * @param count the amount to add
+     */
+    void addCount( const char *counter, qint64 count );
+
+    /** @return the number of frames recorded */
+    int frameCount() const;
+
+    /** @return a multi-line report of the frames recorded, one section or counter per line */
+    QString report() const;
+
+private:
+
+    FrameProfiler();
+
+    struct Entry {
+        bool isTime;
+        qint64 current;  // value in the current frame
+        qint64 last;     // value in the last frame recorded
+        qint64 total;
+        qint64 max;
+    };
+
+    void add( const char *name, qint64 value, bool isTime );
+
+    QAtomicInt m_Enabled;
+    QMap<QByteArray, Entry> m_Entries;
+    QElapsedTimer m_FrameTimer;
+    int m_Frames;
+    mutable QMutex m_Mutex;
+};
+
+#endif
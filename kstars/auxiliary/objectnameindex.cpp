@@ -0,0 +1,124 @@
+/***************************************************************************
+                   objectnameindex.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun Apr 16 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "objectnameindex.h"
+
+#include <algorithm>
+#include <iterator>
+
+static inline quint64 trigram( const QChar *c )
+{
+    return ( quint64( c[0].unicode() ) << 32 ) | ( quint64( c[1].unicode() ) << 16 ) | c[2].unicode();
+}
+
+void ObjectNameIndex::build( const QHash<int, QVector<Entry> > &lists )
+{
+    m_Entries.clear();
+    m_Types.clear();
+    m_Keys.clear();
+    m_Trigrams.clear();
+
+    for ( QHash<int, QVector<Entry> >::const_iterator it = lists.constBegin(); it != lists.constEnd(); ++it ) {
+        foreach ( const Entry &entry, it.value() ) {
+            m_Entries.append( entry );
+            m_Types.append( it.key() );
+            m_Keys.append( normalize( entry.first ) );
+        }
+    }
+
+    m_Sorted.resize( m_Entries.size() );
+    for ( int i = 0; i < m_Sorted.size(); ++i )
+        m_Sorted[i] = i;
+    std::sort( m_Sorted.begin(), m_Sorted.end(), [this]( int a, int b ) { return m_Keys[a] < m_Keys[b]; } );
+
+    for ( int i = 0; i < m_Keys.size(); ++i ) {
+        const QString &key = m_Keys[i];
+        for ( int j = 0; j + 3 <= key.size(); ++j ) {
+            QVector<int> &entries = m_Trigrams[ trigram( key.constData() + j ) ];
+            // A trigram may appear several times in a key
+            if ( entries.isEmpty() || entries.last() != i )
+                entries.append( i );
+        }
+    }
+}
+
+QVector<ObjectNameIndex::Entry> ObjectNameIndex::find( const QString &text, const QList<int> &types ) const
+{
+    QVector<Entry> result;
+    QString key = normalize( text );
+
+    if ( key.size() < 3 ) {
+        // Too short for the trigrams, but any key may match
+        for ( int i = 0; i < m_Keys.size(); ++i ) {
+            if ( ( types.isEmpty() || types.contains( m_Types[i] ) ) && m_Keys[i].contains( key ) )
+                result.append( m_Entries[i] );
+        }
+        return result;
+    }
+
+    // Candidates have all the trigrams of the key, starting from the rarest
+    QVector<const QVector<int> *> lists;
+    for ( int j = 0; j + 3 <= key.size(); ++j ) {
+        QHash<quint64, QVector<int> >::const_iterator it = m_Trigrams.constFind( trigram( key.constData() + j ) );
+        if ( it == m_Trigrams.constEnd() )
+            return result;
+        lists.append( &it.value() );
+    }
+    std::sort( lists.begin(), lists.end(), []( const QVector<int> *a, const QVector<int> *b ) { return a->size() < b->size(); } );
+
+    QVector<int> candidates = *lists.first();
+    for ( int k = 1; k < lists.size() && ! candidates.isEmpty(); ++k ) {
+        QVector<int> common;
+        std::set_intersection( candidates.constBegin(), candidates.constEnd(),
+                               lists[k]->constBegin(), lists[k]->constEnd(), std::back_inserter( common ) );
+        candidates = common;
+    }
+
+    // The trigrams may be found in another order
+    foreach ( int i, candidates ) {
+        if ( ( types.isEmpty() || types.contains( m_Types[i] ) ) && m_Keys[i].contains( key ) )
+            result.append( m_Entries[i] );
+    }
+    return result;
+}
+
+QVector<ObjectNameIndex::Entry> ObjectNameIndex::findPrefix( const QString &text, const QList<int> &types ) const
+{
+    QVector<Entry> result;
+    QString key = normalize( text );
+
+    QVector<int>::const_iterator it = std::lower_bound( m_Sorted.constBegin(), m_Sorted.constEnd(), key,
+                                                        [this]( int a, const QString &k ) { return m_Keys[a] < k; } );
+    for ( ; it != m_Sorted.constEnd() && m_Keys[*it].startsWith( key ); ++it ) {
+        if ( types.isEmpty() || types.contains( m_Types[*it] ) )
+            result.append( m_Entries[*it] );
+    }
+    return result;
+}
+
+QString ObjectNameIndex::normalize( const QString &name )
+{
+    // Accented letters are decomposed, and their combining marks dropped below
+    QString decomposed = name.normalized( QString::NormalizationForm_KD );
+    QString key;
+    key.reserve( decomposed.size() );
+    for ( const QChar *c = decomposed.constData(), *end = c + decomposed.size(); c != end; ++c ) {
+        if ( c->isLetterOrNumber() )
+            key.append( c->toCaseFolded() );
+    }
+    return key;
+}
@@ -0,0 +1,83 @@
+/***************************************************************************
+                    objectnameindex.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun Apr 16 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef OBJECTNAMEINDEX_H
+#define OBJECTNAMEINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+class SkyObject;
+
+/**
+ * @class ObjectNameIndex
+ * @short Index of the names of the sky objects, for incremental searches.
+ *
+ * The names are compared once normalized: case folded, without diacritics,
+ * spaces nor punctuation, so that "NGC 224", "ngc224" and "NGC-224" are the
+ * same. Names starting with a text are found by a binary search in the sorted
+ * names, and names containing a text from the lists of the entries containing
+ * each of its trigrams.
+ *
+ * An index is built once from a copy of SkyMapComposite::objectLists(), which
+ * may be done in any thread, and is not modified afterwards.
+ *
+ * @author The KStars Team
+ */
+class ObjectNameIndex
+{
+public:
+    typedef QPair<QString, const SkyObject *> Entry;
+
+    /** @short Build the index of the names of @p lists, whose keys are the types of the objects */
+    void build( const QHash<int, QVector<Entry> > &lists );
+
+    /** @return true if there is nothing indexed */
+    inline bool isEmpty() const { return m_Entries.isEmpty(); }
+
+    /** @return the number of names indexed */
+    inline int size() const { return m_Entries.size(); }
+
+    /**
+     * @return the entries whose normalized name contains the normalized @p text,
+     * in the order they were indexed. All of them if @p text is empty.
+     * @param types the types of the objects to return, all of them if empty
+     */
+    QVector<Entry> find( const QString &text, const QList<int> &types = QList<int>() ) const;
+
+    /**
+     * @return the entries whose normalized name starts with the normalized @p text,
+     * sorted by normalized name
+     * @param types the types of the objects to return, all of them if empty
+     */
+    QVector<Entry> findPrefix( const QString &text, const QList<int> &types = QList<int>() ) const;
+
+    /** @return @p name case folded, without diacritics nor anything but letters and digits */
+    static QString normalize( const QString &name );
+
+private:
+    QVector<Entry> m_Entries;
+    QVector<int> m_Types;       // type of each entry
+    QVector<QString> m_Keys;    // normalized name of each entry
+    QVector<int> m_Sorted;      // entries sorted by key
+    QHash<quint64, QVector<int> > m_Trigrams;   // entries whose key contains the trigram, in increasing order
+};
+
+#endif
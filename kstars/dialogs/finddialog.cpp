@@ -27,6 +27,7 @@
 #include "skycomponents/skymapcomposite.h"
 #include "tools/nameresolver.h"
 #include "skyobjectlistmodel.h"
+#include "auxiliary/objectnameindex.h"
 
 #include <KMessageBox>
 
@@ -175,81 +176,88 @@ void FindDialog::initSelection() {
     listFiltered = true;
 }
 
-void FindDialog::filterByType() {
-    KStarsData *data = KStarsData::Instance();
-
+QList<int> FindDialog::filterTypes() const {
+    QList<int> types;
     switch ( ui->FilterType->currentIndex() ) {
-    case 0: // All object types
-    {
-        QVector<QPair<QString, const SkyObject *>> allObjects;
-        foreach( int type, data->skyComposite()->objectLists().keys() ) {
-            allObjects.append(data->skyComposite()->objectLists(SkyObject::TYPE(type)));
-        }
-        fModel->setSkyObjectsList( allObjects );
-        break;
-    }
     case 1: //Stars
-    {
-        QVector<QPair<QString, const SkyObject *>> starObjects;
-        starObjects.append(data->skyComposite()->objectLists(SkyObject::STAR));
-        starObjects.append(data->skyComposite()->objectLists(SkyObject::CATALOG_STAR));
-        fModel->setSkyObjectsList( starObjects );
+        types << SkyObject::STAR << SkyObject::CATALOG_STAR;
         break;
-    }
     case 2: //Solar system
-    {
-        QVector<QPair<QString, const SkyObject *>> ssObjects;
-        ssObjects.append(data->skyComposite()->objectLists(SkyObject::PLANET));
-        ssObjects.append(data->skyComposite()->objectLists(SkyObject::COMET));
-        ssObjects.append(data->skyComposite()->objectLists(SkyObject::ASTEROID));
-        ssObjects.append(data->skyComposite()->objectLists(SkyObject::MOON));
-
-        fModel->setSkyObjectsList(ssObjects);
+        types << SkyObject::PLANET << SkyObject::COMET << SkyObject::ASTEROID << SkyObject::MOON;
         break;
-    }
     case 3: //Open Clusters
-        fModel->setSkyObjectsList( data->skyComposite()->objectLists( SkyObject::OPEN_CLUSTER ) );
+        types << SkyObject::OPEN_CLUSTER;
         break;
     case 4: //Globular Clusters
-        fModel->setSkyObjectsList( data->skyComposite()->objectLists( SkyObject::GLOBULAR_CLUSTER ) );
+        types << SkyObject::GLOBULAR_CLUSTER;
         break;
     case 5: //Gaseous nebulae
-        fModel->setSkyObjectsList( data->skyComposite()->objectLists( SkyObject::GASEOUS_NEBULA ) );
+        types << SkyObject::GASEOUS_NEBULA;
         break;
     case 6: //Planetary nebula
-        fModel->setSkyObjectsList( data->skyComposite()->objectLists( SkyObject::PLANETARY_NEBULA ) );
+        types << SkyObject::PLANETARY_NEBULA;
         break;
     case 7: //Galaxies
-        fModel->setSkyObjectsList( data->skyComposite()->objectLists( SkyObject::GALAXY ) );
+        types << SkyObject::GALAXY;
         break;
     case 8: //Comets
-        fModel->setSkyObjectsList( data->skyComposite()->objectLists( SkyObject::COMET ) );
+        types << SkyObject::COMET;
         break;
     case 9: //Asteroids
-        fModel->setSkyObjectsList( data->skyComposite()->objectLists( SkyObject::ASTEROID ) );
+        types << SkyObject::ASTEROID;
         break;
     case 10: //Constellations
-        fModel->setSkyObjectsList( data->skyComposite()->objectLists( SkyObject::CONSTELLATION ) );
+        types << SkyObject::CONSTELLATION;
         break;
     case 11: //Supernovae
-        fModel->setSkyObjectsList( data->skyComposite()->objectLists( SkyObject::SUPERNOVA ) );
+        types << SkyObject::SUPERNOVA;
         break;
     case 12: //Satellites
-        fModel->setSkyObjectsList( data->skyComposite()->objectLists( SkyObject::SATELLITE ) );
+        types << SkyObject::SATELLITE;
         break;
     }
+    return types;
+}
+
+void FindDialog::filterByType() {
+    KStarsData *data = KStarsData::Instance();
+    // All the objects must be listed, including those still loading
+    data->skyComposite()->waitForLoading();
+
+    QList<int> types = filterTypes();
+    if ( types.isEmpty() ) // All object types
+        types = data->skyComposite()->objectLists().keys();
+
+    QVector<QPair<QString, const SkyObject *>> objects;
+    foreach( int type, types ) {
+        objects.append(data->skyComposite()->objectLists(SkyObject::TYPE(type)));
+    }
+    fModel->setSkyObjectsList( objects );
 }
 
 void FindDialog::filterList() {
     QString SearchText = processSearchText();
-    sortModel->setFilterFixedString( SearchText );
+    // Until the index of the names is built, the list is filtered by the proxy model
+    const ObjectNameIndex &nameIndex = KStarsData::Instance()->skyComposite()->nameIndex();
     ui->InternetSearchButton->setText( i18n( "or search the internet for %1", SearchText ) );
-    filterByType();
+    if ( nameIndex.isEmpty() ) {
+        sortModel->setFilterFixedString( SearchText );
+        filterByType();
+    } else {
+        sortModel->setFilterFixedString( QString() );
+        fModel->setSkyObjectsList( nameIndex.find( SearchText, filterTypes() ) );
+    }
     initSelection();
 
     //Select the first item in the list that begins with the filter string
     if ( !SearchText.isEmpty() ) {
-        QStringList mItems = fModel->filter( QRegExp( '^'+SearchText, Qt::CaseInsensitive ) );
+        QStringList mItems;
+        if ( nameIndex.isEmpty() ) {
+            mItems = fModel->filter( QRegExp( '^'+SearchText, Qt::CaseInsensitive ) );
+        } else {
+            foreach ( const ObjectNameIndex::Entry &entry, nameIndex.findPrefix( SearchText, filterTypes() ) )
+                mItems.append( entry.first );
+        }
         mItems.sort();
 
         if ( mItems.size() ) {
@@ -287,7 +295,8 @@ void FindDialog::enqueueSearch() {
         timer->setSingleShot( true );
         connect( timer, SIGNAL( timeout() ), this, SLOT( filterList() ) );
     }
-    timer->start( 500 );
+    // Searching the index is fast enough to follow the typing more closely
+    timer->start( KStarsData::Instance()->skyComposite()->nameIndex().isEmpty() ? 500 : 100 );
 }
 
 // Process the search box text to replace equivalent names like "m93" with "m 93"
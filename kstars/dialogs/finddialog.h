@@ -121,6 +121,9 @@ private:
      */
     void filterByType();
 
+    /** @return the types of objects selected, all of them if empty */
+    QList<int> filterTypes() const;
+
     FindDialogUI* ui;
     SkyObjectListModel *fModel;
     QSortFilterProxyModel* sortModel;
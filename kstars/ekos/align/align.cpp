@@ -37,6 +37,7 @@
 #include "onlineastrometryparser.h"
 #include "offlineastrometryparser.h"
 #include "remoteastrometryparser.h"
+#include "nearastrometryparser.h"
 
 #include <basedevice.h>
 
@@ -91,6 +92,7 @@ Align::Align()
     onlineParser = NULL;
     offlineParser = NULL;
     remoteParser = NULL;
+    nearParser = NULL;
 
     connect(solveB, SIGNAL(clicked()), this, SLOT(captureAndSolve()));
     connect(stopB, SIGNAL(clicked()), this, SLOT(abort()));
@@ -141,6 +143,7 @@ Align::Align()
     solverTypeGroup->setId(onlineSolverR, SOLVER_ONLINE);
     solverTypeGroup->setId(offlineSolverR, SOLVER_OFFLINE);
     solverTypeGroup->setId(remoteSolverR, SOLVER_REMOTE);
+    solverTypeGroup->setId(nearSolverR, SOLVER_NEAR);
     solverTypeGroup->button(Options::solverType())->setChecked(true);
     connect(solverTypeGroup, SIGNAL(buttonClicked(int)), SLOT(setSolverType(int)));
 
@@ -160,6 +163,11 @@ Align::Align()
         remoteParser = new RemoteAstrometryParser();
         parser = remoteParser;
         break;
+
+    case SOLVER_NEAR:
+        nearParser = new NearAstrometryParser();
+        parser = nearParser;
+        break;
     }
 
     parser->setAlign(this);
@@ -257,6 +265,17 @@ void Align::setSolverType(int type)
         parser = remoteParser;
         (dynamic_cast<RemoteAstrometryParser*>(parser))->setCCD(currentCCD);
         break;
+
+    case SOLVER_NEAR:
+        if (nearParser != NULL)
+        {
+            parser = nearParser;
+            return;
+        }
+
+        nearParser = new Ekos::NearAstrometryParser();
+        parser = nearParser;
+        break;
     }
 
     parser->setAlign(this);
@@ -1809,6 +1828,24 @@ FOV* Align::fov()
 
 }
 
+void Align::getSolverHint(SkyPoint &coord, double &scale, double &fov_w, double &fov_h)
+{
+    coord = telescopeCoord;
+    fov_w = fov_x;
+    fov_h = fov_y;
+    scale = 0;
+
+    if (currentCCD == NULL || focal_length <= 0 || ccd_hor_pixel <= 0)
+        return;
+
+    int binx=1, biny=1;
+    ISD::CCDChip *targetChip = currentCCD->getChip(useGuideHead ? ISD::CCDChip::GUIDE_CCD : ISD::CCDChip::PRIMARY_CCD);
+    if (targetChip)
+        targetChip->getBinning(&binx, &biny);
+
+    scale = (206.264 * ccd_hor_pixel) / focal_length * binx;
+}
+
 void Align::setLockedFilter(ISD::GDInterface *filter, int lockedPosition)
 {
     currentFilter = filter;
@@ -34,6 +34,7 @@ class AstrometryParser;
 class OnlineAstrometryParser;
 class OfflineAstrometryParser;
 class RemoteAstrometryParser;
+class NearAstrometryParser;
 
 /**
  *@class Align
@@ -57,7 +58,7 @@ public:
     typedef enum { AZ_INIT, AZ_FIRST_TARGET, AZ_SYNCING, AZ_SLEWING, AZ_SECOND_TARGET, AZ_CORRECTING, AZ_FINISHED } AZStage;
     typedef enum { ALT_INIT, ALT_FIRST_TARGET, ALT_SYNCING, ALT_SLEWING, ALT_SECOND_TARGET, ALT_CORRECTING, ALT_FINISHED } ALTStage;
     typedef enum { GOTO_SYNC, GOTO_SLEW, GOTO_NOTHING } GotoMode;
-    typedef enum { SOLVER_ONLINE, SOLVER_OFFLINE, SOLVER_REMOTE} SolverType;
+    typedef enum { SOLVER_ONLINE, SOLVER_OFFLINE, SOLVER_REMOTE, SOLVER_NEAR} SolverType;
 
     /** @defgroup AlignDBusInterface Ekos DBus Interface - Align Module
      * Ekos::Align interface provides advanced scripting capabilities to solve images using online or offline astrometry.net
@@ -180,6 +181,15 @@ public:
      */
     FOV *fov();
 
+    /**
+     * @brief Return where the telescope points and what the CCD sees, for solvers which search near the telescope position.
+     * @param coord JNow coordinates of the telescope.
+     * @param scale expected pixel scale of the captured frames in arcsecs per pixel, including binning. 0 if unknown.
+     * @param fov_w width of the field of view in arcmins.
+     * @param fov_h height of the field of view in arcmins.
+     */
+    void getSolverHint(SkyPoint &coord, double &scale, double &fov_w, double &fov_h);
+
 
 public slots:
 
@@ -425,6 +435,7 @@ private:
     OnlineAstrometryParser *onlineParser;
     OfflineAstrometryParser *offlineParser;
     RemoteAstrometryParser *remoteParser;
+    NearAstrometryParser *nearParser;
 
     // Pointers to our devices
     ISD::Telescope *currentTelescope;
@@ -0,0 +1,507 @@
+/*  Near Astrometry Parser
+    Copyright (C) 2017 KStars Team
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include <QHash>
+#include <QMutex>
+#include <QtConcurrent>
+
+#include <KLocalizedString>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include "kstarsdata.h"
+#include "ksnumbers.h"
+#include "Options.h"
+#include "skycomponents/starcomponent.h"
+#include "skyobjects/starobject.h"
+#include "fitsviewer/fitsdata.h"
+
+#include "nearastrometryparser.h"
+#include "align.h"
+
+namespace Ekos
+{
+
+typedef std::complex<double> Complex;
+
+// Number of the brightest image stars whose triangles are matched
+static const int TriangleStars = 10;
+// Number of the brightest image stars used to verify a match
+static const int VerifyStars = 40;
+// Number of catalog stars kept per field of view of the search area
+static const int CatalogStarsPerField = 20;
+static const int MaximumCatalogStars = 2000;
+// Magnitude limits of the catalog search, which goes fainter until it has enough stars
+static const float FirstMagnitude = 8.0;
+static const float LastMagnitude  = 16.0;
+static const float MagnitudeStep  = 1.0;
+// Radius searched beyond the field of view around the telescope position, in degrees
+static const double SearchMargin = 1.0;
+// Tolerance on the expected pixel scale
+static const double ScaleTolerance = 0.05;
+// Tolerance on the position of a matched star, in pixels
+static const double PositionTolerance = 3.0;
+// Shortest triangle side matched, in pixels
+static const double MinimumSide = 20.0;
+static const int MinimumMatches = 6;
+static const double ArcsecPerRadian = 206264.8062470963552;
+
+namespace
+{
+
+/* Catalog stars bucketed in square cells, to find the stars near a position. */
+class StarGrid
+{
+public:
+    StarGrid(const QVector<Complex> &stars, double cellSize) : m_stars(stars), m_cellSize(cellSize)
+    {
+        for (int i=0; i < stars.size(); i++)
+            m_cells[key(cell(stars[i].real()), cell(stars[i].imag()))].append(i);
+    }
+
+    // Index of the star nearest to p within radius, -1 if none
+    int nearest(const Complex &p, double radius) const
+    {
+        int best = -1;
+        double bestDistance = radius;
+        int span = int(std::ceil(radius / m_cellSize));
+        int ci = cell(p.real()), cj = cell(p.imag());
+        for (int i=ci-span; i <= ci+span; i++)
+            for (int j=cj-span; j <= cj+span; j++)
+            {
+                QHash<qint64, QVector<int> >::const_iterator it = m_cells.constFind(key(i, j));
+                if (it == m_cells.constEnd())
+                    continue;
+                foreach (int index, it.value())
+                {
+                    double distance = std::abs(m_stars[index] - p);
+                    if (distance <= bestDistance)
+                    {
+                        bestDistance = distance;
+                        best = index;
+                    }
+                }
+            }
+        return best;
+    }
+
+    // Indexes of the stars within radius of p
+    void neighbours(const Complex &p, double radius, QVector<int> &result) const
+    {
+        result.clear();
+        int span = int(std::ceil(radius / m_cellSize));
+        int ci = cell(p.real()), cj = cell(p.imag());
+        for (int i=ci-span; i <= ci+span; i++)
+            for (int j=cj-span; j <= cj+span; j++)
+            {
+                QHash<qint64, QVector<int> >::const_iterator it = m_cells.constFind(key(i, j));
+                if (it == m_cells.constEnd())
+                    continue;
+                foreach (int index, it.value())
+                    if (std::abs(m_stars[index] - p) <= radius)
+                        result.append(index);
+            }
+    }
+
+private:
+    int cell(double x) const { return int(std::floor(x / m_cellSize)); }
+    static qint64 key(int i, int j) { return (qint64(i) << 32) ^ quint32(j); }
+
+    const QVector<Complex> &m_stars;
+    double m_cellSize;
+    QHash<qint64, QVector<int> > m_cells;
+};
+
+struct StarPair
+{
+    double length;
+    int a, b;
+
+    bool operator<(const StarPair &other) const { return length < other.length; }
+};
+
+}
+
+NearAstrometryParser::NearAstrometryParser() : AstrometryParser()
+{
+    align = NULL;
+    query.radius = query.scale = 0;
+    query.count = 0;
+
+    connect(&watcher, SIGNAL(finished()), this, SLOT(solverComplete()));
+}
+
+NearAstrometryParser::~NearAstrometryParser()
+{
+    abortRequested.store(1);
+    watcher.waitForFinished();
+}
+
+bool NearAstrometryParser::init()
+{
+    return true;
+}
+
+void NearAstrometryParser::verifyIndexFiles(double, double)
+{
+}
+
+bool NearAstrometryParser::startSovler(const QString &filename,  const QStringList &args, bool generated)
+{
+    Q_UNUSED(args);
+    Q_UNUSED(generated);
+
+    SkyPoint telescope;
+    double fov_w=0, fov_h=0;
+
+    align->getSolverHint(telescope, query.scale, fov_w, fov_h);
+
+    if (query.scale <= 0 || fov_w <= 0 || fov_h <= 0)
+    {
+        align->appendLogText(i18n("Near solver requires the focal length of the telescope and the pixel size of the CCD."));
+        emit solverFailed();
+        return false;
+    }
+
+    // The catalog positions are J2000, the telescope reports JNow
+    SkyPoint j2000 = telescope.deprecess(KStarsData::Instance()->updateNum());
+    telescope.setRA0(j2000.ra());
+    telescope.setDec0(j2000.dec());
+    query.center = telescope;
+
+    double fieldRadius = 0.5 * sqrt(fov_w*fov_w + fov_h*fov_h) / 60.0;
+    query.radius = fieldRadius + SearchMargin;
+
+    // Keep about as many catalog stars in each field as the image is expected to show
+    double fields = M_PI * query.radius * query.radius / (fov_w * fov_h / 3600.0);
+    query.count = qBound(3 * CatalogStarsPerField, int(CatalogStarsPerField * fields), MaximumCatalogStars);
+
+    // The catalog is searched in the worker too, deep star blocks may have to be read from disk
+    abortRequested.store(0);
+    solverTimer.start();
+    watcher.setFuture(QtConcurrent::run(&NearAstrometryParser::solveImage, filename, query, &abortRequested));
+
+    align->appendLogText(i18n("Starting near solver..."));
+
+    return true;
+}
+
+bool NearAstrometryParser::stopSolver()
+{
+    abortRequested.store(1);
+
+    return true;
+}
+
+QVector<NearAstrometryParser::CatalogStar> NearAstrometryParser::queryCatalog(const Query &query, float &maglim)
+{
+    QVector<CatalogStar> catalog;
+    StarComponent *component = StarComponent::Instance();
+    QMutex *mutex = component->mutex();
+
+    // Start with the bright stars and go fainter until there are enough, rather than reading
+    // every deep star block around the telescope. The lock is released between the searches
+    // so that the sky map keeps drawing, and kept while the stars found are read.
+    QList<StarObject*> stars;
+    for (maglim = FirstMagnitude; ; maglim += MagnitudeStep)
+    {
+        mutex->lock();
+        stars.clear();
+        component->starsInAperture(stars, query.center, query.radius, maglim);
+        if (stars.size() >= query.count || maglim >= LastMagnitude)
+            break;
+        mutex->unlock();
+    }
+
+    std::sort(stars.begin(), stars.end(), [](StarObject *a, StarObject *b) { return a->mag() < b->mag(); });
+
+    // Gnomonic projection around the telescope position, in pixels at the expected scale
+    double sinDec0, cosDec0;
+    query.center.dec0().SinCos(sinDec0, cosDec0);
+    foreach (StarObject *star, stars)
+    {
+        if (catalog.size() == query.count)
+            break;
+
+        double sinDec, cosDec, sinDRA, cosDRA;
+        star->dec0().SinCos(sinDec, cosDec);
+        dms(star->ra0().Degrees() - query.center.ra0().Degrees()).SinCos(sinDRA, cosDRA);
+
+        double cosc = sinDec0*sinDec + cosDec0*cosDec*cosDRA;
+        if (cosc <= 0)
+            continue;
+
+        CatalogStar entry;
+        entry.pos = QPointF(cosDec*sinDRA / cosc, (cosDec0*sinDec - sinDec0*cosDec*cosDRA) / cosc) * (ArcsecPerRadian / query.scale);
+        entry.mag = star->mag();
+        catalog.append(entry);
+    }
+
+    mutex->unlock();
+
+    return catalog;
+}
+
+NearAstrometryParser::Result NearAstrometryParser::solveImage(const QString &filename, const Query &query, const QAtomicInt *abort)
+{
+    Result result;
+    result.solved = false;
+    result.stars  = 0;
+
+    QVector<CatalogStar> catalog = queryCatalog(query, result.maglim);
+    result.catalogStars = catalog.size();
+
+    FITSData data(FITS_ALIGN);
+    if (data.loadFITS(filename) == false)
+    {
+        result.error = i18n("Failed to open file %1.", filename);
+        return result;
+    }
+
+    data.findStars();
+    QList<Edge*> edges = data.getStarCenters();
+    result.stars = edges.size();
+    std::sort(edges.begin(), edges.end(), [](Edge *a, Edge *b) { return a->sum > b->sum; });
+
+    QPointF center(data.getWidth() / 2.0, data.getHeight() / 2.0);
+    QVector<QPointF> image;
+    foreach (Edge *edge, edges)
+    {
+        if (image.size() == VerifyStars)
+            break;
+        image.append(QPointF(edge->x, edge->y) - center);
+    }
+
+    result.solved = matchStars(image, catalog, *abort, result.match);
+    if (result.solved == false)
+        result.error = i18n("Near solver could not match the %1 stars detected to the catalog. The telescope may be too far from its reported position.", result.stars);
+
+    return result;
+}
+
+bool NearAstrometryParser::matchStars(const QVector<QPointF> &image, const QVector<CatalogStar> &catalog, const QAtomicInt &abort, Match &match)
+{
+    match.matches = 0;
+
+    if (image.size() < 3 || catalog.size() < 3)
+        return false;
+
+    const int triangleStars = qMin(TriangleStars, image.size());
+    const int verifyStars   = qMin(VerifyStars, image.size());
+
+    QVector<Complex> stars(catalog.size());
+    for (int i=0; i < catalog.size(); i++)
+        stars[i] = Complex(catalog[i].pos.x(), catalog[i].pos.y());
+
+    // Only the catalog pairs as long as a side of the image triangles can match
+    double maxSide = 0;
+    for (int i=0; i < triangleStars; i++)
+        for (int j=i+1; j < triangleStars; j++)
+            maxSide = qMax(maxSide, std::abs(Complex(image[i].x() - image[j].x(), image[i].y() - image[j].y())));
+    maxSide *= 1 + ScaleTolerance;
+
+    StarGrid grid(stars, 4 * PositionTolerance);
+    StarGrid coarseGrid(stars, maxSide);
+
+    QVector<StarPair> pairs;
+    QVector<int> neighbours;
+    for (int a=0; a < stars.size(); a++)
+    {
+        coarseGrid.neighbours(stars[a], maxSide, neighbours);
+        foreach (int b, neighbours)
+        {
+            if (b <= a)
+                continue;
+            StarPair pair = { std::abs(stars[b] - stars[a]), a, b };
+            pairs.append(pair);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    double bestM[2] = { 0, 0 }, bestT[2] = { 0, 0 };
+    bool bestFlipped = false;
+    int best = 0;
+    bool done = false;
+
+    QVector<Complex> points(verifyStars);
+
+    for (int flip=0; flip < 2 && done == false; flip++)
+    {
+        for (int i=0; i < verifyStars; i++)
+        {
+            points[i] = Complex(image[i].x(), image[i].y());
+            if (flip)
+                points[i] = std::conj(points[i]);
+        }
+
+        // Triangles of the brightest stars first
+        for (int k=2; k < triangleStars && done == false; k++)
+            for (int j=1; j < k && done == false; j++)
+                for (int i=0; i < j && done == false; i++)
+                {
+                    if (abort.load())
+                        return false;
+
+                    // P and Q are the ends of the longest side, R is located relative to them
+                    Complex P = points[i], Q = points[j], R = points[k];
+                    if (std::abs(R - P) > std::abs(Q - P) && std::abs(R - P) >= std::abs(R - Q))
+                        std::swap(Q, R);
+                    else if (std::abs(R - Q) > std::abs(Q - P))
+                        std::swap(P, R);
+
+                    Complex side = Q - P;
+                    double length = std::abs(side);
+                    if (length < MinimumSide)
+                        continue;
+                    Complex relative = (R - P) / side;
+                    double tolerance = qMin(PositionTolerance + 0.01 * length, 4 * PositionTolerance);
+
+                    StarPair low = { length * (1 - ScaleTolerance), 0, 0 };
+                    StarPair high = { length * (1 + ScaleTolerance), 0, 0 };
+                    QVector<StarPair>::const_iterator first = std::lower_bound(pairs.constBegin(), pairs.constEnd(), low);
+                    QVector<StarPair>::const_iterator last  = std::upper_bound(first, pairs.constEnd(), high);
+
+                    for (QVector<StarPair>::const_iterator it = first; it != last; ++it)
+                    {
+                        for (int order=0; order < 2; order++)
+                        {
+                            Complex P2 = stars[order ? it->b : it->a];
+                            Complex Q2 = stars[order ? it->a : it->b];
+                            if (grid.nearest(P2 + relative * (Q2 - P2), tolerance) < 0)
+                                continue;
+
+                            // Check the transform given by the triangle against the other stars
+                            Complex m = (Q2 - P2) / side;
+                            Complex t = P2 - m * P;
+                            int count = 0;
+                            for (int s=0; s < verifyStars; s++)
+                                if (grid.nearest(m * points[s] + t, PositionTolerance) >= 0)
+                                    count++;
+
+                            if (count > best)
+                            {
+                                best = count;
+                                bestM[0] = m.real(); bestM[1] = m.imag();
+                                bestT[0] = t.real(); bestT[1] = t.imag();
+                                bestFlipped = flip;
+                            }
+                        }
+                    }
+
+                    // Most of the stars matched, no need to look further
+                    done = (best >= MinimumMatches && best >= verifyStars / 2);
+                }
+    }
+
+    if (best < MinimumMatches)
+        return false;
+
+    // Least squares fit of the transform on all the matched stars
+    Complex m(bestM[0], bestM[1]), t(bestT[0], bestT[1]);
+    QVector<Complex> from, to;
+    for (int i=0; i < verifyStars; i++)
+    {
+        Complex z(image[i].x(), image[i].y());
+        if (bestFlipped)
+            z = std::conj(z);
+        int index = grid.nearest(m * z + t, PositionTolerance);
+        if (index >= 0)
+        {
+            from.append(z);
+            to.append(stars[index]);
+        }
+    }
+
+    Complex meanFrom, meanTo;
+    for (int i=0; i < from.size(); i++)
+    {
+        meanFrom += from[i];
+        meanTo   += to[i];
+    }
+    meanFrom /= double(from.size());
+    meanTo   /= double(from.size());
+
+    Complex numerator;
+    double denominator = 0;
+    for (int i=0; i < from.size(); i++)
+    {
+        numerator   += (to[i] - meanTo) * std::conj(from[i] - meanFrom);
+        denominator += std::norm(from[i] - meanFrom);
+    }
+    if (denominator > 0)
+    {
+        m = numerator / denominator;
+        t = meanTo - m * meanFrom;
+    }
+
+    match.mRe = m.real();
+    match.mIm = m.imag();
+    match.tRe = t.real();
+    match.tIm = t.imag();
+    match.flipped = bestFlipped;
+    match.matches = from.size();
+    return true;
+}
+
+void NearAstrometryParser::solverComplete()
+{
+    if (abortRequested.load())
+        return;
+
+    Result result = watcher.result();
+
+    if (Options::solverVerbose())
+        align->appendLogText(i18n("Near solver searched %1 catalog stars down to magnitude %2 within %3 degrees of the telescope position.",
+                                  result.catalogStars, QString::number(result.maglim, 'f', 1), QString::number(query.radius, 'g', 3)));
+
+    if (result.solved == false)
+    {
+        align->appendLogText(result.error);
+        emit solverFailed();
+        return;
+    }
+
+    const Match &match = result.match;
+    Complex m(match.mRe, match.mIm);
+
+    // Inverse gnomonic projection of the center of the image
+    double centerRA  = query.center.ra0().Degrees();
+    double centerDec = query.center.dec0().Degrees();
+    double xi  = match.tRe * query.scale / ArcsecPerRadian;
+    double eta = match.tIm * query.scale / ArcsecPerRadian;
+    double rho = sqrt(xi*xi + eta*eta);
+    double c   = atan(rho);
+    double sinDec0, cosDec0;
+    dms(centerDec).SinCos(sinDec0, cosDec0);
+
+    double ra = centerRA, dec = centerDec;
+    if (rho > 0)
+    {
+        dec = asin(cos(c)*sinDec0 + eta*sin(c)*cosDec0/rho) * 180.0 / M_PI;
+        ra  = centerRA + atan2(xi*sin(c), rho*cosDec0*cos(c) - eta*sinDec0*sin(c)) * 180.0 / M_PI;
+        ra  = dms(ra).reduce().Degrees();
+    }
+
+    double pixscale = std::abs(m) * query.scale;
+
+    // Orientation of the top of the image (rows grow downwards), in degrees East of North
+    Complex up(0, -1);
+    if (match.flipped)
+        up = std::conj(up);
+    Complex direction = m * up;
+    double orientation = atan2(direction.real(), direction.imag()) * 180.0 / M_PI;
+
+    align->appendLogText(i18n("Near solver matched %1 of %2 stars in %3 ms.", match.matches, result.stars, solverTimer.elapsed()));
+
+    emit solverFinished(orientation, ra, dec, pixscale);
+}
+
+}
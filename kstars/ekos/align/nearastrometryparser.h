@@ -0,0 +1,118 @@
+/*  Near Astrometry Parser
+    Copyright (C) 2017 KStars Team
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#ifndef NEARASTROMETRYPARSER_H
+#define NEARASTROMETRYPARSER_H
+
+#include <QAtomicInt>
+#include <QFutureWatcher>
+#include <QPointF>
+#include <QTime>
+#include <QVector>
+
+#include "astrometryparser.h"
+#include "skypoint.h"
+
+namespace Ekos
+{
+
+class Align;
+
+/**
+ * @class  NearAstrometryParser
+ * NearAstrometryParser solves captured images in process, when the telescope position is already known within a degree or so,
+ * e.g. when re-centering a target or after a meridian flip. The stars detected in the image are matched by their triangles
+ * against the stars of the loaded catalogs around the telescope position, at the pixel scale expected from the optics.
+ * It needs no external solver nor index files, but cannot solve blind.
+ *
+ * @author KStars Team
+ */
+
+class NearAstrometryParser: public AstrometryParser
+{
+        Q_OBJECT
+
+public:
+    NearAstrometryParser();
+    virtual ~NearAstrometryParser();
+
+    virtual void setAlign(Align *_align) { align = _align; }
+    virtual bool init();
+    virtual void verifyIndexFiles(double fov_x, double fov_y);
+    virtual bool startSovler(const QString &filename, const QStringList &args, bool generated=true);
+    virtual bool stopSolver();
+
+    /**
+     * @brief A catalog star, projected on the plane tangent to the sky at the expected center of the image.
+     */
+    struct CatalogStar
+    {
+        QPointF pos;    // Standard coordinates (east, north), in pixels at the expected scale
+        float mag;
+    };
+
+    /**
+     * @brief Result of the matching. The image is mapped on the tangent plane by z' = m * z + t, z and z' as complex
+     * numbers, z being relative to the center of the image and conjugated if the image is flipped.
+     */
+    struct Match
+    {
+        double mRe, mIm;    // Scale and rotation
+        double tRe, tIm;    // Position of the center of the image on the tangent plane
+        bool flipped;       // Parity of the image
+        int matches;        // Number of image stars matched
+    };
+
+    /**
+     * @brief Match image stars to catalog stars.
+     * @param image positions of the image stars relative to the center of the image, brightest first.
+     * @param catalog catalog stars, brightest first.
+     * @param abort set to non zero to stop the search.
+     * @param match filled with the best match found.
+     * @return true if enough stars were matched.
+     */
+    static bool matchStars(const QVector<QPointF> &image, const QVector<CatalogStar> &catalog, const QAtomicInt &abort, Match &match);
+
+public slots:
+    void solverComplete();
+
+private:
+    struct Query
+    {
+        SkyPoint center;    // Telescope position, with its J2000 coordinates as ra0 and dec0
+        double radius;      // Search radius, in degrees
+        double scale;       // Expected scale, in arcseconds per pixel
+        int count;          // Number of catalog stars wanted
+    };
+
+    struct Result
+    {
+        bool solved;
+        QString error;
+        int stars;
+        int catalogStars;
+        float maglim;
+        Match match;
+    };
+
+    static QVector<CatalogStar> queryCatalog(const Query &query, float &maglim);
+    static Result solveImage(const QString &filename, const Query &query, const QAtomicInt *abort);
+
+    Align *align;
+    QFutureWatcher<Result> watcher;
+    QAtomicInt abortRequested;
+    QTime solverTimer;
+
+    // Catalog search of the running solve, its center is the tangent point
+    Query query;
+};
+
+}
+
+#endif // NEARASTROMETRYPARSER_H
@@ -27,6 +27,7 @@
 #include <float.h>
 
 #include <QApplication>
+#include <QMutexLocker>
 #include <QStringList>
 #include <QLocale>
 #include <QFile>
@@ -71,7 +72,11 @@ bool greaterThan(Edge *s1, Edge *s2)
 FITSData::FITSData(FITSMode fitsMode)
 {
     channels = 0;
-    wcs_coord    = NULL;
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    wcsParams = NULL;
+    wcsCount = 0;
+#endif
+    wcsGridColumns = 0;
     fptr = NULL;
     maxHFRStar = NULL;
     tempFile  = false;
@@ -99,7 +104,7 @@ FITSData::~FITSData()
     if (starCenters.count() > 0)
         qDeleteAll(starCenters);
 
-    delete[] wcs_coord;
+    clearWCS();
 
     if (objList.count() > 0)
         qDeleteAll(objList);
@@ -2124,8 +2129,6 @@ bool FITSData::checkWCS()
     int nkeyrec, nreject, nwcs, stat[2];
     double imgcrd[2], phi, pixcrd[2], theta, world[2];
     struct wcsprm *wcs=0;
-    int width=getWidth();
-    int height=getHeight();
 
     if (fits_hdr2str(fptr, 1, NULL, 0, &header, &nkeyrec, &status))
     {
@@ -2149,50 +2152,176 @@ bool FITSData::checkWCS()
     }
 
     // FIXME: Call above goes through EVEN if no WCS is present, so we're adding this to return for now.
-    if (wcs->crpix[0] == 0)
+    if (wcs->crpix[0] == 0 || (status = wcsset(wcs)))
+    {
+        if (status)
+            fprintf(stderr, "wcsset ERROR %d: %s.\n", status, wcs_errmsg[status]);
+        wcsvfree(&nwcs, &wcs);
+        return false;
+    }
+
+    // Sky coordinates are no longer computed for every pixel here, which took seconds and hundreds of MB
+    // for large frames. They are evaluated on demand from the WCS parameters, see pixelToWCS().
+    clearWCS();
+
+    findObjectsInImage(wcs, &world[0], phi, theta, &imgcrd[0], &pixcrd[0], &stat[0]);
+
+    QMutexLocker locker(&wcsMutex);
+    wcsParams = wcs;
+    wcsCount  = nwcs;
+    HasWCS = true;
+    return HasWCS;
+#endif
+#endif
+
+    return false;
+}
+
+void FITSData::clearWCS()
+{
+    QMutexLocker locker(&wcsMutex);
+
+    HasWCS = false;
+    wcsGrid.clear();
+    wcsGridColumns = 0;
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    if (wcsParams)
+        wcsvfree(&wcsCount, &wcsParams);
+    wcsParams = NULL;
+    wcsCount = 0;
+#endif
+}
+
+bool FITSData::pixelToWCS(double x, double y, wcs_point &coord)
+{
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    QMutexLocker locker(&wcsMutex);
+
+    if (wcsParams == NULL)
         return false;
 
-    if ((status = wcsset(wcs)))
+    int status, stat[1];
+    double imgcrd[2], phi, pixcrd[2], theta, world[2];
+
+    pixcrd[0]=x;
+    pixcrd[1]=y;
+
+    if ((status = wcsp2s(wcsParams, 1, 2, &pixcrd[0], &imgcrd[0], &phi, &theta, &world[0], &stat[0])))
     {
-        fprintf(stderr, "wcsset ERROR %d: %s.\n", status, wcs_errmsg[status]);
+        fprintf(stderr, "wcsp2s ERROR %d: %s.\n", status,  wcs_errmsg[status]);
         return false;
     }
 
-    delete[] wcs_coord;
+    coord.ra  = world[0];
+    coord.dec = world[1];
+    return true;
+#else
+    Q_UNUSED(x);
+    Q_UNUSED(y);
+    Q_UNUSED(coord);
+    return false;
+#endif
+}
 
-    wcs_coord = new wcs_point[width*height];
+// Must be called with wcsMutex locked
+bool FITSData::buildWCSGrid()
+{
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    if (wcsGrid.isEmpty() == false)
+        return true;
+    if (wcsParams == NULL)
+        return false;
 
-    wcs_point *p = wcs_coord;
+    // The grid covers the last row and column of pixels, so every pixel lies in a cell
+    int columns = (stats.width  - 1 + WCS_GRID_STEP - 1) / WCS_GRID_STEP + 1;
+    int rows    = (stats.height - 1 + WCS_GRID_STEP - 1) / WCS_GRID_STEP + 1;
+    if (columns < 2)
+        columns = 2;
+    if (rows < 2)
+        rows = 2;
 
-    for (int i=0; i < height; i++)
+    QVector<double> pixcrd(columns*2), imgcrd(columns*2), world(columns*2), phi(columns), theta(columns);
+    QVector<int> stat(columns);
+    QVector<wcs_point> grid(columns*rows);
+
+    // One row of the grid per call
+    for (int i=0; i < rows; i++)
     {
-        for (int j=0; j < width; j++)
+        for (int j=0; j < columns; j++)
         {
-            pixcrd[0]=j;
-            pixcrd[1]=i;
+            pixcrd[2*j]   = j * WCS_GRID_STEP;
+            pixcrd[2*j+1] = i * WCS_GRID_STEP;
+        }
 
-            if ((status = wcsp2s(wcs, 1, 2, &pixcrd[0], &imgcrd[0], &phi, &theta, &world[0], &stat[0])))
-            {
-                fprintf(stderr, "wcsp2s ERROR %d: %s.\n", status,  wcs_errmsg[status]);
-            }
-            else
-            {
-                p->ra  = world[0];
-                p->dec = world[1];
+        int status = wcsp2s(wcsParams, columns, 2, pixcrd.data(), imgcrd.data(), phi.data(), theta.data(), world.data(), stat.data());
+        if (status)
+        {
+            fprintf(stderr, "wcsp2s ERROR %d: %s.\n", status,  wcs_errmsg[status]);
+            return false;
+        }
 
-                p++;
-            }
+        for (int j=0; j < columns; j++)
+        {
+            grid[i*columns+j].ra  = world[2*j];
+            grid[i*columns+j].dec = world[2*j+1];
         }
     }
 
-    findObjectsInImage(wcs, &world[0], phi, theta, &imgcrd[0], &pixcrd[0], &stat[0]);
-
-    HasWCS = true;
-    return HasWCS;
-#endif
+    wcsGrid = grid;
+    wcsGridColumns = columns;
+    return true;
+#else
+    return false;
 #endif
+}
 
-    return false;
+bool FITSData::interpolatedWCS(double x, double y, wcs_point &coord)
+{
+    QMutexLocker locker(&wcsMutex);
+
+    if (buildWCSGrid() == false)
+        return false;
+
+    int rows = wcsGrid.size() / wcsGridColumns;
+    int j = KSUtils::clamp(int(x / WCS_GRID_STEP), 0, wcsGridColumns - 2);
+    int i = KSUtils::clamp(int(y / WCS_GRID_STEP), 0, rows - 2);
+    double u = x / WCS_GRID_STEP - j;
+    double v = y / WCS_GRID_STEP - i;
+
+    const wcs_point &p00 = wcsGrid[i*wcsGridColumns+j];
+    const wcs_point &p01 = wcsGrid[i*wcsGridColumns+j+1];
+    const wcs_point &p10 = wcsGrid[(i+1)*wcsGridColumns+j];
+    const wcs_point &p11 = wcsGrid[(i+1)*wcsGridColumns+j+1];
+
+    // Unwrap the right ascensions around the first corner, in case the cell crosses 0h
+    double ra01 = p01.ra, ra10 = p10.ra, ra11 = p11.ra;
+    ra01 += (ra01 - p00.ra > 180) ? -360 : ((ra01 - p00.ra < -180) ? 360 : 0);
+    ra10 += (ra10 - p00.ra > 180) ? -360 : ((ra10 - p00.ra < -180) ? 360 : 0);
+    ra11 += (ra11 - p00.ra > 180) ? -360 : ((ra11 - p00.ra < -180) ? 360 : 0);
+
+    double ra = (1-v)*((1-u)*p00.ra + u*ra01) + v*((1-u)*ra10 + u*ra11);
+    coord.ra  = KSUtils::reduceAngle(ra, 0.0, 360.0);
+    coord.dec = (1-v)*((1-u)*p00.dec + u*p01.dec) + v*((1-u)*p10.dec + u*p11.dec);
+    return true;
+}
+
+bool FITSData::getWCSRange(double &minRA, double &maxRA, double &minDec, double &maxDec)
+{
+    QMutexLocker locker(&wcsMutex);
+
+    if (buildWCSGrid() == false)
+        return false;
+
+    minRA = minDec = 1000;
+    maxRA = maxDec = -1000;
+    foreach (const wcs_point &p, wcsGrid)
+    {
+        minRA  = qMin(minRA, p.ra);
+        maxRA  = qMax(maxRA, p.ra);
+        minDec = qMin(minDec, p.dec);
+        maxDec = qMax(maxDec, p.dec);
+    }
+    return true;
 }
 
 #ifndef KSTARS_LITE
@@ -2221,20 +2350,24 @@ void FITSData::findObjectsInImage(struct wcsprm *wcs, double world[], double phi
 
     SkyMapComposite *map=KStarsData::Instance()->skyComposite();
 
-    wcs_point * wcs_coord = getWCSCoord();
-    if (wcs_coord)
+    double corners[4] = { 0, 0, double(width-1), double(height-1) };
+    double cornersImg[4], cornersWorld[4], cornersPhi[2], cornersTheta[2];
+    int cornersStat[2];
+    if ((status = wcsp2s(wcs, 2, 2, &corners[0], &cornersImg[0], &cornersPhi[0], &cornersTheta[0], &cornersWorld[0], &cornersStat[0])))
+    {
+        fprintf(stderr, "wcsp2s ERROR %d: %s.\n", status,  wcs_errmsg[status]);
+    }
+    else
     {
-        int size=width*height;
-
         objList.clear();
 
         SkyPoint p1;
-        p1.setRA0(dms(wcs_coord[0].ra));
-        p1.setDec0(dms(wcs_coord[0].dec));
+        p1.setRA0(dms(cornersWorld[0]));
+        p1.setDec0(dms(cornersWorld[1]));
         p1.updateCoordsNow(num);
         SkyPoint p2;
-        p2.setRA0(dms(wcs_coord[size-1].ra));
-        p2.setDec0(dms(wcs_coord[size-1].dec));
+        p2.setRA0(dms(cornersWorld[2]));
+        p2.setDec0(dms(cornersWorld[3]));
         p2.updateCoordsNow(num);
         QList<SkyObject*> list= map->findObjectsInArea( p1, p2 );
 
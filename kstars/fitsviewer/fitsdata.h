@@ -30,7 +30,9 @@
 #include <QPaintEvent>
 #include <QScrollArea>
 #include <QLabel>
+#include <QMutex>
 #include <QStringList>
+#include <QVector>
 
 #include "skyobject.h"
 
@@ -58,6 +60,7 @@
 
 #define MINIMUM_PIXEL_RANGE 5
 #define MINIMUM_STDVAR  5
+#define WCS_GRID_STEP   32
 
 class QProgressDialog;
 
@@ -175,7 +178,12 @@ public:
     // WCS
     bool checkWCS();
     bool hasWCS() { return HasWCS; }
-    wcs_point *getWCSCoord()  { return wcs_coord; }
+    // Sky coordinates of a pixel, computed exactly from the WCS keywords
+    bool pixelToWCS(double x, double y, wcs_point &coord);
+    // Sky coordinates of a pixel, interpolated in a coarse grid of exact coordinates. Good enough for overlays.
+    bool interpolatedWCS(double x, double y, wcs_point &coord);
+    // Range of the sky coordinates covered by the image, in degrees
+    bool getWCSRange(double &minRA, double &maxRA, double &minDec, double &maxDec);
 
     // Debayer
     bool hasDebayer() { return HasDebayer; }
@@ -231,6 +239,8 @@ private:
     int calculateMinMax(bool refresh=false);    
     bool checkDebayer();
     void readWCSKeys();
+    void clearWCS();
+    bool buildWCSGrid();
 
     // Templated functions
 
@@ -286,7 +296,15 @@ private:
     int flipHCounter;                   // How many times the image was flipped horizontally?
     int flipVCounter;                   // How many times the image was flipped vertically?
 
-    wcs_point *wcs_coord;               // Pointer to WCS coordinate data, if any.
+    #ifndef KSTARS_LITE
+    #ifdef HAVE_WCSLIB
+    struct wcsprm *wcsParams;           // WCS parameters, if any.
+    int wcsCount;                       // Number of WCS parameter sets allocated by wcspih.
+    #endif
+    #endif
+    QMutex wcsMutex;                    // Protects the WCS parameters and grid, which are filled in the background.
+    QVector<wcs_point> wcsGrid;         // Coordinates of every WCS_GRID_STEP pixel, computed when first needed.
+    int wcsGridColumns;                 // Number of columns of the coordinate grid.
     QList<Edge*> starCenters;           // All the stars we detected, if any.
     Edge* maxHFRStar;                   // The biggest fattest star in the image.
 
@@ -230,17 +230,12 @@ void FITSLabel::mouseMoveEvent(QMouseEvent *e)
 
     if (image_data->hasWCS()&&image->getMouseMode()!=FITSView::selectMouse)
     {
-        int index = x + y * width;
+        wcs_point wcs_coord;
 
-        wcs_point * wcs_coord = image_data->getWCSCoord();
-
-        if (wcs_coord)
+        if (image_data->pixelToWCS(x, y, wcs_coord))
         {
-            if (index > size)
-                return;
-
-            ra.setD(wcs_coord[index].ra);
-            dec.setD(wcs_coord[index].dec);
+            ra.setD(wcs_coord.ra);
+            dec.setD(wcs_coord.dec);
 
             emit newStatus(QString("%1 , %2").arg( ra.toHMSString()).arg(dec.toDMSString()), FITS_WCS);
         }
@@ -286,17 +281,17 @@ void FITSLabel::mousePressEvent(QMouseEvent *e)
         if (image_data->hasWCS())
         {
 
-            wcs_point * wcs_coord = image_data->getWCSCoord();
+            wcs_point wcs_coord;
             double x,y;
             x = round(e->x() / scale);
             y = round(e->y() / scale);
 
             x = KSUtils::clamp(x, 1.0, width);
             y = KSUtils::clamp(y, 1.0, height);
-            int index = x + y * width;
-            if(KMessageBox::Continue==KMessageBox::warningContinueCancel(NULL, "Slewing to Coordinates: \nRA: " + dms(wcs_coord[index].ra).toHMSString() + "\nDec: " + dms(wcs_coord[index].dec).toDMSString(),
+            if(image_data->pixelToWCS(x - 1, y - 1, wcs_coord) &&
+               KMessageBox::Continue==KMessageBox::warningContinueCancel(NULL, "Slewing to Coordinates: \nRA: " + dms(wcs_coord.ra).toHMSString() + "\nDec: " + dms(wcs_coord.dec).toDMSString(),
                                  i18n("Continue Slew"),  KStandardGuiItem::cont(), KStandardGuiItem::cancel(), "continue_slew_warning")){
-                centerTelescope(wcs_coord[index].ra/15.0, wcs_coord[index].dec);
+                centerTelescope(wcs_coord.ra/15.0, wcs_coord.dec);
             }
         }
 #endif
@@ -1115,60 +1110,63 @@ This method will paint EQ Gridlines in an overlay if there is WCS data present.
 It determines the minimum and maximum RA and DEC, then it uses that information to
 judge which gridLines to draw.  Then it calls the drawEQGridlines methods below
 to draw gridlines at those specific RA and Dec values.
+The coordinates are interpolated from the coarse WCS grid of the image, and only computed
+along the sides of the image where the gridlines are searched.
  */
 
 void FITSView::drawEQGrid(QPainter *painter){
 
    if (image_data->hasWCS())
        {
-           wcs_point * wcs_coord = image_data->getWCSCoord();
-           if (wcs_coord)
+           double maxRA, minRA, maxDec, minDec;
+           if (image_data->getWCSRange(minRA, maxRA, minDec, maxDec))
            {
-               int size=image_width*image_height;
-               double maxRA=-1000; double minRA=1000; double maxDec=-1000; double minDec=1000;
-
-               for(int i=0;i<(size);i++)
+               // Top, left, bottom and right sides of the image, one pixel inside
+               QVector<wcs_point> sides[4];
+               sides[0].resize(image_width);
+               sides[2].resize(image_width);
+               for(int x=0;x<image_width;x++)
+               {
+                   image_data->interpolatedWCS(x, 1, sides[0][x]);
+                   image_data->interpolatedWCS(x, image_height-2, sides[2][x]);
+               }
+               sides[1].resize(image_height);
+               sides[3].resize(image_height);
+               for(int y=0;y<image_height;y++)
                {
-                   double ra = wcs_coord[i].ra;
-                   double dec = wcs_coord[i].dec;
-                   if(ra>maxRA)
-                       maxRA=ra;
-                   if(ra<minRA)
-                       minRA=ra;
-                   if(dec>maxDec)
-                       maxDec=dec;
-                   if(dec<minDec)
-                       minDec=dec;
+                   image_data->interpolatedWCS(1, y, sides[1][y]);
+                   image_data->interpolatedWCS(image_width-2, y, sides[3][y]);
                }
+
                painter->setPen( QPen( Qt::yellow) );
 
                if (maxDec>80){
                    int minRAMinutes=(int)(minRA/15);//This will force the scale to whole hours of RA near the pole
                    int maxRAMinutes=(int)(maxRA/15);
                    for(int targetRA=minRAMinutes;targetRA<=maxRAMinutes;targetRA++)
-                       drawEQGridlineAtRA(painter,wcs_coord,targetRA*15);
+                       drawEQGridlineAtRA(painter,sides,targetRA*15);
                }else{
                    int minRAMinutes=(int)(minRA/15*60);//This will force the scale to whole minutes of RA
                    int maxRAMinutes=(int)(maxRA/15*60);
                    for(int targetRA=minRAMinutes;targetRA<=maxRAMinutes;targetRA++)
-                       drawEQGridlineAtRA(painter,wcs_coord,targetRA*15/60.0);
+                       drawEQGridlineAtRA(painter,sides,targetRA*15/60.0);
                }
 
 
                int minDecMinutes=(int)(minDec*4);//This will force the Dec Scale to 15 arc minutes
                int maxDecMinutes=(int)(maxDec*4);
                for(int targetDec=minDecMinutes;targetDec<=maxDecMinutes;targetDec++)
-                    drawEQGridlineAtDec(painter,wcs_coord,targetDec/4.0);
+                    drawEQGridlineAtDec(painter,sides,targetDec/4.0);
            }
        }
 }
 
-void FITSView::drawEQGridlineAtRA(QPainter *painter,wcs_point *wcs_coord, double target){
-    drawEQGridline(painter,wcs_coord,true,target);
+void FITSView::drawEQGridlineAtRA(QPainter *painter, const QVector<wcs_point> sides[4], double target){
+    drawEQGridline(painter,sides,true,target);
 }
 
-void FITSView::drawEQGridlineAtDec(QPainter *painter,wcs_point *wcs_coord, double target){
-    drawEQGridline(painter,wcs_coord,false,target);
+void FITSView::drawEQGridlineAtDec(QPainter *painter, const QVector<wcs_point> sides[4], double target){
+    drawEQGridline(painter,sides,false,target);
 }
 
 /**
@@ -1178,15 +1176,14 @@ If it fails to find two points, it just doesn't draw a line.  It makes heavy use
 pointIsNearWCSTargetPoint to simplify the if statements, which is defined below.
  */
 
-void FITSView::drawEQGridline(QPainter *painter,wcs_point *wcs_coord, bool isRA, double target){
+void FITSView::drawEQGridline(QPainter *painter, const QVector<wcs_point> sides[4], bool isRA, double target){
     float scale=(currentZoom / ZOOM_DEFAULT);
     int num=0;
     QPoint pt[2];
-    bool vertical=true;
     //Search along top of image
     for(int x=1;x<image_width-1;x++){
         int y=1;
-        if(pointIsNearWCSTargetPoint(wcs_coord,target,x,y,isRA,!vertical)){
+        if(pointIsNearWCSTargetPoint(sides[0],target,x,isRA)){
             pt[num] = QPoint(x * scale,y * scale);
             num++;
             break;
@@ -1195,7 +1192,7 @@ void FITSView::drawEQGridline(QPainter *painter,wcs_point *wcs_coord, bool isRA,
     //Search along left side of image
     for(int y=1;y<image_height-1;y++){
             int x=1;
-            if(pointIsNearWCSTargetPoint(wcs_coord,target,x,y,isRA,vertical)){
+            if(pointIsNearWCSTargetPoint(sides[1],target,y,isRA)){
                     pt[num] = QPoint(x * scale,y * scale);
                     num++;
                     break;
@@ -1203,18 +1200,18 @@ void FITSView::drawEQGridline(QPainter *painter,wcs_point *wcs_coord, bool isRA,
             }
     }
     //Search along bottom of image
-    for(int x=1;x<image_width-1;x++){
+    for(int x=1;x<image_width-1 && num<2;x++){
         int y=image_height-2;
-        if(pointIsNearWCSTargetPoint(wcs_coord,target,x,y,isRA,!vertical)){
+        if(pointIsNearWCSTargetPoint(sides[2],target,x,isRA)){
             pt[num] = QPoint(x * scale,y * scale);
             num++;
             break;
         }
     }
     //Search along right side of image
-        for(int y=1;y<image_height-1;y++){
+        for(int y=1;y<image_height-1 && num<2;y++){
             int x=image_width-2;
-            if(pointIsNearWCSTargetPoint(wcs_coord,target,x,y,isRA,vertical)){
+            if(pointIsNearWCSTargetPoint(sides[3],target,y,isRA)){
                     pt[num] = QPoint(x * scale,y * scale);
                     num++;
                     break;
@@ -1234,26 +1231,20 @@ This method is intended to help find the X,Y Coordinates of a certain RA or DEC
 Since the exact RA or DEC we are looking for probably does not match the exact RA or DEC for
 a specific pixel, we have to compare the RA or DEC that we are looking for to the RA and DEC
 in the WCS info of the surrounding pixels.  The method returns true if the position
- approximates the target RA or DEC.  To use the method, you need to specify the target number,
- whether you are looking horizontally or vertically, and whether you are looking at RA or DEC,
- in addition to giving the wcs_coord array and the x and y coordinates.
+ approximates the target RA or DEC.  To use the method, you need to specify the target number
+ and whether you are looking at RA or DEC, in addition to giving the coordinates along
+ a side of the image and the position i along that side.
  */
 
-bool FITSView::pointIsNearWCSTargetPoint(wcs_point *wcs_coord, double target, int x, int y, bool isRA, bool vertical){
-    int i = x + y * image_width;
-    int shift;//The Number of index values to the next point to compare
-    if(vertical)
-        shift=image_width;//Vertically it is a full row to the next point
-    else
-        shift=1;//Horizontally it is the next point
+bool FITSView::pointIsNearWCSTargetPoint(const QVector<wcs_point> &side, double target, int i, bool isRA){
     double nextPoint;
     double prevPoint;
     if(isRA){
-        nextPoint=wcs_coord[i+shift].ra;
-        prevPoint=wcs_coord[i-shift].ra;
+        nextPoint=side[i+1].ra;
+        prevPoint=side[i-1].ra;
     } else{
-        nextPoint=wcs_coord[i+shift].dec;
-        prevPoint=wcs_coord[i-shift].dec;
+        nextPoint=side[i+1].dec;
+        prevPoint=side[i-1].dec;
     }
 
    return (target>nextPoint&&target<prevPoint)||(target>prevPoint&&target<nextPoint);
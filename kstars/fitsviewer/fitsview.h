@@ -197,10 +197,10 @@ private:
     double stddev();
     void calculateMaxPixel(double min, double max);
     void initDisplayImage();
-    void drawEQGridline(QPainter *painter, wcs_point *wcs_coord, bool isRA, double targetRA);
-    void drawEQGridlineAtRA(QPainter *painter, wcs_point *wcs_coord, double targetRA);
-    void drawEQGridlineAtDec(QPainter *painter, wcs_point *wcs_coord, double targetRA);
-    bool pointIsNearWCSTargetPoint(wcs_point *wcs_coord, double target, int x, int y, bool isRA, bool vertical);
+    void drawEQGridline(QPainter *painter, const QVector<wcs_point> sides[4], bool isRA, double targetRA);
+    void drawEQGridlineAtRA(QPainter *painter, const QVector<wcs_point> sides[4], double targetRA);
+    void drawEQGridlineAtDec(QPainter *painter, const QVector<wcs_point> sides[4], double targetRA);
+    bool pointIsNearWCSTargetPoint(const QVector<wcs_point> &side, double target, int i, bool isRA);
 
     FITSLabel *image_frame;
     FITSData *image_data;
@@ -8,6 +8,7 @@
 #include "SpatialVector.h"
 #include "SpatialIndex.h"
 #include "RangeConvex.h"
+#include "SpatialConstraint.h"
 #include "HtmRange.h"
 #include "HtmRangeIterator.h"
 
@@ -161,6 +162,73 @@ void HTMesh::intersect(double ra1, double dec1, double ra2, double dec2,
 }
 
 
+// CONVEX POLYGON
+bool HTMesh::intersect(int n, const double *ra, const double *dec,
+                       double margin, BufNum bufNum)
+{
+    if ( n < 3 )
+        return false;
+
+    SpatialVector *v = new SpatialVector[n];
+    SpatialVector center(0.0, 0.0, 0.0);
+    for ( int i = 0; i < n; i++ ) {
+        v[i].set( ra[i], dec[i] );
+        center = center + v[i];
+    }
+    if ( center.length() < eps ) {
+        delete [] v;
+        return false;
+    }
+    center.normalize();
+
+    // Move each vertex away from the center by the margin.  The edges of a
+    // convex polygon then move out by at least margin * sin(angle / 2) where
+    // angle is the smallest angle of the polygon, so the caller should pad
+    // the margin for polygons with sharp corners.
+    double sinMargin = sin( margin * degree2Rad );
+    double cosMargin = cos( margin * degree2Rad );
+    for ( int i = 0; i < n; i++ ) {
+        SpatialVector out = ( v[i] * center ) * v[i] - center;
+        if ( out.length() < eps )
+            continue;
+        out.normalize();
+        SpatialVector moved = cosMargin * v[i] + sinMargin * out;
+        moved.normalize();
+        v[i] = moved;
+    }
+
+    // Each edge is a great circle. The polygon is inside all of them if it
+    // is convex, so every vertex must be on the same side as the center.
+    RangeConvex convex;
+    bool convexPolygon = true;
+    for ( int i = 0; i < n && convexPolygon; i++ ) {
+        SpatialVector normal = v[i] ^ v[(i + 1) % n];
+        if ( normal.length() < eps )
+            continue;
+        if ( normal * center < 0.0 )
+            normal = (-1) * normal;
+        for ( int j = 0; j < n; j++ ) {
+            if ( normal * v[j] < -eps * normal.length() ) {
+                convexPolygon = false;
+                break;
+            }
+        }
+        SpatialConstraint c(normal, 0.0);
+        convex.add(c);
+    }
+    delete [] v;
+
+    if ( ! convexPolygon )
+        return false;
+
+    if ( ! performIntersection(&convex, bufNum) ) {
+        printf("In intersect(polygon of %d vertices)\n", n);
+        return false;
+    }
+    return true;
+}
+
+
 void HTMesh::toXYZ(double ra, double dec, double *x, double *y, double *z)
 {
     ra  *= degree2Rad;
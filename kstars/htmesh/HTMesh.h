@@ -117,6 +117,16 @@ public:
                        double ra3, double dec3, double ra4, double dec4,
                        BufNum bufNum=0);
 
+        /** @short finds the trixels that cover the specified convex polygon
+         * after growing it by margin degrees in every direction.
+         * The n vertices (ra[i], dec[i]), in degrees, must follow each other
+         * around the polygon, in either direction.
+         * @return false, leaving the buffer untouched, if the polygon is not
+         * convex or does not fit in a hemisphere.
+         */
+        bool intersect(int n, const double *ra, const double *dec,
+                       double margin, BufNum bufNum=0);
+
         /** @short returns the number of trixels in the result buffer bufNum.
          */
         int intersectSize(BufNum bufNum=0);
@@ -8,6 +8,7 @@ MeshBuffer::MeshBuffer(HTMesh *mesh) {
 
     m_size= 0;
     m_error = 0;
+    m_generation = 0;
     maxSize = mesh->size();
     m_buffer = (Trixel*) malloc( sizeof(Trixel) * maxSize );
 
@@ -38,4 +39,5 @@ void MeshBuffer::fill() {
         m_buffer[i] = i;
     }
     m_size = maxSize;
+    ++m_generation;
 }
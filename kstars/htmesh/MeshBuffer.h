@@ -32,7 +32,7 @@ class MeshBuffer {
 
         /** @short prepare the buffer for a new result set
          */
-        void reset() { m_size = m_error = 0; }
+        void reset() { m_size = m_error = 0; ++m_generation; }
 
         /** @short add trixels to the buffer
          */
@@ -55,11 +55,18 @@ class MeshBuffer {
          */
         void fill();
 
+        /** @short returns a number that changes every time the buffer is
+         * refilled, so that users can tell whether a result set they computed
+         * earlier is still there.
+         */
+        unsigned int generation() const { return m_generation; }
+
     private:
         Trixel *m_buffer;
         int    m_size;
         int    maxSize;
         int    m_error;
+        unsigned int m_generation;
 
 };
 
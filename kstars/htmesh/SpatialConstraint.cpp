@@ -31,6 +31,7 @@ SpatialConstraint::SpatialConstraint(SpatialVector a, float64 d) :
 {
     a_.normalize();
     s_ = acos(d_);
+    sign_ = zERO;
     if(d_ <= -gEpsilon)
         sign_ = nEG;
     if(d_ >=  gEpsilon)
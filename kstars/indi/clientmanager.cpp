@@ -9,12 +9,14 @@
  */
 
 #include <cstdlib>
+#include <cstring>
 
 #include <QDebug>
 #include <QProcess>
 #include <QTime>
 #include <QTemporaryFile>
 #include <QDataStream>
+#include <QMutexLocker>
 #include <QTimer>
 
 #include <basedevice.h>
@@ -34,6 +36,11 @@ ClientManager::ClientManager()
 
 sManager = NULL;
 
+updateInterval = Options::indiUpdateInterval();
+updateTimer.setSingleShot(true);
+updateTimer.setInterval(updateInterval);
+connect(&updateTimer, SIGNAL(timeout()), this, SLOT(flushNumbers()));
+
 }
 
 ClientManager::~ClientManager()
@@ -117,11 +124,34 @@ void ClientManager::newProperty(INDI::Property *prop)
 
 void ClientManager::removeProperty(INDI::Property *prop)
 {
+    if (prop->getType() == INDI_NUMBER)
+    {
+        QMutexLocker locker(&updateMutex);
+        pendingNumbers.removeOne(prop->getNumber());
+        numberStates.remove(prop->getNumber());
+    }
+
     emit removeINDIProperty(prop);
 }
 
 void ClientManager::removeDevice(INDI::BaseDevice *dp)
 {
+    {
+        QMutexLocker locker(&updateMutex);
+        QMutableListIterator<INumberVectorProperty *> it(pendingNumbers);
+        while (it.hasNext())
+        {
+            if (!strcmp(it.next()->device, dp->getDeviceName()))
+                it.remove();
+        }
+        QMutableHashIterator<INumberVectorProperty *, IPState> states(numberStates);
+        while (states.hasNext())
+        {
+            if (!strcmp(states.next().key()->device, dp->getDeviceName()))
+                states.remove();
+        }
+    }
+
     foreach(DriverInfo *driverInfo, managedDrivers)
     {
         foreach(DeviceInfo *deviceInfo, driverInfo->getDevices())
@@ -156,9 +186,43 @@ void ClientManager::newSwitch(ISwitchVectorProperty *svp)
 
 void ClientManager::newNumber(INumberVectorProperty * nvp)
 {
+    if (updateInterval > 0)
+    {
+        QMutexLocker locker(&updateMutex);
+
+        QHash<INumberVectorProperty *, IPState>::const_iterator state = numberStates.constFind(nvp);
+        if (state != numberStates.constEnd() && state.value() == nvp->s)
+        {
+            // The receivers read the values when the update is delivered, so the latest ones
+            if (!pendingNumbers.contains(nvp))
+            {
+                pendingNumbers.append(nvp);
+                if (pendingNumbers.count() == 1)
+                    QMetaObject::invokeMethod(&updateTimer, "start", Qt::QueuedConnection);
+            }
+            return;
+        }
+
+        // Changes of state are delivered at once
+        numberStates[nvp] = nvp->s;
+        pendingNumbers.removeOne(nvp);
+    }
+
     emit newINDINumber(nvp);
 }
 
+void ClientManager::flushNumbers()
+{
+    QList<INumberVectorProperty *> numbers;
+    {
+        QMutexLocker locker(&updateMutex);
+        numbers.swap(pendingNumbers);
+    }
+
+    foreach(INumberVectorProperty *nvp, numbers)
+        emit newINDINumber(nvp);
+}
+
 void ClientManager::newText(ITextVectorProperty * tvp)
 {
     emit newINDIText(tvp);
@@ -220,6 +284,12 @@ void ClientManager::serverConnected()
 
 void ClientManager::serverDisconnected(int exit_code)
 {
+    {
+        QMutexLocker locker(&updateMutex);
+        pendingNumbers.clear();
+        numberStates.clear();
+    }
+
     foreach (DriverInfo *device, managedDrivers)
     {
         device->setClientState(false);
@@ -18,6 +18,11 @@
 #include <QObject>
 #endif
 
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QTimer>
+
 #include "config-kstars.h"
 
 class DeviceInfo;
@@ -31,6 +36,10 @@ class ServerManager;
  * ClientManager is a subclass of INDI::BaseClient class part of the INDI Library.
  * This enables the class to communicate with INDI server and to receive notification of devices, properties, and messages.
  *
+ * Number properties such as coordinates, temperatures or exposure progress may be updated at high rates.
+ * Their updates are delivered at most once per Options::indiUpdateInterval() milliseconds, with their latest
+ * values, unless the state of the property changes. The other properties are always delivered at once.
+ *
  * @author Jasem Mutlaq
  * @version 1.1
  */
@@ -75,11 +84,22 @@ protected:
     virtual void serverConnected();
     virtual void serverDisconnected(int exit_code);
 
+private slots:
+    void flushNumbers();
+
 private:
 
     QList<DriverInfo *> managedDrivers;
     ServerManager *sManager;
 
+    // Updates of numbers waiting for updateTimer, and the last state delivered for each number.
+    // These are shared with the thread of the INDI client.
+    QList<INumberVectorProperty *> pendingNumbers;
+    QHash<INumberVectorProperty *, IPState> numberStates;
+    QMutex updateMutex;
+    QTimer updateTimer;
+    int updateInterval;
+
 signals:
     void connectionSuccessful();
     void connectionFailure(ClientManager *);
@@ -34,6 +34,8 @@
 #include "kstarssplash.h"
 #include "kactionmenu.h"
 #include "skymap.h"
+#include "skycomponents/skymapcomposite.h"
+#include "skycomponents/componentloader.h"
 #include "ksutils.h"
 #include "simclock.h"
 #include "fov.h"
@@ -314,10 +316,35 @@ void KStars::applyConfig( bool doApplyFocus ) {
                 map()->setClickedPoint( &fp );
                 map()->slotCenter();
             }
+
+            // The object may belong to a component which is still loading
+            if ( Options::focusObject() != i18n("nothing") && Options::focusObject() != i18n("star")
+                 && ! data()->skyComposite()->loader()->isFinished() )
+                connect( data()->skyComposite(), SIGNAL( objectNamesChanged() ), this, SLOT( slotResolveFocusObject() ), Qt::UniqueConnection );
         }
     }
 }
 
+void KStars::slotResolveFocusObject() {
+    // The names are complete once the last component is loaded
+    if ( ! data()->skyComposite()->loader()->isFinished() )
+        return;
+    disconnect( data()->skyComposite(), SIGNAL( objectNamesChanged() ), this, SLOT( slotResolveFocusObject() ) );
+
+    // Another object may have been centered meanwhile
+    if ( map()->focusObject() )
+        return;
+
+    SkyObject *fo = data()->objectNamed( Options::focusObject() );
+    if ( ! fo ) {
+        qWarning() << "Cannot center on " << Options::focusObject() << ": no object found." << endl;
+        return;
+    }
+    map()->setClickedObject( fo );
+    map()->setClickedPoint( fo );
+    map()->slotCenter();
+}
+
 void KStars::showImgExportDialog() {
     if(m_ExportImageDialog)
         m_ExportImageDialog->show();
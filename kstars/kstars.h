@@ -399,6 +399,19 @@ public Q_SLOTS:
      */
     Q_SCRIPTABLE QString getSkyMapDimensions();
 
+    /** DBUS interface function.  Enable or disable the profiling of the sky map frames.
+     * The values recorded so far are discarded.
+     * @param enable true to start recording the time spent drawing the sky map
+     */
+    Q_SCRIPTABLE Q_NOREPLY void setFrameProfiling( bool enable );
+
+    /** DBUS interface function.  Get the profile of the sky map frames.
+     * @return a newline-separated list of the time spent in each part of the drawing, in the
+     * last frame, on average and at most since the profiling was enabled, followed by the counters
+     * of stars, trixels and labels and the statistics of the labeler.
+     */
+    Q_SCRIPTABLE QString getFrameProfile();
+
     /** DBUS interface function.  Return a newline-separated list of objects in the observing wishlist.
      * @note Unfortunately, unnamed objects are troublesome. Hopefully, we don't have them on the observing list.
      */
@@ -475,6 +488,9 @@ public Q_SLOTS:
 
 
 private slots:
+    /** Center on the focus object once the components which may hold it are loaded */
+    void slotResolveFocusObject();
+
     /** action slot: open a dialog for setting the time and date */
     void slotSetTime();
 
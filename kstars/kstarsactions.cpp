@@ -776,7 +776,7 @@ void KStars::slotApplyConfigChanges() {
 
     applyConfig();
     data()->setFullTimeUpdate();
-    map()->forceUpdate();
+    map()->forceCoordinateUpdate();
 
     m_KStarsData->skyComposite()->setCurrentCulture(  m_KStarsData->skyComposite()->getCultureName( (int)Options::skyCulture() ) );
     m_KStarsData->skyComposite()->reloadCLines();
@@ -177,6 +177,7 @@ bool KStarsData::initialize() {
     //Initialize SkyMapComposite//
     emit progressText(i18n("Loading sky objects" ) );
     m_SkyComposite = new SkyMapComposite(0);
+    connect( m_SkyComposite, &SkyMapComposite::solarSystemUpdated, this, [this]() { emit skyUpdate( false ); } );
     //Load Image URLs//
     //#ifndef Q_OS_ANDROID
     //On Android these 2 calls produce segfault. WARNING
@@ -243,8 +244,15 @@ void KStarsData::updateTime( GeoLocation *geo, const bool automaticDSTchange ) {
     }
 
     if ( fabs( ut().djd() - LastPlanetUpdate.djd() ) > 0.01 ) {
-        LastPlanetUpdate = ut().djd();
-        skyComposite()->updateSolarSystemBodies( &num );
+        // While the clock runs, the planets keep their positions until the next ones are computed
+        // in the background, or are tried again next time. A new time is shown with them at once.
+        if ( Options::computeSolarSystemInBackground() && clock()->isActive() && LastPlanetUpdate.isValid() ) {
+            if ( skyComposite()->updateSolarSystemBodiesInBackground( num ) )
+                LastPlanetUpdate = ut().djd();
+        } else {
+            LastPlanetUpdate = ut().djd();
+            skyComposite()->updateSolarSystemBodies( &num );
+        }
     }
 
     // Moon moves ~30 arcmin/hr, so update its position every minute.
@@ -255,13 +263,19 @@ void KStarsData::updateTime( GeoLocation *geo, const bool automaticDSTchange ) {
 
     //Update Alt/Az coordinates.  Timescale varies with zoom level
     //If Clock is in Manual Mode, always update. (?)
-    if ( fabs( ut().djd() - LastSkyUpdate.djd() ) > 0.1/Options::zoomFactor() || clock()->isManualMode() ) {
+    updateSky( clock()->isManualMode() );
+}
+
+bool KStarsData::updateSky( bool force ) {
+    if ( fabs( ut().djd() - LastSkyUpdate.djd() ) > 0.1/Options::zoomFactor() || force ) {
         LastSkyUpdate = ut();
         m_preUpdateID++;
         skyComposite()->update(); //omit KSNumbers arg == just update Alt/Az coords // <-- Eh? -- asimha. Looks like this behavior / ideology has changed drastically.
 
         emit skyUpdate( clock()->isManualMode() );
+        return true;
     }
+    return false;
 }
 
 void KStarsData::syncUpdateIDs()
@@ -361,6 +375,9 @@ void KStarsData::setLocation( const GeoLocation &l ) {
             Options::setDST(key);
     }
 
+    // The horizontal coordinates of the stars depend on the location
+    m_preUpdateID++;
+
     emit geoChanged();
 }
 
@@ -237,9 +237,16 @@ public:
 
     Execute* executeSession();
     #endif
-    /*@short Increments the updateID, forcing a recomputation of star positions as well */
+    /*@short Increments the updateID and the updateNumID, forcing a recomputation of star positions as well.
+     * The sky map only needs it when the way the coordinates are computed changed, see SkyMap::forceCoordinateUpdate() */
     unsigned int incUpdateID();
 
+    /*@short Update the Alt/Az coordinates if the time moved more than the zoom factor allows since they were
+     * last updated, which updateTime() checks too. Zooming in makes that threshold smaller, see SkyMap::setZoomFactor()
+     * @param force update them anyway
+     * @return true if they were updated */
+    bool updateSky( bool force = false );
+
     unsigned int updateID()    const { return m_updateID; }
     unsigned int updateNumID() const { return m_updateNumID; }
     KSNumbers* updateNum()     { return &m_updateNum; }
@@ -46,6 +46,8 @@
 #include "Options.h"
 #include "imageexporter.h"
 #include "skycomponents/constellationboundarylines.h"
+#include "skycomponents/skylabeler.h"
+#include "auxiliary/frameprofiler.h"
 #include "observinglist.h"
 #include "eyepiecefield.h"
 
@@ -686,6 +688,16 @@ void KStars::setApproxFOV( double FOV_Degrees ) {
 QString KStars::getSkyMapDimensions() {
     return ( QString::number( map()->width() ) + 'x' + QString::number( map()->height() ) );
 }
+
+void KStars::setFrameProfiling( bool enable ) {
+    FrameProfiler::Instance()->setEnabled( enable );
+    map()->forceUpdate();
+}
+
+QString KStars::getFrameProfile() {
+    return FrameProfiler::Instance()->report() + '\n' + SkyLabeler::Instance()->frameReport();
+}
+
 void KStars::printImage( bool usePrintDialog, bool useChartColors ) {
     //QPRINTER_FOR_NOW
 //    KPrinter printer( true, QPrinter::HighResolution );
@@ -46,6 +46,7 @@
 #include "oal/equipmentwriter.h"
 #include "oal/observeradd.h"
 #include "skycomponents/skymapcomposite.h"
+#include "skycomponents/componentloader.h"
 #include "texturemanager.h"
 #include "kspaths.h"
 
@@ -650,7 +651,7 @@ void KStars::datainitFinished() {
     connect( data()->clock(), SIGNAL( scaleChanged( float ) ),
              map(), SLOT( slotClockSlewing() ) );
 
-    connect( data(),   SIGNAL(skyUpdate(bool)),            map(),  SLOT( forceUpdateNow() ) );
+    connect( data(),   SIGNAL(skyUpdate(bool)),            map(),  SLOT( forceTimeUpdateNow() ) );
     connect( m_TimeStepBox, SIGNAL( scaleChanged(float) ), data(), SLOT( setTimeDirection( float ) ) );
     connect( m_TimeStepBox, SIGNAL( scaleChanged(float) ), data()->clock(), SLOT( setClockScale( float )) );
     connect( m_TimeStepBox, SIGNAL( scaleChanged(float) ), map(),  SLOT( setFocus() ) );
@@ -708,6 +709,13 @@ void KStars::initFocus() {
             map()->setFocusObject( oFocus );
             map()->setClickedObject( oFocus );
             map()->setFocusPoint( oFocus );
+        } else if ( Options::focusObject() != i18n("star") && ! data()->skyComposite()->loader()->isFinished() ) {
+            // The object may belong to a component which is still loading,
+            // start from its last position and center on it once loaded
+            SkyPoint pFocus( Options::focusRA(), Options::focusDec() );
+            pFocus.EquatorialToHorizontal( data()->lst(), data()->geo()->lat() );
+            map()->setFocusPoint( &pFocus );
+            connect( data()->skyComposite(), SIGNAL( objectNamesChanged() ), this, SLOT( slotResolveFocusObject() ), Qt::UniqueConnection );
         } else {
             qWarning() << "Cannot center on "
                        << Options::focusObject()
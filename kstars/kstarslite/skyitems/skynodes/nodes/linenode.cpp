@@ -74,31 +74,29 @@ void LineNode::updateGeometry() {
 
     const Projector *m_proj = SkyMapLite::Instance()->projector();
 
-    bool isVisible, isVisibleLast;
+    QVector<Vector2f> screen( points->size() );
+    QVector<bool> visible( points->size() );
+    m_proj->toScreenBatch( *points, true, screen.data(), visible.data() );
 
-    QPointF oLast = m_proj->toScreen( points->first(), true, &isVisibleLast );
     // & with the result of checkVisibility to clip away things below horizon
-    isVisibleLast &= m_proj->checkVisibility( points->first() );
-    QPointF oThis;
+    bool isVisibleLast = visible[0] && m_proj->checkVisibility( points->first() );
+    QPointF oLast = KSUtils::vecToPoint( screen[0] );
+
+    //Temporary solution to avoid random lines in Gnomonic projection and draw lines up to horizon
+    bool gnomonic = ( m_proj->type() == Projector::Gnomonic );
 
     QLinkedList<QPointF> newPoints;
 
     for ( int j = 1 ; j < points->size() ; j++ ) {
-        SkyPoint* pThis = points->at( j );
-        /*In regular KStars we first call checkVisibility and then toScreen
-        Here we minimize the number of calls to toScreen by proceeding only if
-        checkVisibility is true*/
-            oThis = m_proj->toScreen( pThis, true, &isVisible );
-            // & with the result of checkVisibility to clip away things below horizon
-            isVisible &= m_proj->checkVisibility(pThis);
+            QPointF oThis = KSUtils::vecToPoint( screen[j] );
+            bool isVisible = visible[j] && m_proj->checkVisibility( points->at( j ) );
             bool doSkip = false;
             if( m_skipList ) {
                 doSkip = m_skipList->skip(j);
             }
 
             bool pointsVisible = false;
-            //Temporary solution to avoid random lines in Gnomonic projection and draw lines up to horizon
-            if(SkyMapLite::Instance()->projector()->type() == Projector::Gnomonic) {
+            if( gnomonic ) {
                 if ( isVisible && isVisibleLast ) pointsVisible = true;
             } else {
                 if ( isVisible || isVisibleLast ) pointsVisible = true;
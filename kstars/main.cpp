@@ -42,6 +42,7 @@
 #include "kspaths.h"
 
 #include "kstarsdata.h"
+#include "skycomponents/skymapcomposite.h"
 #include "ksutils.h"
 #include "kstarsdatetime.h"
 #include "simclock.h"
@@ -169,6 +170,8 @@ int main(int argc, char *argv[])
         KStarsData *dat = KStarsData::Create();
         QObject::connect( dat, SIGNAL( progressText(QString) ), dat, SLOT( slotConsoleMessage(QString) ) );
         dat->initialize();
+        // There is no event loop to finish loading the components
+        dat->skyComposite()->waitForLoading();
 
         //Set Geographic Location
         dat->setLocationFromOptions();
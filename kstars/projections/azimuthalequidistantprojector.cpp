@@ -50,3 +50,8 @@ double AzimuthalEquidistantProjector::projectionL(double x) const
     return x;
 }
 
+void AzimuthalEquidistantProjector::projectBatch(int n, const double* x, const double* y, Vector2f* screen, bool* visible) const
+{
+    projectAzimuthalBatch( n, x, y, screen, visible, [this]( double c ) { return AzimuthalEquidistantProjector::projectionK( c ); } );
+}
+
@@ -69,6 +69,29 @@ Vector2f EquirectangularProjector::toScreenVec(const SkyPoint* o, bool oRefract,
     return p;
 }
 
+void EquirectangularProjector::projectBatch(int n, const double* x, const double* y, Vector2f* screen, bool* visible) const
+{
+    double x0, y0, sign;
+    if ( m_vp.useAltAz ) {
+        x0 = m_vp.focus->az().radians();
+        y0 = m_vp.focus->alt().radians();
+        sign = -1.0;
+    } else {
+        x0 = m_vp.focus->ra().radians();
+        y0 = m_vp.focus->dec().radians();
+        sign = 1.0;
+    }
+
+    for ( int i = 0; i < n; ++i ) {
+        double dX = KSUtils::reduceAngle( sign*( x[i] - x0 ), -dms::PI, dms::PI );
+        Vector2f p( 0.5*m_vp.width  - m_vp.zoomFactor*dX,
+                    0.5*m_vp.height - m_vp.zoomFactor*( y[i] - y0 ) );
+        screen[i] = p;
+        if ( visible )
+            visible[i] = ( p[0] > 0 && p[0] < m_vp.width );
+    }
+}
+
 SkyPoint EquirectangularProjector::fromScreen(const QPointF& p, dms* LST, const dms* lat) const
 {
     SkyPoint result;
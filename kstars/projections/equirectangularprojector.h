@@ -39,6 +39,7 @@ public:
     virtual SkyPoint fromScreen(const QPointF& p, dms* LST, const dms* lat) const;
     virtual QVector< Vector2f > groundPoly(SkyPoint* labelpoint = 0, bool* drawLabel = 0) const;
     virtual void updateClipPoly();
+    virtual void projectBatch(int n, const double* x, const double* y, Vector2f* screen, bool* visible) const;
 };
 
 #endif // EQUIRECTANGULARPROJECTOR_H
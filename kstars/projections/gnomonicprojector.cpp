@@ -45,6 +45,11 @@ double GnomonicProjector::projectionL(double x) const
     return atan(x);
 }
 
+void GnomonicProjector::projectBatch(int n, const double* x, const double* y, Vector2f* screen, bool* visible) const
+{
+    projectAzimuthalBatch( n, x, y, screen, visible, [this]( double c ) { return GnomonicProjector::projectionK( c ); } );
+}
+
 double GnomonicProjector::cosMaxFieldAngle() const
 {
     //Don't let things approach infty.
@@ -43,3 +43,8 @@ double LambertProjector::projectionL(double x) const
 {
     return 2.0*asin(0.5*x);
 }
+
+void LambertProjector::projectBatch(int n, const double* x, const double* y, Vector2f* screen, bool* visible) const
+{
+    projectAzimuthalBatch( n, x, y, screen, visible, [this]( double c ) { return LambertProjector::projectionK( c ); } );
+}
@@ -46,3 +46,8 @@ double OrthographicProjector::projectionL(double x) const
     return asin(x);
 }
 
+void OrthographicProjector::projectBatch(int n, const double* x, const double* y, Vector2f* screen, bool* visible) const
+{
+    projectAzimuthalBatch( n, x, y, screen, visible, [this]( double c ) { return OrthographicProjector::projectionK( c ); } );
+}
+
@@ -19,6 +19,7 @@
 
 #include "projector.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "ksutils.h"
@@ -46,7 +47,10 @@ SkyPoint Projector::pointAt(double az)
     return p;
 }
 
-Projector::Projector(const ViewParams& p)
+// Last identifier given to a view, by any projector
+static quint64 lastViewID = 0;
+
+Projector::Projector(const ViewParams& p) : m_viewID( 0 )
 {
     m_data = KStarsData::Instance();
     setViewParams(p);
@@ -63,6 +67,16 @@ void Projector::setViewParams(const ViewParams& p)
 {
     m_vp = p;
 
+    // The focus is often the same object with new coordinates, so compare them by value
+    const double viewKey[ ViewKeySize ] = { m_vp.width, m_vp.height, m_vp.zoomFactor,
+                                            double( m_vp.useRefraction ), double( m_vp.useAltAz ), double( m_vp.fillGround ),
+                                            m_vp.focus->ra().Degrees(), m_vp.focus->dec().Degrees(),
+                                            m_vp.focus->az().Degrees(), m_vp.focus->alt().Degrees() };
+    if ( m_viewID == 0 || !std::equal( viewKey, viewKey + ViewKeySize, m_viewKey ) ) {
+        std::copy( viewKey, viewKey + ViewKeySize, m_viewKey );
+        m_viewID = ++lastViewID;
+    }
+
     /** Precompute cached values */
     //Find Sin/Cos for focus point
     m_sinY0 = 0;
@@ -103,6 +117,54 @@ QPointF Projector::toScreen(const SkyPoint* o, bool oRefract, bool* onVisibleHem
     return KSUtils::vecToPoint( toScreenVec(o, oRefract, onVisibleHemisphere) );
 }
 
+// The converted coordinates are projected in chunks of this size on the stack
+static const int BatchChunk = 256;
+
+void Projector::toScreenBatch(int n, const double* x, const double* y, Vector2f* screen, bool* visible) const
+{
+    projectBatch( n, x, y, screen, visible );
+}
+
+void Projector::toScreenBatch(int n, const float* x, const float* y, Vector2f* screen, bool* visible) const
+{
+    double dx[ BatchChunk ], dy[ BatchChunk ];
+    for ( int start = 0; start < n; start += BatchChunk ) {
+        int count = qMin( BatchChunk, n - start );
+        for ( int i = 0; i < count; ++i ) {
+            dx[i] = x[ start + i ];
+            dy[i] = y[ start + i ];
+        }
+        projectBatch( count, dx, dy, screen + start, visible ? visible + start : 0 );
+    }
+}
+
+void Projector::toScreenBatch(const QVector<SkyPoint*>& points, bool oRefract, Vector2f* screen, bool* visible) const
+{
+    double x[ BatchChunk ], y[ BatchChunk ];
+    const int n = points.size();
+
+    oRefract &= m_vp.useRefraction;
+    for ( int start = 0; start < n; start += BatchChunk ) {
+        int count = qMin( BatchChunk, n - start );
+        for ( int i = 0; i < count; ++i ) {
+            const SkyPoint *o = points.at( start + i );
+            if ( m_vp.useAltAz ) {
+                x[i] = o->az().radians();
+                y[i] = oRefract ? SkyPoint::refract( o->alt() ).radians() : o->alt().radians();
+            } else {
+                x[i] = o->ra().radians();
+                y[i] = o->dec().radians();
+            }
+        }
+        projectBatch( count, x, y, screen + start, visible ? visible + start : 0 );
+    }
+}
+
+void Projector::projectBatch(int n, const double* x, const double* y, Vector2f* screen, bool* visible) const
+{
+    projectAzimuthalBatch( n, x, y, screen, visible, [this]( double c ) { return projectionK( c ); } );
+}
+
 bool Projector::onScreen(const QPointF& p) const
 {
     return (0 <= p.x() && p.x() <= m_vp.width &&
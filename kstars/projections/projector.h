@@ -28,6 +28,7 @@ using namespace Eigen;
 
 #include <QPointF>
 
+#include "ksutils.h"
 #include "skyobjects/skypoint.h"
 #ifdef KSTARS_LITE
 #include "skymaplite.h"
@@ -83,6 +84,15 @@ public:
     /** Return the FOV of this projection */
     double fov() const;
 
+    /** Return the view parameters of this projection */
+    inline const ViewParams& viewParams() const { return m_vp; }
+
+    /** Return an identifier of the view. It changes whenever the view parameters,
+        *including the coordinates of the focus, change, and it is never shared by two
+        *projectors. Screen positions computed for a view can be reused while it is unchanged.
+        */
+    inline quint64 viewID() const { return m_viewID; }
+
     /** Check if the current point on screen is a valid point on the sky. This is needed
         *to avoid a crash of the program if the user clicks on a point outside the sky (the
         *corners of the sky map at the lowest zoom level are the invalid points).
@@ -125,6 +135,40 @@ public:
                       bool oRefract = true,
                       bool* onVisibleHemisphere = 0) const;
 
+    /** @short Project a batch of points at once.
+     *
+     * This computes the same positions as toScreenVec(), but the projection is
+     * resolved once for the whole batch instead of once per point, and the loop only
+     * reads the coordinates from two flat arrays, which the compiler can vectorize.
+     * Use it for lists of many points, e.g. lines or stars.
+     *
+     * @param n the number of points
+     * @param x the azimuths if the view uses horizontal coordinates, the right
+     *   ascensions otherwise, in radians
+     * @param y the altitudes or declinations, in radians. Refraction is not applied,
+     *   the altitudes must already be refracted if needed.
+     * @param screen array of @p n screen positions filled with the result
+     * @param visible array of @p n flags telling whether each point is on the visible
+     *   part of the Celestial Sphere, may be null. Points with invalid coordinates are
+     *   not visible.
+     */
+    void toScreenBatch( int n, const double *x, const double *y,
+                        Vector2f *screen, bool *visible = 0 ) const;
+
+    /** Same as above, for coordinates stored in single precision.
+      */
+    void toScreenBatch( int n, const float *x, const float *y,
+                        Vector2f *screen, bool *visible = 0 ) const;
+
+    /** Same as above, taking the coordinates from SkyPoints.
+     * @param points the points to project
+     * @param oRefract true = use Options::useRefraction() value, see toScreenVec()
+     * @param screen array of points.size() screen positions filled with the result
+     * @param visible array of points.size() visibility flags, may be null
+     */
+    void toScreenBatch( const QVector<SkyPoint*> &points, bool oRefract,
+                        Vector2f *screen, bool *visible = 0 ) const;
+
     /** @short Determine RA, Dec coordinates of the pixel at (dx, dy), which are the
      * screen pixel coordinate offsets from the center of the Sky pixmap.
      * @param the screen pixel position to convert
@@ -255,6 +299,22 @@ protected:
         */
     virtual double cosMaxFieldAngle() const { return 0; }
 
+    /** Project a batch of points, see toScreenBatch(). The default implementation
+        calls projectAzimuthalBatch() with the virtual projectionK(), projections
+        should reimplement it to call projectAzimuthalBatch() with their own
+        projectionK() so that it is inlined.
+        */
+    virtual void projectBatch( int n, const double *x, const double *y,
+                               Vector2f *screen, bool *visible ) const;
+
+    /** The loop of projectBatch() for the azimuthal projections, i.e. toScreenVec()
+        with @p k as projectionK() and everything which only depends on the view
+        hoisted out of the loop.
+        */
+    template <typename ProjectionK>
+    void projectAzimuthalBatch( int n, const double *x, const double *y,
+                                Vector2f *screen, bool *visible, ProjectionK k ) const;
+
     /** Helper function for drawing ground.
         @return the point with Alt = 0, az = @p az
         */
@@ -271,6 +331,46 @@ private:
     //Used by CheckVisibility
     double m_xrange;
     bool m_isPoleVisible;
+
+    //Used by viewID()
+    static const int ViewKeySize = 10;
+    double m_viewKey[ ViewKeySize ];
+    quint64 m_viewID;
 };
 
+template <typename ProjectionK>
+void Projector::projectAzimuthalBatch( int n, const double *x, const double *y,
+                                       Vector2f *screen, bool *visible, ProjectionK k ) const
+{
+    // The azimuth grows in the opposite direction of the right ascension on the screen
+    const double sign = m_vp.useAltAz ? -1.0 : 1.0;
+    const double x0 = m_vp.useAltAz ? m_vp.focus->az().radians() : m_vp.focus->ra().radians();
+    const double cosMax = cosMaxFieldAngle();
+    const double cx = 0.5*m_vp.width, cy = 0.5*m_vp.height;
+    const double zoom = m_vp.zoomFactor;
+    const double sinY0 = m_sinY0, cosY0 = m_cosY0;
+
+    for ( int i = 0; i < n; ++i ) {
+        double Y = y[i];
+        double dX = sign*( x[i] - x0 );
+        if ( !( std::isfinite( Y ) && std::isfinite( dX ) ) ) {
+            screen[i] = Vector2f( 0, 0 );
+            if ( visible )
+                visible[i] = false;
+            continue;
+        }
+        dX = KSUtils::reduceAngle( dX, -dms::PI, dms::PI );
+
+        double sindX = std::sin( dX ), cosdX = std::cos( dX );
+        double sinY  = std::sin( Y ),  cosY  = std::cos( Y );
+        double c = sinY0*sinY + cosY0*cosY*cosdX;
+        if ( visible )
+            visible[i] = ( c > cosMax );
+
+        double zk = zoom*k( c );
+        screen[i] = Vector2f( cx - zk*cosY*sindX,
+                              cy - zk*( cosY0*sinY - sinY0*cosY*cosdX ) );
+    }
+}
+
 #endif // PROJECTOR_H
@@ -44,3 +44,8 @@ double StereographicProjector::projectionL(double x) const
 {
     return 2.0*atan2( x, 2.0 );
 }
+
+void StereographicProjector::projectBatch(int n, const double* x, const double* y, Vector2f* screen, bool* visible) const
+{
+    projectAzimuthalBatch( n, x, y, screen, visible, [this]( double c ) { return StereographicProjector::projectionK( c ); } );
+}
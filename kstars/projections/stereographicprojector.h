@@ -37,6 +37,7 @@ public:
     virtual double radius() const;
     virtual double projectionK(double x) const;
     virtual double projectionL(double x) const;
+    virtual void projectBatch(int n, const double* x, const double* y, Vector2f* screen, bool* visible) const;
 };
 
 #endif // STEREOGRAPHICPROJECTOR_H
@@ -20,12 +20,14 @@
 #include <QStandardPaths>
 #include <QHttpMultiPart>
 #include <QPen>
+#include <QSharedPointer>
 
 #include <KLocalizedString>
 
 #include "asteroidscomponent.h"
 
 #include "auxiliary/filedownloader.h"
+#include "componentloader.h"
 #include "projections/projector.h"
 #include "solarsystemcomposite.h"
 #include "skycomponent.h"
@@ -44,7 +46,10 @@
 
 AsteroidsComponent::AsteroidsComponent(SolarSystemComposite *parent) : SolarSystemListComponent(parent)
 {
-    loadData();
+    QSharedPointer< QList<SkyObject*> > asteroids( new QList<SkyObject*> );
+    loader()->addTask( "asteroids", QStringList(),
+                       [this, asteroids]() { *asteroids = readData(); },
+                       [this, asteroids]() { commitData( *asteroids ); } );
 }
 
 AsteroidsComponent::~AsteroidsComponent()
@@ -83,7 +88,7 @@ bool AsteroidsComponent::selected() {
  * @li 22 earth minimum orbit intersection distance [double]
  * @li 23 orbit classification [string]
  */
-void AsteroidsComponent::loadData()
+QList<SkyObject*> AsteroidsComponent::readData()
 {
     QString name, full_name, orbit_id, orbit_class, dimensions;
     int mJD;
@@ -91,14 +96,10 @@ void AsteroidsComponent::loadData()
     long double JD;
     float diameter, albedo, rot_period, period;
     bool neo;    
+    QList<SkyObject*> asteroids;
 
     emitProgressText( i18n("Loading asteroids") );
 
-    // Clear lists
-    m_ObjectList.clear();
-    objectNames( SkyObject::ASTEROID ).clear();
-    objectLists( SkyObject::ASTEROID ).clear();
-
     QList< QPair<QString, KSParser::DataTypes> > sequence;
     sequence.append(qMakePair(QString("full name"), KSParser::D_QSTRING));
     sequence.append(qMakePair(QString("epoch_mjd"), KSParser::D_INT));
@@ -187,11 +188,32 @@ void AsteroidsComponent::loadData()
         new_asteroid->setPhysicalSize(diameter);
         //new_asteroid->setAngularSize(0.005);
 
-        m_ObjectList.append(new_asteroid);
+        asteroids.append(new_asteroid);
+    }
+    return asteroids;
+}
+
+void AsteroidsComponent::commitData( const QList<SkyObject*> &asteroids )
+{
+    // Clear lists
+    m_ObjectList.clear();
+    objectNames( SkyObject::ASTEROID ).clear();
+    objectLists( SkyObject::ASTEROID ).clear();
+
+    foreach ( SkyObject *asteroid, asteroids ) {
+        m_ObjectList.append(asteroid);
         // Add name to the list of object names
-        objectNames(SkyObject::ASTEROID).append(name);
-        objectLists( SkyObject::ASTEROID ).append(QPair<QString, const SkyObject*>(name,new_asteroid));
+        objectNames(SkyObject::ASTEROID).append(asteroid->name());
+        objectLists( SkyObject::ASTEROID ).append(QPair<QString, const SkyObject*>(asteroid->name(),asteroid));
     }
+    emitObjectNamesChanged();
+}
+
+void AsteroidsComponent::loadData()
+{
+    // The data loaded at startup must not replace the new one
+    loader()->waitFor( "asteroids" );
+    commitData( readData() );
 }
 
 
@@ -55,6 +55,10 @@ protected slots:
     void downloadError(const QString &errorString);
 
 private:
+    /** @short Read the asteroids from asteroids.dat, from any thread */
+    QList<SkyObject*> readData();
+    /** @short Replace the asteroids, and their names in the lists of object names */
+    void commitData( const QList<SkyObject*> &asteroids );
     void loadData();
     FileDownloader* downloadJob;
 };
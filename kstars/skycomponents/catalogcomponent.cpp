@@ -27,8 +27,13 @@
 #include <QDir>
 #include <QFile>
 #include <QPixmap>
+#include <QSet>
+#include <QSharedPointer>
 #include <QTextStream>
 
+#include <algorithm>
+#include <cmath>
+
 #include "Options.h"
 
 #include "kstarsdata.h"
@@ -39,6 +44,7 @@
 #include "skyobjects/starobject.h"
 #include "skyobjects/deepskyobject.h"
 #include "catalogdb.h"
+#include "componentloader.h"
 
 
 QStringList CatalogComponent::m_Columns
@@ -84,13 +90,62 @@ void CatalogComponent::_loadData( bool includeCatalogDesignation ) {
     else
         emitProgressText( i18n("Loading internal catalog: %1", m_catName ) );
 
+    QList<SkyObject*> objects;
     QList < QPair <int, QString> > names;
 
     KStarsData::Instance()->catalogdb()->GetAllObjects(m_catName,
-                                                       m_ObjectList,
+                                                       objects,
                                                        names,
                                                        this,
                                                        includeCatalogDesignation);
+    appendObjects( objects, names );
+    loadCatalogData();
+}
+
+void CatalogComponent::loadDataInBackground() {
+    emitProgressText( i18n("Loading custom catalog: %1", m_catName ) );
+    loadCatalogData();
+
+    CatalogDB *db = KStarsData::Instance()->catalogdb();
+    int catid = db->FindCatalog( m_catName );
+    if ( catid < 0 )
+        return;
+
+    // Bands of 15 degrees, the nearest to the declination of the focus first
+    const int nbands = 12;
+    const double focusDec = Options::focusDec();
+    QList<int> bands;
+    for ( int i = 0; i < nbands; ++i )
+        bands.append( i );
+    std::sort( bands.begin(), bands.end(), [focusDec]( int a, int b ) {
+        return fabs( -82.5 + 15.0 * a - focusDec ) < fabs( -82.5 + 15.0 * b - focusDec );
+    } );
+
+    foreach ( int band, bands ) {
+        double decMin = -90.0 + 15.0 * band;
+        // The last band includes the pole
+        double decMax = ( band == nbands - 1 ) ? 91.0 : decMin + 15.0;
+        QSharedPointer< QList<SkyObject*> > objects( new QList<SkyObject*>() );
+        QSharedPointer< QList< QPair<int, QString> > > names( new QList< QPair<int, QString> >() );
+        loader()->addTask( QString( "catalog %1 band %2" ).arg( m_catName ).arg( band ), QStringList(),
+                           [this, db, catid, decMin, decMax, objects, names]() {
+                               db->GetObjectsInDecRange( catid, decMin, decMax, *objects, *names, this, true );
+                           },
+                           [this, objects, names]() { appendObjects( *objects, *names ); } );
+    }
+}
+
+void CatalogComponent::loadCatalogData() {
+    CatalogData loaded_catalog_data;
+    KStarsData::Instance()->catalogdb()->GetCatalogData(m_catName, loaded_catalog_data);
+    m_catPrefix = loaded_catalog_data.prefix;
+    m_catColor = loaded_catalog_data.color;
+    m_catFluxFreq = loaded_catalog_data.fluxfreq;
+    m_catFluxUnit = loaded_catalog_data.fluxunit;
+    m_catEpoch = loaded_catalog_data.epoch;
+}
+
+void CatalogComponent::appendObjects( const QList<SkyObject*> &objects, const QList< QPair<int, QString> > &names ) {
     for (int iter = 0; iter < names.size(); ++iter) {
         if (names.at(iter).first <= SkyObject::TYPE_UNKNOWN) {
             //FIXME JM 2016-06-02: inefficient and costly check
@@ -116,20 +171,25 @@ void CatalogComponent::_loadData( bool includeCatalogDesignation ) {
         }
     }
 
+    // The names already in objectLists, by type, to skip the duplicates
+    QHash<int, QSet<QString> > listedNames;
+
     //FIXME - get rid of objectNames completely. For now only KStars Lite uses objectLists
-    for(int iter = 0; iter < m_ObjectList.size(); ++iter) {
-        SkyObject *obj = m_ObjectList[iter];
+    foreach ( SkyObject *obj, objects ) {
         Q_ASSERT( obj );
+        m_ObjectList.append( obj );
         if(obj->type() <= SkyObject::TYPE_UNKNOWN) {
-            QVector<QPair<QString, const SkyObject *>>&objects = objectLists(obj->type());
-            bool dupName = false;
-            bool dupLongname = false;
+            QVector<QPair<QString, const SkyObject *>>&list = objectLists(obj->type());
+            if( ! listedNames.contains( obj->type() ) ) {
+                QSet<QString> &listed = listedNames[ obj->type() ];
+                for(int i = 0; i < list.size(); ++i)
+                    listed.insert( list.at(i).first );
+            }
+            QSet<QString> &listed = listedNames[ obj->type() ];
 
             QString name = obj->name();
             QString longname = obj->longname();
 
-            //FIXME - find a better way to check for duplicates
-
             // FIXME: AS: There is an argument for why we may not want
             // to remove duplicates -- when the object is removed, all
             // names seem to be removed, so if there are two objects
@@ -138,34 +198,21 @@ void CatalogComponent::_loadData( bool includeCatalogDesignation ) {
             // miscellaneous catalog), then disabling one catalog
             // removes the name entirely from the list.
 
-            for(int i = 0; i < objects.size(); ++i) {
-                if(name == objects.at(i).first)
-                    dupName = true;
-                if(longname == objects.at(i).first)
-                    dupLongname = true;
+            if( ! listed.contains( name ) ) {
+                list.append(QPair<QString, const SkyObject *>(name, obj));
+                listed.insert( name );
             }
 
-            if(!dupName) {
-                objectLists(obj->type()).append(QPair<QString, const SkyObject *>(name, obj));
-            }
-
-            if(!longname.isEmpty() && !dupLongname && name != longname) {
-                objectLists(obj->type()).append(QPair<QString, const SkyObject *>(longname, obj));
+            if(!longname.isEmpty() && !listed.contains( longname ) && name != longname) {
+                list.append(QPair<QString, const SkyObject *>(longname, obj));
+                listed.insert( longname );
             }
         }
     }
 
-    // Remove Duplicates (see FIXME by AS above)
-    foreach(QStringList list, objectNames())
-        list.removeDuplicates();
-
-    CatalogData loaded_catalog_data;
-    KStarsData::Instance()->catalogdb()->GetCatalogData(m_catName, loaded_catalog_data);
-    m_catPrefix = loaded_catalog_data.prefix;
-    m_catColor = loaded_catalog_data.color;
-    m_catFluxFreq = loaded_catalog_data.fluxfreq;
-    m_catFluxUnit = loaded_catalog_data.fluxunit;
-    m_catEpoch = loaded_catalog_data.epoch;
+    // The sky is updated once all the bands are loaded, until then draw()
+    // has to bring the new objects to the current time and position
+    updateID = 0;
 }
 
 void CatalogComponent::update( KSNumbers * ) {
@@ -91,6 +91,14 @@ public:
      **/
     virtual bool selected();
 
+    /**
+     * @short Load the objects of the catalog in the background, by bands
+     * of declination starting from the band of the focus, so that large
+     * catalogs show up progressively.
+     * @note The component must have been constructed without loading its data
+     */
+    void loadDataInBackground();
+
 protected:
 
     /** @short Load data into custom catalog */
@@ -108,6 +116,13 @@ protected:
     quint32 updateID;
 
     static QStringList m_Columns;
+
+private:
+    /** @short Read the prefix, color, flux and epoch of the catalog */
+    void loadCatalogData();
+
+    /** @short Take over objects read from the database, and add their names to the lists */
+    void appendObjects( const QList<SkyObject*> &objects, const QList< QPair<int, QString> > &names );
 };
 
 #endif
@@ -21,9 +21,11 @@
 #include <QFile>
 #include <QPen>
 #include <QHttpMultiPart>
+#include <QSharedPointer>
 
 #include "cometscomponent.h"
 #include "solarsystemcomposite.h"
+#include "componentloader.h"
 
 #include "Options.h"
 #include "skyobjects/kscomet.h"
@@ -44,7 +46,10 @@
 
 CometsComponent::CometsComponent( SolarSystemComposite *parent )
         : SolarSystemListComponent( parent ) {
-    loadData();
+    QSharedPointer< QList<SkyObject*> > comets( new QList<SkyObject*> );
+    loader()->addTask( "comets", QStringList(),
+                       [this, comets]() { *comets = readData(); },
+                       [this, comets]() { commitData( *comets ); } );
 }
 
 CometsComponent::~CometsComponent()
@@ -83,17 +88,16 @@ bool CometsComponent::selected() {
  * @li 21 comet nuclear magnitude slope parameter
  * @note See KSComet constructor for more details.
  */
-void CometsComponent::loadData() {
+QList<SkyObject*> CometsComponent::readData() {
     QString name, orbit_id, orbit_class, dimensions;
     bool neo;
     int mJD;
     double q, e, dble_i, dble_w, dble_N, Tp, earth_moid;
     long double JD;
     float M1, M2, K1, K2, diameter, albedo, rot_period, period;
+    QList<SkyObject*> comets;
 
     emitProgressText(i18n("Loading comets"));
-    objectNames(SkyObject::COMET).clear();
-    objectLists(SkyObject::COMET).clear();
 
     QList< QPair<QString, KSParser::DataTypes> > sequence;
     sequence.append(qMakePair(QString("full name"), KSParser::D_QSTRING));
@@ -173,12 +177,30 @@ void CometsComponent::loadData() {
         com->setEarthMOID( earth_moid );
         com->setOrbitClass( orbit_class );
         com->setAngularSize( 0.005 );
+        comets.append( com );
+    }
+    return comets;
+}
+
+void CometsComponent::commitData( const QList<SkyObject*> &comets ) {
+    m_ObjectList.clear();
+    objectNames(SkyObject::COMET).clear();
+    objectLists(SkyObject::COMET).clear();
+
+    foreach ( SkyObject *com, comets ) {
         m_ObjectList.append( com );
 
         // Add *short* name to the list of object names
         objectNames( SkyObject::COMET ).append( com->name() );
         objectLists( SkyObject::COMET ).append(QPair<QString, const SkyObject*>(com->name(),com));
     }
+    emitObjectNamesChanged();
+}
+
+void CometsComponent::loadData() {
+    // The data loaded at startup must not replace the new one
+    loader()->waitFor( "comets" );
+    commitData( readData() );
 }
 
 void CometsComponent::draw( SkyPainter *skyp )
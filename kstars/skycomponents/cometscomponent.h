@@ -52,6 +52,10 @@ protected slots:
     void downloadError(const QString &errorString);
 
 private:
+    /** @short Read the comets from comets.dat, from any thread */
+    QList<SkyObject*> readData();
+    /** @short Replace the comets, and their names in the lists of object names */
+    void commitData( const QList<SkyObject*> &comets );
     void loadData();
     FileDownloader* downloadJob;
 };
@@ -0,0 +1,225 @@
+/***************************************************************************
+                   componentloader.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat Apr 15 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "componentloader.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QtConcurrent>
+
+ComponentLoader::ComponentLoader( QObject *parent ) :
+    QObject( parent ), m_Started( false ), m_Finishing( false )
+{
+}
+
+ComponentLoader::~ComponentLoader()
+{
+    waitForAll();
+    // The load steps may still be returning from runLoad()
+    foreach ( QFuture<void> load, m_Loads )
+        load.waitForFinished();
+}
+
+void ComponentLoader::addTask( const QString &name, const QStringList &dependencies, const Step &load, const Step &finish )
+{
+    Task task = { name, dependencies, load, finish, Waiting };
+
+    // From a finish step, the task to replace cannot be waited for: it may
+    // be loading, or be the one being finished. It is replaced once finished.
+    if ( m_Finishing && ! isFinished( name ) ) {
+        QMutexLocker locker( &m_Mutex );
+        m_Replacements.insert( name, task );
+        return;
+    }
+
+    if ( ! isFinished( name ) )
+        waitFor( name );
+
+    QMutexLocker locker( &m_Mutex );
+    int index = indexOf( name );
+    if ( index >= 0 )
+        m_Tasks[index] = task;
+    else
+        m_Tasks.append( task );
+    launchReady();
+}
+
+void ComponentLoader::start()
+{
+    QMutexLocker locker( &m_Mutex );
+    m_Started = true;
+    if ( ! m_Loaded.isEmpty() )
+        QMetaObject::invokeMethod( this, "finishLoaded", Qt::QueuedConnection );
+}
+
+bool ComponentLoader::isFinished( const QString &name ) const
+{
+    QMutexLocker locker( &m_Mutex );
+    int index = indexOf( name );
+    return index < 0 || m_Tasks[index].state == Finished;
+}
+
+bool ComponentLoader::isFinished() const
+{
+    QMutexLocker locker( &m_Mutex );
+    return isIdle();
+}
+
+void ComponentLoader::waitFor( const QString &name )
+{
+    // Called back from a finish step, the task may be the one being finished
+    Q_ASSERT_X( ! m_Finishing, "ComponentLoader::waitFor", "called from a finish step" );
+    if ( m_Finishing ) {
+        qWarning() << "Cannot wait for" << name << "while finishing a task, it may not be finished yet";
+        return;
+    }
+
+    QMutexLocker locker( &m_Mutex );
+    int index = indexOf( name );
+    while ( index >= 0 && m_Tasks[index].state != Finished ) {
+        if ( ! finishNext( locker ) )
+            m_LoadedCondition.wait( &m_Mutex );
+    }
+}
+
+void ComponentLoader::waitForAll()
+{
+    Q_ASSERT_X( ! m_Finishing, "ComponentLoader::waitForAll", "called from a finish step" );
+    if ( m_Finishing ) {
+        qWarning() << "Cannot wait for the tasks while finishing a task, some may not be finished yet";
+        return;
+    }
+
+    QMutexLocker locker( &m_Mutex );
+    for ( int i = 0; i < m_Tasks.size(); ++i ) {
+        while ( m_Tasks[i].state != Finished ) {
+            if ( ! finishNext( locker ) )
+                m_LoadedCondition.wait( &m_Mutex );
+        }
+    }
+}
+
+void ComponentLoader::finishLoaded()
+{
+    // The event loop may be entered from a finish step, e.g. to show the progress
+    if ( m_Finishing )
+        return;
+
+    QMutexLocker locker( &m_Mutex );
+    while ( finishNext( locker ) )
+        ;
+}
+
+int ComponentLoader::indexOf( const QString &name ) const
+{
+    for ( int i = 0; i < m_Tasks.size(); ++i ) {
+        if ( m_Tasks[i].name == name )
+            return i;
+    }
+    return -1;
+}
+
+bool ComponentLoader::isIdle() const
+{
+    foreach ( const Task &task, m_Tasks ) {
+        if ( task.state != Finished )
+            return false;
+    }
+    return true;
+}
+
+bool ComponentLoader::isReady( const Task &task ) const
+{
+    foreach ( const QString &dependency, task.dependencies ) {
+        int index = indexOf( dependency );
+        if ( index >= 0 && m_Tasks[index].state != Finished )
+            return false;
+    }
+    return true;
+}
+
+void ComponentLoader::launchReady()
+{
+    for ( int i = 0; i < m_Tasks.size(); ++i ) {
+        Task &task = m_Tasks[i];
+        if ( task.state != Waiting || ! isReady( task ) )
+            continue;
+
+        if ( task.load ) {
+            task.state = Loading;
+            // Forget the loads which returned, catalogs add many tasks
+            QMutableListIterator<QFuture<void> > it( m_Loads );
+            while ( it.hasNext() ) {
+                if ( it.next().isFinished() )
+                    it.remove();
+            }
+            m_Loads.append( QtConcurrent::run( this, &ComponentLoader::runLoad, i, task.load ) );
+        } else {
+            task.state = Loaded;
+            m_Loaded.enqueue( i );
+            if ( m_Started )
+                QMetaObject::invokeMethod( this, "finishLoaded", Qt::QueuedConnection );
+        }
+    }
+}
+
+bool ComponentLoader::finishNext( QMutexLocker &locker )
+{
+    if ( m_Loaded.isEmpty() )
+        return false;
+
+    int index = m_Loaded.dequeue();
+    QString name = m_Tasks[index].name;
+    Step finish = m_Tasks[index].finish;
+
+    locker.unlock();
+    if ( finish ) {
+        m_Finishing = true;
+        finish();
+        m_Finishing = false;
+    }
+    locker.relock();
+
+    Task &task = m_Tasks[index];
+    task.state = Finished;
+    // Release the data shared by the steps
+    task.load = Step();
+    task.finish = Step();
+    if ( m_Replacements.contains( name ) )
+        task = m_Replacements.take( name );
+    launchReady();
+    bool done = isIdle();
+
+    locker.unlock();
+    emit taskFinished( name );
+    if ( done )
+        emit idle();
+    locker.relock();
+    return true;
+}
+
+void ComponentLoader::runLoad( int index, Step load )
+{
+    load();
+
+    QMutexLocker locker( &m_Mutex );
+    m_Tasks[index].state = Loaded;
+    m_Loaded.enqueue( index );
+    m_LoadedCondition.wakeAll();
+    if ( m_Started )
+        QMetaObject::invokeMethod( this, "finishLoaded", Qt::QueuedConnection );
+}
@@ -0,0 +1,138 @@
+/***************************************************************************
+                   componentloader.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat Apr 15 2017
+    copyright            : (C) 2017 by The KStars Team
+    email                : kstars-devel@kde.org
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef COMPONENTLOADER_H
+#define COMPONENTLOADER_H
+
+#include <functional>
+
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QQueue>
+#include <QStringList>
+#include <QVector>
+#include <QWaitCondition>
+
+/**
+ * @class ComponentLoader
+ * @short Loads the data of the sky components in the background.
+ *
+ * A task has two steps. The load step runs on the global thread pool, it
+ * typically parses a data file into new objects and must not touch anything
+ * shared with the rest of KStars. The finish step runs on the main thread,
+ * where it hands these objects over to the component and to the lists of
+ * object names.
+ *
+ * A task is loaded as soon as the tasks it depends on are finished, so the
+ * independent tasks load concurrently. The finish steps wait for start(),
+ * then run from the event loop of the main thread, or at once from waitFor()
+ * when a result is needed. A task without load step only defers its finish
+ * step until after the first sky map is shown.
+ *
+ * The tasks are added, waited for and finished on the main thread only.
+ *
+ * @author The KStars Team
+ */
+class ComponentLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<void()> Step;
+
+    explicit ComponentLoader( QObject *parent = 0 );
+
+    /** @short Destructor. Finishes all the tasks first. */
+    virtual ~ComponentLoader();
+
+    /**
+     * @short Add a task, which starts loading when its dependencies are finished
+     * @param name the name of the task. If a task of that name is not finished
+     * yet, it is finished before being replaced. When called from a finish
+     * step, the replacement waits until that task is finished instead.
+     * @param dependencies the names of the tasks to finish before loading this
+     * one. Unknown names are ignored.
+     * @param load the step to run on the thread pool, may be empty
+     * @param finish the step to run on the main thread, may be empty
+     */
+    void addTask( const QString &name, const QStringList &dependencies, const Step &load, const Step &finish );
+
+    /** @short Let the loaded tasks finish from the event loop */
+    void start();
+
+    /** @return true if the task @p name is finished, or unknown */
+    bool isFinished( const QString &name ) const;
+
+    /** @return true if all the tasks are finished */
+    bool isFinished() const;
+
+    /**
+     * @short Finish the task @p name and its dependencies, blocking until they are loaded
+     * @note Must not be called from a finish step
+     */
+    void waitFor( const QString &name );
+
+    /**
+     * @short Finish all the tasks, blocking until they are loaded
+     * @note Must not be called from a finish step
+     */
+    void waitForAll();
+
+signals:
+    /** @short Emitted on the main thread after a task is finished */
+    void taskFinished( const QString &name );
+
+    /** @short Emitted on the main thread after the last task not yet finished is finished */
+    void idle();
+
+private slots:
+    void finishLoaded();
+
+private:
+    enum State { Waiting, Loading, Loaded, Finished };
+
+    struct Task {
+        QString name;
+        QStringList dependencies;
+        Step load;
+        Step finish;
+        State state;
+    };
+
+    // These need m_Mutex to be locked
+    int indexOf( const QString &name ) const;
+    bool isIdle() const;
+    bool isReady( const Task &task ) const;
+    void launchReady();
+    bool finishNext( QMutexLocker &locker );
+
+    void runLoad( int index, Step load );
+
+    QVector<Task> m_Tasks;
+    QQueue<int> m_Loaded;   // tasks to finish, in the order they were loaded
+    QHash<QString, Task> m_Replacements;    // tasks added from a finish step, until the task they replace is finished
+    QList<QFuture<void> > m_Loads;   // load steps which may still be running
+    bool m_Started;
+    bool m_Finishing;       // a finish step is running, only used on the main thread
+    mutable QMutex m_Mutex;
+    QWaitCondition m_LoadedCondition;
+};
+
+#endif
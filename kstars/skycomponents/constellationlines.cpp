@@ -155,6 +155,17 @@ void ConstellationLines::JITupdate( LineList* lineList )
     }
 }
 
+void ConstellationLines::updateStars()
+{
+    if ( ! selected() ) return;
+
+    UpdateID updateID = KStarsData::Instance()->updateID();
+    foreach( LineList *lineList, listList() ) {
+        if ( lineList->updateID != updateID )
+            JITupdate( lineList );
+    }
+}
+
 void ConstellationLines::reindex( KSNumbers *num )
 {
     if ( ! num ) return;
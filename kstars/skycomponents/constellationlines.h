@@ -50,6 +50,12 @@ public:
 
     void reindex( KSNumbers *num );
 
+    /** @short Update the stars at the nodes of the lines for the current
+     * draw cycle, if they are not up to date already.
+     * @see SkyMapComposite::prepareConcurrentDraw()
+     */
+    void updateStars();
+
     virtual bool selected();
 
 protected:
@@ -17,8 +17,9 @@
 #include "constellationnamescomponent.h"
 
 #include <QTextStream>
-#include <QtConcurrent>
+#include <QSharedPointer>
 
+#include "componentloader.h"
 #include "kstarsdata.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
@@ -34,26 +35,30 @@
 ConstellationNamesComponent::ConstellationNamesComponent(SkyComposite *parent, CultureList* cultures )
         : ListComponent( parent )
 {
-    QtConcurrent::run(this, &ConstellationNamesComponent::loadData, cultures);
+    localCNames = Options::useLocalConstellNames();
+
+    QSharedPointer< QList<SkyObject*> > names( new QList<SkyObject*> );
+    loader()->addTask( "constellation names", QStringList(),
+                       [this, names, cultures]() { *names = readData( cultures ); },
+                       [this, names]() { commitData( *names ); } );
 }
 
 ConstellationNamesComponent::~ConstellationNamesComponent()
 {}
 
-void ConstellationNamesComponent::loadData(CultureList* cultures)
+QList<SkyObject*> ConstellationNamesComponent::readData(CultureList* cultures)
 {
     uint i = 0;
     bool culture = false;
     KSFileReader fileReader;
     QString cultureName;
+    QList<SkyObject*> names;
 
     if ( ! fileReader.open( "cnames.dat" ) )
-        return;
+        return names;
 
     emitProgressText( i18n("Loading constellation names" ) );
 
-    localCNames = Options::useLocalConstellNames();
-
     while ( fileReader.hasMoreLines() ) {
         QString line, name, abbrev;
         int rah, ram, ras, dd, dm, ds;
@@ -82,7 +87,7 @@ void ConstellationNamesComponent::loadData(CultureList* cultures)
             abbrev = line.mid( 13, 3 );
             name  = line.mid( 17 ).trimmed();
 
-            if( Options::useLocalConstellNames() )
+            if( localCNames )
                 name = i18nc( "Constellation name (optional)", name.toLocal8Bit().data() );
 
             dms r; r.setH( rah, ram, ras );
@@ -92,14 +97,23 @@ void ConstellationNamesComponent::loadData(CultureList* cultures)
                 d.setD( -1.0*d.Degrees() );
 
             SkyObject *o = new SkyObject( SkyObject::CONSTELLATION, r, d, 0.0, name, abbrev );
-            o->EquatorialToHorizontal(KStarsData::Instance()->lst(),KStarsData::Instance()->geo()->lat());
-            m_ObjectList.append( o );
-
-            //Add name to the list of object names
-            objectNames(SkyObject::CONSTELLATION).append( name );
-            objectLists(SkyObject::CONSTELLATION).append(QPair<QString, const SkyObject*>(name, o));
+            names.append( o );
         }
     }
+    return names;
+}
+
+void ConstellationNamesComponent::commitData( const QList<SkyObject*> &names )
+{
+    KStarsData *data = KStarsData::Instance();
+    foreach ( SkyObject *o, names ) {
+        o->EquatorialToHorizontal( data->lst(), data->geo()->lat() );
+        m_ObjectList.append( o );
+
+        //Add name to the list of object names
+        objectNames(SkyObject::CONSTELLATION).append( o->name() );
+        objectLists(SkyObject::CONSTELLATION).append(QPair<QString, const SkyObject*>(o->name(), o));
+    }
 }
 
 bool ConstellationNamesComponent::selected()
@@ -69,9 +69,13 @@ public:
 
     virtual bool selected();
 
-    void loadData(CultureList* cultures);
-
 private:
+    /** @short Read the names of the constellations of the current culture, from any thread */
+    QList<SkyObject*> readData(CultureList* cultures);
+
+    /** @short Add the names to the component and to the lists of object names */
+    void commitData( const QList<SkyObject*> &names );
+
     bool localCNames;
 };
 
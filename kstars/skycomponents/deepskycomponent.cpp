@@ -378,6 +378,10 @@ void DeepSkyComponent::appendIndex( DeepSkyObject *o, DeepSkyIndex* dsIndex, Tri
 void DeepSkyComponent::draw( SkyPainter *skyp )
 {
 #ifndef KSTARS_LITE
+    // Labels are kept until the next draw, so that drawLabels() can be repeated
+    for ( int i = 0; i <= MAX_LINENUMBER_MAG; i++ )
+        m_labelList[ i ]->clear();
+
     if ( ! selected() ) return;
 
     bool drawFlag;
@@ -516,7 +520,6 @@ void DeepSkyComponent::drawLabels()
         for ( int j = 0; j < list->size(); j++ ) {
             labeler->drawNameLabel(list->at(j).obj, list->at(j).o);
         }
-        list->clear();
     }
 #endif
 }
@@ -527,6 +530,13 @@ SkyObject* DeepSkyComponent::findByName( const QString &name ) {
     return nameHash[ name.toLower() ];
 }
 
+void DeepSkyComponent::indexNames( QHash<QString, SkyObject*> &index ) {
+    for ( QHash<QString, DeepSkyObject*>::const_iterator it = nameHash.constBegin(); it != nameHash.constEnd(); ++it ) {
+        if ( it.value() && ! index.contains( it.key() ) )
+            index.insert( it.key(), it.value() );
+    }
+}
+
 void DeepSkyComponent::objectsInArea( QList<SkyObject*>& list, const SkyRegion& region )
 {
     for( SkyRegion::const_iterator it = region.constBegin(); it != region.constEnd(); ++it )
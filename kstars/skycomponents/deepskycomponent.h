@@ -98,6 +98,8 @@ public:
      */
     virtual SkyObject* findByName( const QString &name );
 
+    virtual void indexNames( QHash<QString, SkyObject*> &index );
+
     /**
      * @short Searches the region(s) and appends the SkyObjects found to the list of sky objects
      *
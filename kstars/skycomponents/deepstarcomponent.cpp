@@ -38,6 +38,7 @@
 #include "starblockfactory.h"
 #include "starcomponent.h"
 #include "projections/projector.h"
+#include "auxiliary/frameprofiler.h"
 
 #include "skypainter.h"
 
@@ -200,10 +201,6 @@ void DeepStarComponent::draw( SkyPainter *skyp ) {
     KStarsData* data = KStarsData::Instance();
     UpdateID updateID = data->updateID();
 
-    //FIXME_FOV -- maybe not clamp like that...
-    float radius = map->projector()->fov();
-    if ( radius > 90.0 ) radius = 90.0;
-
     if ( m_skyMesh != SkyMesh::Instance() && m_skyMesh->inDraw() ) {
         printf("Warning: aborting concurrent DeepStarComponent::draw()");
     }
@@ -226,10 +223,17 @@ void DeepStarComponent::draw( SkyPainter *skyp ) {
 
     m_zoomMagLimit = maglim;
 
-    m_skyMesh->inDraw( true );
+    // When this catalog shares the HTM level of the main mesh, SkyMapComposite
+    // has already filled its draw buffer with the same viewport. Computing it
+    // again would change the buffer under the feet of the other sky map
+    // layers, which may be drawn concurrently. Catalogs sharing another
+    // mesh reuse the viewport computed by the first of them.
+    bool ownMesh = ( m_skyMesh != SkyMesh::Instance() );
+    if ( ownMesh ) {
+        m_skyMesh->inDraw( true );
 
-    SkyPoint* focus = map->focus();
-    m_skyMesh->aperture( focus, radius + 1.0, DRAW_BUF ); // divide by 2 for testing
+        m_skyMesh->viewport( map->focus(), map->projector(), 1.0, DRAW_BUF );
+    }
 
     MeshIterator region(m_skyMesh, DRAW_BUF);
 
@@ -242,12 +246,13 @@ void DeepStarComponent::draw( SkyPainter *skyp ) {
     StarBlockFactory *m_StarBlockFactory = StarBlockFactory::Instance();
     //    m_StarBlockFactory->drawID = m_skyMesh->drawID();
     //    qDebug() << "Mesh size = " << m_skyMesh->size() << "; drawID = " << m_skyMesh->drawID();
-    QTime t;
+    FrameProfiler *profiler = FrameProfiler::Instance();
+    const bool profiling = profiler->isEnabled();
+    QElapsedTimer t, t_update;
+    qint64 updateTime = 0;
     int nTrixels = 0;
-
-    t_dynamicLoad = 0;
-    t_updateCache = 0;
-    t_drawUnnamed = 0;
+    int nUpdated = 0;
+    qint64 t_dynamicLoad = 0;
 
     visibleStarCount = 0;
 
@@ -271,7 +276,8 @@ void DeepStarComponent::draw( SkyPainter *skyp ) {
 
             }
         }
-        t_updateCache = t.restart();
+        profiler->addTime( "mark star blocks", t.nsecsElapsed() );
+        t.start();
         region.reset();
     }
 
@@ -289,7 +295,7 @@ void DeepStarComponent::draw( SkyPainter *skyp ) {
                      << currentRegion << " !"<< endl;
 	}
 
-        t_dynamicLoad += t.restart();
+        t_dynamicLoad += t.nsecsElapsed();
 
         //        qDebug() << "Drawing SBL for trixel " << currentRegion << ", SBL has "
         //                 <<  m_starBlockList[ currentRegion ]->getBlockCount() << " blocks" << endl;
@@ -305,8 +311,14 @@ void DeepStarComponent::draw( SkyPainter *skyp ) {
                 //                qDebug() << "We claim that he's from trixel " << currentRegion
                 //<< ", and indexStar says he's from " << m_skyMesh->indexStar( curStar );
 
-                if ( curStar->updateID != updateID )
+                if ( curStar->updateID != updateID ) {
+                    if ( profiling )
+                        t_update.start();
                     curStar->JITupdate();
+                    if ( profiling )
+                        updateTime += t_update.nsecsElapsed();
+                    ++nUpdated;
+                }
 
                 float mag = curStar->mag();
 
@@ -320,10 +332,17 @@ void DeepStarComponent::draw( SkyPainter *skyp ) {
 
         // DEBUG: Uncomment to identify problems with Star Block Factory / preservation of Magnitude Order in the LRU Cache
         //        verifySBLIntegrity();
-        t_drawUnnamed += t.restart();
+        t.start();
 
     }
-    m_skyMesh->inDraw( false );
+    if ( ownMesh )
+        m_skyMesh->inDraw( false );
+
+    profiler->addTime( "load star blocks", t_dynamicLoad );
+    profiler->addTime( "update stars", updateTime );
+    profiler->addCount( "trixels visited", nTrixels );
+    profiler->addCount( "stars updated", nUpdated );
+    profiler->addCount( "stars drawn", visibleStarCount );
 #ifdef PROFILE_SINCOS
     trig_calls_here += dms::trig_function_calls;
     trig_redundancy_here += dms::redundant_trig_function_calls;
@@ -467,9 +486,9 @@ bool DeepStarComponent::starsInAperture( QList<StarObject *> &list, const SkyPoi
     Q_ASSERT( center.ra0().Degrees() >= 0.0 );
     Q_ASSERT( center.dec0().Degrees() <= 90.0 );
 
-    m_skyMesh->intersect( center.ra0().Degrees(), center.dec0().Degrees(), radius, (BufNum) OBJ_NEAREST_BUF );
+    m_skyMesh->intersect( center.ra0().Degrees(), center.dec0().Degrees(), radius, (BufNum) APERTURE_BUF );
 
-    MeshIterator region( m_skyMesh, OBJ_NEAREST_BUF );
+    MeshIterator region( m_skyMesh, APERTURE_BUF );
 
     if( maglim < -28 )
         maglim = m_FaintMagnitude;
@@ -135,11 +135,6 @@ private:
     unsigned long  visibleStarCount;
     quint16        MSpT;             // Maximum number of stars in any given trixel
 
-    // Time keeping variables
-    long unsigned  t_dynamicLoad;
-    long unsigned  t_drawUnnamed;
-    long unsigned  t_updateCache;
-
     QVector< StarBlockList *> m_starBlockList;
     QHash<int, StarObject *> m_CatalogNumber;
 
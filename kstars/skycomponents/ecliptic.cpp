@@ -79,6 +79,15 @@ void Ecliptic::draw( SkyPainter *skyp )
 
     m_label.reset();
     drawLines( skyp );
+
+    drawLabels();
+}
+
+void Ecliptic::drawLabels()
+{
+    if ( ! selected() ) return;
+
+    QColor color( KStarsData::Instance()->colorScheme()->colorNamed( "EclColor" ) );
     SkyLabeler::Instance()->setPen( QPen( QBrush( color ), 1, Qt::SolidLine ) );
     m_label.draw();
 
@@ -40,6 +40,12 @@ public:
 
     virtual void draw( SkyPainter *skyp );
     virtual void drawCompassLabels();
+
+    /** @short Draw the guide label and the compass labels.
+     * This is done by draw(), but can be repeated without redrawing the line
+     * as long as the view did not change.
+     */
+    void drawLabels();
     virtual bool selected();
 
     virtual LineListLabel* label() { return &m_label; }
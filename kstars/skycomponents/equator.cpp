@@ -76,6 +76,13 @@ void Equator::draw( SkyPainter *skyp )
     m_label.reset();
     NoPrecessIndex::draw( skyp );
 
+    drawLabels();
+}
+
+void Equator::drawLabels()
+{
+    if ( ! selected() ) return;
+
     KStarsData *data = KStarsData::Instance();
     QColor color( data->colorScheme()->colorNamed( "EqColor" ) );
     SkyLabeler::Instance()->setPen( QPen( QBrush( color ), 1, Qt::SolidLine ) );
@@ -19,6 +19,8 @@
 #define LINELIST_H
 
 #include <QList>
+#include <QPointF>
+#include <QVector>
 
 #include "typedef.h"
 
@@ -35,7 +37,8 @@ class KSNumbers;
 class LineList
 {
 public:
-    LineList() : drawID(0), updateID(0), updateNumID(0) {}
+    LineList() : drawID(0), updateID(0), updateNumID(0), updateJD(0.0), screenViewID(0), screenJD(0.0),
+                 screenLST(0.0), screenLat(0.0) {}
 
     /* A global drawID (in SkyMesh) is updated at the start of each draw
      * cycle.  Since an extended object is often covered by more than one
@@ -46,6 +49,24 @@ public:
     DrawID   drawID;
     UpdateID updateID;
     UpdateID updateNumID;
+    /* The Julian day of the epoch of the precessed coordinates. A forced
+     * update changes updateNumID without changing the epoch, in which case
+     * the points are not precessed again.
+     */
+    long double updateJD;
+
+    /* The screen positions of the points, and whether they are visible,
+     * as projected by SkyQPainter. They are valid for the view screenViewID
+     * (see Projector::viewID()) and for the coordinates of the points at
+     * the Julian day screenJD, sidereal time screenLST and latitude
+     * screenLat. They are reused as long as none of these change, e.g. when
+     * a layer of the sky map is redrawn in place after a forced update.
+     */
+    QVector<QPointF> screenPoints;
+    QVector<bool>    screenVisible;
+    quint64  screenViewID;
+    long double screenJD;
+    double   screenLST, screenLat;
 
     /* @short return the list of points for iterating or appending
      * (or whatever).
@@ -160,8 +160,11 @@ void LineListIndex::JITupdate( LineList* lineList )
     if ( lineList->updateNumID != data->updateNumID() ) {
         lineList->updateNumID = data->updateNumID();
         KSNumbers* num = data->updateNum();
-        for (int i = 0; i < points->size(); i++ ) {
-            points->at( i )->updateCoords( num );
+        if ( lineList->updateJD != num->julianDay() ) {
+            lineList->updateJD = num->julianDay();
+            for (int i = 0; i < points->size(); i++ ) {
+                points->at( i )->updateCoords( num );
+            }
         }
     }
 
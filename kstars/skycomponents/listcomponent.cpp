@@ -64,6 +64,14 @@ SkyObject* ListComponent::findByName( const QString &name ) {
     return 0;
 }
 
+void ListComponent::indexNames( QHash<QString, SkyObject*> &index ) {
+    foreach( SkyObject *o, m_ObjectList ) {
+        indexName( index, o->name(), o );
+        indexName( index, o->longname(), o );
+        indexName( index, o->name2(), o );
+    }
+}
+
 SkyObject* ListComponent::objectNearest( SkyPoint *p, double &maxrad ) {
     if ( ! selected() )
         return 0;
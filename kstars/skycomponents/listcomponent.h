@@ -54,6 +54,8 @@ public:
     virtual void update( KSNumbers *num=0 );
 
     virtual SkyObject* findByName( const QString &name );
+
+    virtual void indexNames( QHash<QString, SkyObject*> &index );
     virtual SkyObject* objectNearest( SkyPoint *p, double &maxrad );
 
     void clear();
@@ -20,10 +20,11 @@
 #include <QList>
 #include <QPointF>
 #include <QPolygonF>
-#include <QtConcurrent>
+#include <QSharedPointer>
 
 #include <KLocalizedString>
 
+#include "componentloader.h"
 #include "kstarsdata.h"
 #ifdef KSTARS_LITE
 #include "skymaplite.h"
@@ -52,9 +53,15 @@ MilkyWay::MilkyWay( SkyComposite *parent ) :
     //loadContours("smc.dat", i18n("Loading Small Magellanic Clouds"));
     //summary();
 
-    //QtConcurrent::run(this, &MilkyWay::loadContours, QString("milkyway.dat"), i18n("Loading Milky Way"));
-    QtConcurrent::run(this, &MilkyWay::loadContours, QString("lmc.dat"), i18n("Loading Large Magellanic Clouds"));
-    QtConcurrent::run(this, &MilkyWay::loadContours, QString("smc.dat"), i18n("Loading Small Magellanic Clouds"));
+    // Indexing in the sky mesh is not thread safe, only the files are read in the background
+    QSharedPointer< QList<SkipList*> > lmc( new QList<SkipList*> );
+    loader()->addTask( "large magellanic cloud", QStringList(),
+                       [this, lmc]() { *lmc = readContours( "lmc.dat", i18n("Loading Large Magellanic Clouds") ); },
+                       [this, lmc]() { appendContours( *lmc ); } );
+    QSharedPointer< QList<SkipList*> > smc( new QList<SkipList*> );
+    loader()->addTask( "small magellanic cloud", QStringList(),
+                       [this, smc]() { *smc = readContours( "smc.dat", i18n("Loading Small Magellanic Clouds") ); },
+                       [this, smc]() { appendContours( *smc ); } );
 }
 
 const IndexHash& MilkyWay::getIndexHash(LineList* lineList ) {
@@ -97,10 +104,19 @@ void MilkyWay::draw( SkyPainter *skyp )
 }
 
 void MilkyWay::loadContours(QString fname, QString greeting) {
-    
+    appendContours( readContours( fname, greeting ) );
+}
+
+void MilkyWay::appendContours( const QList<SkipList*> &contours ) {
+    foreach ( SkipList *skipList, contours )
+        appendBoth( skipList );
+}
+
+QList<SkipList*> MilkyWay::readContours( const QString &fname, const QString &greeting ) {
+    QList<SkipList*> contours;
     KSFileReader fileReader;
     if ( !fileReader.open( fname ) )
-        return;
+        return contours;
     fileReader.setProgress( greeting, 2136, 5 );
 
     SkipList *skipList = 0;
@@ -123,7 +139,7 @@ void MilkyWay::loadContours(QString fname, QString greeting) {
 
         if ( firstChar == 'M' )  {
             if( skipList )
-                appendBoth( skipList );
+                contours.append( skipList );
             skipList = 0;
             iSkip    = 0;
         }
@@ -137,5 +153,6 @@ void MilkyWay::loadContours(QString fname, QString greeting) {
         iSkip++;
     }  
     if ( skipList )
-        appendBoth( skipList );
+        contours.append( skipList );
+    return contours;
 }
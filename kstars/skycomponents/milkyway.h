@@ -44,6 +44,12 @@ public:
 
     /** Load skiplists from file */
     void loadContours(QString fname, QString greeting);
+
+    /** Read skiplists from file, from any thread */
+    QList<SkipList*> readContours( const QString &fname, const QString &greeting );
+
+    /** Add skiplists read by readContours() */
+    void appendContours( const QList<SkipList*> &contours );
   
     virtual void draw( SkyPainter *skyp );
     virtual bool selected();
@@ -101,6 +101,17 @@ SkyObject* PlanetMoonsComponent::findByName( const QString &name ) {
     return 0;
 }
 
+void PlanetMoonsComponent::indexNames( QHash<QString, SkyObject*> &index ) {
+    int nmoons = pmoons->nMoons();
+
+    for ( int i=0; i<nmoons; ++i ) {
+        TrailObject *moon = pmoons->moon(i);
+        indexName( index, moon->name(), moon );
+        indexName( index, moon->longname(), moon );
+        indexName( index, moon->name2(), moon );
+    }
+}
+
 #ifdef KSTARS_LITE
 KSPlanetBase* PlanetMoonsComponent::getPlanet() const {
     return m_Planet->planet();
@@ -67,6 +67,8 @@ public:
      */
     SkyObject* findByName( const QString &name );
 
+    void indexNames( QHash<QString, SkyObject*> &index );
+
     /** Return pointer to stored planet object. */
     KSPlanetBase* getPlanet() const;
 
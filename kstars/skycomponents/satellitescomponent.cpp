@@ -22,7 +22,7 @@
 #include <QProgressDialog>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
-#include <QtConcurrent>
+#include <QSharedPointer>
 
 #ifndef KSTARS_LITE
 #include <KJobUiDelegate>
@@ -30,6 +30,7 @@
 #include <KLocalizedString>
 
 #include "satellitegroup.h"
+#include "componentloader.h"
 #include "Options.h"
 #include "ksfilereader.h"
 #include "skylabeler.h"
@@ -38,7 +39,10 @@
 SatellitesComponent::SatellitesComponent( SkyComposite *parent ) :
     SkyComponent( parent )
 {
-    QtConcurrent::run(this, &SatellitesComponent::loadData);
+    QSharedPointer< QList<SatelliteGroup*> > groups( new QList<SatelliteGroup*> );
+    loader()->addTask( "satellites", QStringList(),
+                       [this, groups]() { *groups = readData(); },
+                       [this, groups]() { commitData( *groups ); } );
 }
 
 SatellitesComponent::~SatellitesComponent()
@@ -46,13 +50,14 @@ SatellitesComponent::~SatellitesComponent()
 
 }
 
-void SatellitesComponent::loadData()
+QList<SatelliteGroup*> SatellitesComponent::readData()
 {
     KSFileReader fileReader;
     QString line;
     QStringList group_infos;
+    QList<SatelliteGroup*> groups;
 
-    if ( ! fileReader.open( "satellites.dat" ) ) return;
+    if ( ! fileReader.open( "satellites.dat" ) ) return groups;
 
     emitProgressText( i18n("Loading satellites" ) );
 
@@ -61,8 +66,14 @@ void SatellitesComponent::loadData()
         if ( line.trimmed().isEmpty() || line.at( 0 ) == '#' )
             continue;
         group_infos = line.split( ';' );
-        m_groups.append( new SatelliteGroup( group_infos.at( 0 ), group_infos.at( 1 ), QUrl( group_infos.at( 2 ) ) ) );
+        groups.append( new SatelliteGroup( group_infos.at( 0 ), group_infos.at( 1 ), QUrl( group_infos.at( 2 ) ) ) );
     }
+    return groups;
+}
+
+void SatellitesComponent::commitData( const QList<SatelliteGroup*> &groups )
+{
+    m_groups.append( groups );
 
     objectNames(SkyObject::SATELLITE).clear();
     objectLists(SkyObject::SATELLITE).clear();
@@ -80,6 +91,7 @@ void SatellitesComponent::loadData()
             }
         }
     }
+    emitObjectNamesChanged();
 }
 
 bool SatellitesComponent::selected() {
@@ -242,3 +254,11 @@ SkyObject* SatellitesComponent::findByName( const QString &name )
 {
      return nameHash[ name.toLower() ];
 }
+
+void SatellitesComponent::indexNames( QHash<QString, SkyObject*> &index )
+{
+    for ( QHash<QString, Satellite*>::const_iterator it = nameHash.constBegin(); it != nameHash.constEnd(); ++it ) {
+        if ( it.value() && ! index.contains( it.key() ) )
+            index.insert( it.key(), it.value() );
+    }
+}
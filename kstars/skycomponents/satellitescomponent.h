@@ -103,13 +103,19 @@ public:
      */
     SkyObject* findByName( const QString &name );
 
-    void loadData();
+    void indexNames( QHash<QString, SkyObject*> &index );
 
 protected:
     virtual void drawTrails( SkyPainter* skyp );
 
 
 private:
+    /** @short Read the groups of satellites from satellites.dat, from any thread */
+    QList<SatelliteGroup*> readData();
+
+    /** @short Add the groups, and the names of their selected satellites */
+    void commitData( const QList<SatelliteGroup*> &groups );
+
     QList<SatelliteGroup*> m_groups;    // List of all groups
     QHash<QString, Satellite*> nameHash;
 };
@@ -36,10 +36,29 @@ void SkyComponent::emitProgressText( const QString &message ) {
     parent()->emitProgressText( message );
 }
 
+void SkyComponent::emitObjectNamesChanged() {
+    parent()->emitObjectNamesChanged();
+}
+
+ComponentLoader* SkyComponent::loader() {
+    return parent()->loader();
+}
+
 SkyObject* SkyComponent::findByName( const QString & ) {
     return 0;
 }
 
+void SkyComponent::indexNames( QHash<QString, SkyObject*> & )
+{}
+
+void SkyComponent::indexName( QHash<QString, SkyObject*> &index, const QString &name, SkyObject *o ) {
+    if ( name.isEmpty() )
+        return;
+    QString key = name.toLower();
+    if ( ! index.contains( key ) )
+        index.insert( key, o );
+}
+
 SkyObject* SkyComponent::objectNearest( SkyPoint *, double & ) {
     return 0;
 }
@@ -24,6 +24,7 @@
 
 class QString;
 
+class ComponentLoader;
 class KSNumbers;
 class SkyObject;
 class SkyPoint;
@@ -171,6 +172,17 @@ public:
      */
     virtual SkyObject* findByName( const QString &name );
 
+    /**
+     * @short Add the names findByName() matches to @p index
+     *
+     * The keys are the names in lower case. A name already in @p index is
+     * kept, so that the components searched first by findByName() take
+     * precedence.
+     * @note This function does nothing; it is reimplemented in the
+     * sub-classes which reimplement findByName()
+     */
+    virtual void indexNames( QHash<QString, SkyObject*> &index );
+
     /**
      * @short Searches the region(s) and appends the SkyObjects found to the list of sky objects
      *
@@ -203,6 +215,18 @@ public:
      */
     virtual void emitProgressText( const QString &message );
 
+    /** @short Notify that objects were added to or removed from the component
+     *
+     * @sa SkyMapComposite::objectNamesChanged
+     */
+    virtual void emitObjectNamesChanged();
+
+    /** @short The loader of the data of the components, which is owned by SkyMapComposite
+     *
+     * @sa ComponentLoader
+     */
+    virtual ComponentLoader* loader();
+
     inline QHash<int, QStringList>& objectNames() { return getObjectNames(); }
 
     inline QStringList& objectNames(int type) { return getObjectNames()[type]; }
@@ -215,6 +239,9 @@ protected:
     void removeFromNames(const SkyObject* obj);
     void removeFromLists(const SkyObject* obj);
 
+    /** @short Add @p name of @p o to @p index, unless it is empty or already there */
+    static void indexName( QHash<QString, SkyObject*> &index, const QString &name, SkyObject *o );
+
 private:
     /** */
     virtual QHash<int, QStringList>& getObjectNames();
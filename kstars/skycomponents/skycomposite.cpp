@@ -79,6 +79,11 @@ SkyObject* SkyComposite::findByName( const QString &name ) {
     return 0;
 }
 
+void SkyComposite::indexNames( QHash<QString, SkyObject*> &index ) {
+    foreach ( SkyComponent *comp, components() )
+        comp->indexNames( index );
+}
+
 SkyObject* SkyComposite::objectNearest( SkyPoint *p, double &maxrad ) {
     if ( !selected() )
         return 0;
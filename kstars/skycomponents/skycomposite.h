@@ -93,6 +93,9 @@ public:
      */
     virtual SkyObject* findByName( const QString &name );
 
+    /** @short Add the names of the objects of the children, in their order */
+    virtual void indexNames( QHash<QString, SkyObject*> &index );
+
     /** @short Identify the nearest SkyObject to the given SkyPoint,
      * among the children of this SkyComposite
      * @p p pointer to the SkyPoint around which to search.
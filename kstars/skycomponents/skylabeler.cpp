@@ -17,6 +17,7 @@
 
 #include "skylabeler.h"
 
+#include <algorithm>
 #include <cstdio>
 
 #include <QPainter>
@@ -27,17 +28,13 @@
 #include "skymap.h"
 #include "projections/projector.h"
 
-//---------------------------------------------------------------------------//
-// A Little data container class
-//---------------------------------------------------------------------------//
-
-typedef struct LabelRun
-{
-    LabelRun(int s, int e) : start(s), end(e) {}
-    int start;
-    int end;
-
-} LabelRun;
+namespace {
+    // Order for binary searches in a LabelRow: runs ending before x come first
+    bool runEndsBefore( const LabelRun &run, int x )
+    {
+        return run.end < x;
+    }
+}
 
 
 //----- Now for the main event ----------------------------------------------//
@@ -116,13 +113,6 @@ SkyLabeler::SkyLabeler() :
 
 SkyLabeler::~SkyLabeler()
 {
-    for (int y = 0; y < screenRows.size(); y++ ) {
-        LabelRow* row = screenRows[y];
-        for ( int i = 0; i < row->size(); i++) {
-            delete row->at(i);
-        }
-        delete row;
-    }
 }
 
 bool SkyLabeler::drawGuideLabel( QPointF& o, const QString& text, double angle )
@@ -287,24 +277,12 @@ void SkyLabeler::reset( SkyMap* skyMap )
     m_size = (maxY + 1) * m_maxX;
 
     // Resize if needed:
-    if ( maxY > m_maxY ) {
-        screenRows.resize( m_maxY );
-        for ( int y = m_maxY; y <= maxY; y++) {
-            screenRows.append( new LabelRow() );
-        }
-        //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
-    }
-
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
+    if ( maxY >= screenRows.size() )
+        screenRows.resize( maxY + 1 );
 
-    for (int y = 0; y <= minMaxY; y++) {
-        LabelRow* row = screenRows[y];
-        for ( int i = 0; i < row->size(); i++) {
-            delete row->at(i);
-        }
-        row->clear();
+    // Empty the rows, keeping their storage for this frame
+    for (int y = 0; y < screenRows.size(); y++) {
+        screenRows[y].resize( 0 );
     }
 
     // never decrease m_maxY:
@@ -344,24 +322,12 @@ void SkyLabeler::reset()
     m_size = (maxY + 1) * m_maxX;
 
     // Resize if needed:
-    if ( maxY > m_maxY ) {
-        screenRows.resize( m_maxY );
-        for ( int y = m_maxY; y <= maxY; y++) {
-            screenRows.append( new LabelRow() );
-        }
-        //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
-    }
-
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
+    if ( maxY >= screenRows.size() )
+        screenRows.resize( maxY + 1 );
 
-    for (int y = 0; y <= minMaxY; y++) {
-        LabelRow* row = screenRows[y];
-        for ( int i = 0; i < row->size(); i++) {
-            delete row->at(i);
-        }
-        row->clear();
+    // Empty the rows, keeping their storage for this frame
+    for (int y = 0; y < screenRows.size(); y++) {
+        screenRows[y].resize( 0 );
     }
 
     // never decrease m_maxY:
@@ -436,11 +402,10 @@ bool SkyLabeler::markRegion( qreal left, qreal right, qreal top, qreal bot )
     // check to see if we overlap any existing label
     // We must check all rows before we start marking
     for (int y = minY; y <= maxY; y++ ) {
-        LabelRow* row = screenRows[ y ];
-        int i;
-        for ( i = 0; i < row->size(); i++) {
-            if ( row->at( i )->end < minX ) continue;  // skip past these
-            if ( row->at( i )->start > maxX ) break;
+        const LabelRow &row = screenRows.at( y );
+        // first run which does not end before us
+        LabelRow::const_iterator it = std::lower_bound( row.constBegin(), row.constEnd(), minX, runEndsBefore );
+        if ( it != row.constEnd() && it->start <= maxX ) {
             m_misses++;
             return false;
         }
@@ -453,43 +418,39 @@ bool SkyLabeler::markRegion( qreal left, qreal right, qreal top, qreal bot )
     // screenRows.
 
     for ( int y = minY; y <= maxY; y++ ) {
-        LabelRow* row = screenRows[ y ];
+        LabelRow &row = screenRows[ y ];
 
         // Simplest case: an empty row
-        if ( row->size() < 1 ) {
-            row->append( new LabelRun( minX, maxX ) );
+        if ( row.size() < 1 ) {
+            row.append( LabelRun( minX, maxX ) );
             m_elements++;
             continue;
         }
 
         // Find out our place in the universe (or row).
-        // H'mm.  Maybe we could cache these numbers above.
-        int i;
-        for ( i = 0; i < row->size(); i++ ) {
-            if ( row->at(i)->end >= minX ) break;
-        }
+        int i = std::lower_bound( row.constBegin(), row.constEnd(), minX, runEndsBefore ) - row.constBegin();
 
         // i now points to first label PAST ours
 
         // if we are first, append or merge at start of list
         if ( i == 0 ) {
-            if ( row->at(0)->start - maxX < m_minDeltaX ) {
-                row->at(0)->start = minX;
+            if ( row[0].start - maxX < m_minDeltaX ) {
+                row[0].start = minX;
             }
             else {
-                row->insert( 0, new LabelRun(minX, maxX) );
+                row.insert( 0, LabelRun(minX, maxX) );
                 m_elements++;
             }
             continue;
         }
 
         // if we are past the last label, merge or append at end
-        else if ( i == row->size() ) {
-            if ( minX - row->at(i-1)->end < m_minDeltaX ) {
-                row->at(i-1)->end = maxX;
+        else if ( i == row.size() ) {
+            if ( minX - row[i-1].end < m_minDeltaX ) {
+                row[i-1].end = maxX;
             }
             else {
-                row->append( new LabelRun(minX, maxX) );
+                row.append( LabelRun(minX, maxX) );
                 m_elements++;
             }
             continue;
@@ -498,30 +459,29 @@ bool SkyLabeler::markRegion( qreal left, qreal right, qreal top, qreal bot )
         // if we got here, we must insert or merge the new label
         //  between [i-1] and [i]
 
-        bool mergeHead = ( minX - row->at(i-1)->end < m_minDeltaX );
-        bool mergeTail = ( row->at(i)->start - maxX < m_minDeltaX );
+        bool mergeHead = ( minX - row[i-1].end < m_minDeltaX );
+        bool mergeTail = ( row[i].start - maxX < m_minDeltaX );
 
         // double merge => combine all 3 into one
         if ( mergeHead && mergeTail ) {
-            row->at(i-1)->end = row->at(i)->end;
-            delete row->at( i );
-            row->removeAt( i );
+            row[i-1].end = row[i].end;
+            row.remove( i );
             m_elements--;
         }
 
         // Merge label with [i-1]
         else if ( mergeHead ) {
-            row->at(i-1)->end = maxX;
+            row[i-1].end = maxX;
         }
 
         // Merge label with [i]
         else if ( mergeTail ) {
-            row->at(i)->start = minX;
+            row[i].start = minX;
         }
 
         // insert between the two
         else {
-            row->insert( i, new LabelRun( minX, maxX) );
+            row.insert( i, LabelRun( minX, maxX) );
             m_elements++;
         }
     }
@@ -610,23 +570,29 @@ void SkyLabeler::drawRudeNameLabel( SkyObject *obj, const QPointF &p )
 
 //----- Diagnostic and information routines -----
 
-float SkyLabeler::fillRatio()
+float SkyLabeler::fillRatio() const
 {
     if ( m_size == 0 ) return 0.0;
     return 100.0 * float(m_marks) / float(m_size);
 }
 
-float SkyLabeler::hitRatio()
+float SkyLabeler::hitRatio() const
 {
     if (m_hits == 0 ) return 0.0;
     return 100.0 * float(m_hits) / ( float(m_hits + m_misses) );
 }
 
+QString SkyLabeler::frameReport() const
+{
+    return QString( "labels: fill=%1% hits=%2 misses=%3 ratio=%4% runs=%5 rows=%6" )
+            .arg( fillRatio(), 0, 'f', 1 ).arg( m_hits ).arg( m_misses )
+            .arg( hitRatio(), 0, 'f', 1 ).arg( m_elements ).arg( screenRows.size() );
+}
+
 void SkyLabeler::printInfo()
 {
     printf("SkyLabeler:\n");
-    printf("  fillRatio=%.1f%%\n", fillRatio() );
-    printf("  hits=%d  misses=%d  ratio=%.1f%%\n", m_hits, m_misses, hitRatio());
+    printf("  %s\n", qPrintable( frameReport() ) );
     printf("  yScale=%.1f maxY=%d\n", m_yScale, m_maxY );
 
     printf("  screenRows=%d elements=%d virtualSize=%.1f Kbytes\n",
@@ -650,20 +616,20 @@ void SkyLabeler::printInfo()
     }
 
     // Check for errors in the data structure
-    for (int y = 0; y <= m_maxY; y++) {
-        LabelRow* row = screenRows[y];
-        int size = row->size();
+    for (int y = 0; y < screenRows.size(); y++) {
+        const LabelRow &row = screenRows.at(y);
+        int size = row.size();
         if ( size < 2 ) continue;
 
         bool error = false;
         for (int i = 1; i < size; i++) {
-            if ( row->at(i-1)->end > row->at(i)->start ) error = true;
+            if ( row.at(i-1).end > row.at(i).start ) error = true;
         }
         if ( ! error ) continue;
 
         printf("ERROR: %3d: ", y );
-        for (int i=0; i < row->size(); i++) {
-            printf("(%d, %d) ", row->at(i)->start, row->at(i)->end );
+        for (int i=0; i < row.size(); i++) {
+            printf("(%d, %d) ", row.at(i).start, row.at(i).end );
         }
         printf("\n");
     }
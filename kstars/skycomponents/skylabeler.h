@@ -20,6 +20,7 @@
 
 #include <QFontMetricsF>
 #include <QList>
+#include <QString>
 #include <QVector>
 #include <QPainter>
 #include <QPicture>
@@ -27,14 +28,24 @@
 
 #include "skylabel.h"
 
-class QString;
 class QPointF;
 class SkyMap;
 class Projector;
-struct LabelRun;
 
-typedef QList<LabelRun*>	LabelRow;
-typedef QVector<LabelRow*>  ScreenRows;
+/**
+ * @short A run of consecutive pixels covered by labels in one strip of the screen
+ */
+struct LabelRun
+{
+    LabelRun() : start(0), end(0) {}
+    LabelRun(int s, int e) : start(s), end(e) {}
+    int start;
+    int end;
+};
+Q_DECLARE_TYPEINFO(LabelRun, Q_PRIMITIVE_TYPE);
+
+typedef QVector<LabelRun>	LabelRow;
+typedef QVector<LabelRow>  ScreenRows;
 
 
 /**
@@ -61,9 +72,12 @@ typedef QVector<LabelRow*>  ScreenRows;
  * The information in the X-dimension is completed run length encoded. A
  * consecutive run of pixels in one strip that are covered by one or more labels
  * is stored in a LabelRun object that merely stores the start pixel and the end
- * pixel.  A LabelRow is a list of LabelRun's stored in ascending order.  This
+ * pixel.  A LabelRow is a vector of LabelRun's stored in ascending order.  This
  * saves a lot of space over an explicit array and it also makes checking for
  * overlaps faster and even makes inserting new overlaps faster on average.
+ * The runs of a row are found by binary search, and they are stored by value
+ * in rows which keep their capacity from one frame to the next, so crowded
+ * fields do not allocate and free memory for every label.
  *
  * Synopsis:
  *
@@ -312,7 +326,7 @@ public:
      * good.  The fillRatio will be lowered of the screen is zoomed out
      * so are big blank spaces around the celestial sphere.
      */
-    float fillRatio();
+    float fillRatio() const;
 
     /**
      * @short diagnostic, the number of times mark() returned true divided by
@@ -323,7 +337,14 @@ public:
      * target to shoot for.  Expect it to be lower when fully zoomed out and
      * higher when zoomed in.
      */
-    float hitRatio();
+    float hitRatio() const;
+
+    /**
+     * @short diagnostic, a one line summary of the fill and hit ratios
+     * and of the size of the label rows for the current frame, meant to
+     * be included in frame profiling reports.
+     */
+    QString frameReport() const;
 
     /**
      * @short diagnostic, prints some brief statistics to the console.
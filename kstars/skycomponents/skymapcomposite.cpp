@@ -19,6 +19,8 @@
 
 #include <QPolygonF>
 #include <QApplication>
+#include <QThread>
+#include <QtConcurrent>
 
 #include "Options.h"
 #include "kstarsdata.h"
@@ -26,11 +28,13 @@
 #include "skymap.h"
 #include "ksutils.h"
 #endif
+#include "auxiliary/frameprofiler.h"
 #include "skyobjects/starobject.h"
 #include "skyobjects/deepskyobject.h"
 #include "skyobjects/ksplanet.h"
 #include "skyobjects/constellationsart.h"
 
+#include "componentloader.h"
 #include "targetlistcomponent.h"
 #include "constellationboundarylines.h"
 #include "constellationlines.h"
@@ -69,8 +73,11 @@
 #include "typedef.h"
 
 SkyMapComposite::SkyMapComposite(SkyComposite *parent ) :
-    SkyComposite(parent), m_reindexNum( J2000 )
+    SkyComposite(parent), m_reindexNum( J2000 ), m_NameIndexOutdated( false ), m_NameLookupValid( false ),
+    m_SolarSystemPending( false ), m_SolarSystemObsolete( false )
 {
+    // Components add their tasks to the loader as they are built
+    m_Loader = new ComponentLoader( this );
     m_skyLabeler = SkyLabeler::Instance();
     m_skyMesh = SkyMesh::Create( 3 );  // level 5 mesh = 8192 trixels
     m_skyMesh->debug( 0 );
@@ -119,7 +126,9 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent ) :
     for ( int i=0; i < allcatalogs.size(); ++ i ) {
         if( allcatalogs.at(i) == m_internetResolvedCat || allcatalogs.at(i) == m_manualAdditionsCat ) // This is a special catalog
             continue;
-        m_CustomCatalogs->addComponent(new CatalogComponent( this, allcatalogs.at(i), false, i ), 6 ); // FIXME: Should this be 6 or 5? See SkyMapComposite::reloadDeepSky()
+        CatalogComponent *cc = new CatalogComponent( this, allcatalogs.at(i), false, i, false );
+        cc->loadDataInBackground();
+        m_CustomCatalogs->addComponent( cc, 6 ); // FIXME: Should this be 6 or 5? See SkyMapComposite::reloadDeepSky()
     }
 
     addComponent( m_SolarSystem = new SolarSystemComposite( this ), 2);
@@ -158,7 +167,9 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent ) :
     for ( int i=0; i < allcatalogs.size(); ++ i ) {
         if( allcatalogs.at(i) == m_internetResolvedCat || allcatalogs.at(i) == m_manualAdditionsCat ) // This is a special catalog
             continue;
-        m_CustomCatalogs->addComponent(new CatalogComponent( this, allcatalogs.at(i), false, i ), 6 ); // FIXME: Should this be 6 or 5? See SkyMapComposite::reloadDeepSky()
+        CatalogComponent *cc = new CatalogComponent( this, allcatalogs.at(i), false, i, false );
+        cc->loadDataInBackground();
+        m_CustomCatalogs->addComponent( cc, 6 ); // FIXME: Should this be 6 or 5? See SkyMapComposite::reloadDeepSky()
     }
 
     addComponent( m_SolarSystem = new SolarSystemComposite( this ), 2);
@@ -172,10 +183,24 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent ) :
 #endif
     connect( this, SIGNAL( progressText( const QString & ) ),
              KStarsData::Instance(), SIGNAL( progressText( const QString & ) ) );
+    connect( this, SIGNAL( objectNamesChanged() ), KStarsData::Instance(), SIGNAL( clearCache() ) );
+    connect( this, SIGNAL( objectNamesChanged() ), this, SLOT( updateNameIndex() ) );
+    connect( &m_NameIndexWatcher, SIGNAL( finished() ), this, SLOT( slotNameIndexBuilt() ) );
+    connect( &m_SolarSystemWatcher, SIGNAL( finished() ), this, SLOT( slotSolarSystemComputed() ) );
+    // Queued, since tasks may also be finished while searching or drawing.
+    // A catalog is loaded in many tasks, the new objects are handled once for all.
+    connect( m_Loader, SIGNAL( idle() ), this, SLOT( slotComponentsLoaded() ), Qt::QueuedConnection );
+    m_Loader->start();
 }
 
 SkyMapComposite::~SkyMapComposite()
 {
+    // Finish the tasks while their components still exist, without updating the sky
+    disconnect( m_Loader, 0, this, 0 );
+    delete m_Loader;
+    m_NameIndexWatcher.waitForFinished();
+    m_SolarSystemWatcher.waitForFinished();
+
     delete m_skyLabeler;     // These are on the heap to avoid header file hell.
     delete m_skyMesh;
     delete m_Cultures;
@@ -186,6 +211,7 @@ SkyMapComposite::~SkyMapComposite()
 
 void SkyMapComposite::update(KSNumbers *num )
 {
+    FrameProfiler::Timer timer( "update" );
     //printf("updating SkyMapComposite\n");
     //1. Milky Way
     //m_MilkyWay->update( data, num );
@@ -225,11 +251,29 @@ void SkyMapComposite::update(KSNumbers *num )
 
 void SkyMapComposite::updateSolarSystemBodies(KSNumbers *num )
 {
+    FrameProfiler::Timer timer( "update solar system" );
+    // The positions computed in the background are for an older time
+    if ( m_SolarSystemPending ) {
+        m_SolarSystemWatcher.waitForFinished();
+        m_SolarSystemObsolete = true;
+    }
     m_SolarSystem->updateSolarSystemBodies( num );
 }
 
+bool SkyMapComposite::updateSolarSystemBodiesInBackground( const KSNumbers &num )
+{
+    if ( m_SolarSystemPending )
+        return false;
+
+    FrameProfiler::Timer timer( "update solar system" );
+    m_SolarSystemPending = true;
+    m_SolarSystemWatcher.setFuture( m_SolarSystem->computeSolarSystemBodies( num ) );
+    return true;
+}
+
 void SkyMapComposite::updateMoons(KSNumbers *num )
 {
+    FrameProfiler::Timer timer( "update moons" );
     m_SolarSystem->updateMoons( num );
 }
 
@@ -242,6 +286,43 @@ void SkyMapComposite::updateMoons(KSNumbers *num )
 void SkyMapComposite::draw( SkyPainter *skyp )
 {
     Q_UNUSED(skyp)
+#ifndef KSTARS_LITE
+    if ( !beginDraw() )
+        return;
+
+    for ( int layer = 0; layer < NumDrawLayers; ++layer ) {
+        drawLayer( DrawLayer( layer ), skyp );
+        if ( layer == SolarSystemLayer )
+            drawLabels( skyp );
+    }
+
+    endDraw();
+
+    // DEBUG Edit. Keywords: Trixel boundaries. Currently works only in QPainter mode
+    // -jbb uncomment these to see trixel outlines:
+    /*
+    QPainter *psky = dynamic_cast< QPainter *>( skyp );
+    if( psky ) {
+        qDebug() << "Drawing trixel boundaries for debugging.";
+        psky->setPen(  QPen( QBrush( QColor( "yellow" ) ), 1, Qt::SolidLine ) );
+        m_skyMesh->draw( *psky, OBJ_NEAREST_BUF );
+        SkyMesh *p;
+        if( p = SkyMesh::Instance( 6 ) ) {
+            qDebug() << "We have a deep sky mesh to draw";
+            p->draw( *psky, OBJ_NEAREST_BUF );
+        }
+
+        psky->setPen( QPen( QBrush( QColor( "green" ) ), 1, Qt::SolidLine ) );
+        m_skyMesh->draw( *psky, NO_PRECESS_BUF );
+        if( p )
+            p->draw( *psky, NO_PRECESS_BUF );
+    }
+    */
+#endif
+}
+
+bool SkyMapComposite::beginDraw()
+{
 #ifndef KSTARS_LITE
     SkyMap *map = SkyMap::Instance();
     KStarsData *data = KStarsData::Instance();
@@ -257,26 +338,21 @@ void SkyMapComposite::draw( SkyPainter *skyp )
     // cycle so the sky moves as a single sheet.  May not be needed.
     data->syncUpdateIDs();
 
-    // prepare the aperture
-    // FIXME_FOV: We may want to rejigger this to allow
-    // wide-angle views --hdevalence
-    float radius = map->projector()->fov();
-    if ( radius > 180.0 )
-        radius = 180.0;
-
 
     if ( m_skyMesh->inDraw() ) {
         printf("Warning: aborting concurrent SkyMapComposite::draw()\n");
-        return;
+        return false;
     }
 
     m_skyMesh->inDraw( true );
+    FrameProfiler::Timer timer( "begin draw" );
+    // prepare the part of the sky visible on the screen
     SkyPoint* focus = map->focus();
-    m_skyMesh->aperture( focus, radius + 1.0, DRAW_BUF ); // divide by 2 for testing
+    m_skyMesh->viewport( focus, map->projector(), 1.0, DRAW_BUF );
 
-    // create the no-precess aperture if needed
+    // create the no-precess viewport if needed
     if ( Options::showEquatorialGrid() || Options::showHorizontalGrid() || Options::showCBounds() || Options::showEquator() ) {
-        m_skyMesh->index( focus, radius + 1.0, NO_PRECESS_BUF );
+        m_skyMesh->viewport( focus, map->projector(), 1.0, NO_PRECESS_BUF, false );
     }
 
     // clear marks from old labels and prep fonts
@@ -298,88 +374,152 @@ void SkyMapComposite::draw( SkyPainter *skyp )
                 SkyLabeler::AddLabel( o, SkyLabeler::RUDE_LABEL );
             }
     }
+    return true;
+#else
+    return false;
+#endif
+}
 
-    m_MilkyWay->draw( skyp );
+#ifndef KSTARS_LITE
+// Draw a component, accounting its time to the frame profiler
+static void drawComponent( SkyComponent *component, SkyPainter *skyp, const char *section )
+{
+    FrameProfiler::Timer timer( section );
+    component->draw( skyp );
+}
+#endif
 
-    m_EquatorialCoordinateGrid->draw( skyp );
-    m_HorizontalCoordinateGrid->draw( skyp );
+void SkyMapComposite::drawLayer( DrawLayer layer, SkyPainter *skyp )
+{
+#ifndef KSTARS_LITE
+    KStarsData *data = KStarsData::Instance();
 
-    //Draw constellation boundary lines only if we draw western constellations
-    if ( m_Cultures->current() == "Western" )
-    {
-        m_CBoundLines->draw( skyp );
-        m_ConstellationArt->draw( skyp );
-    }
-    else if ( m_Cultures->current() == "Inuit" )
-    {
-        m_ConstellationArt->draw( skyp );
-    }
+    switch ( layer ) {
+    case BackgroundLayer:
+        drawComponent( m_MilkyWay, skyp, "draw milky way" );
 
-    m_CLines->draw( skyp );
+        drawComponent( m_EquatorialCoordinateGrid, skyp, "draw equatorial grid" );
+        drawComponent( m_HorizontalCoordinateGrid, skyp, "draw horizontal grid" );
 
-    m_Equator->draw( skyp );
+        //Draw constellation boundary lines only if we draw western constellations
+        if ( m_Cultures->current() == "Western" )
+        {
+            drawComponent( m_CBoundLines, skyp, "draw constellation boundaries" );
+            drawComponent( m_ConstellationArt, skyp, "draw constellation art" );
+        }
+        else if ( m_Cultures->current() == "Inuit" )
+        {
+            drawComponent( m_ConstellationArt, skyp, "draw constellation art" );
+        }
 
-    m_Ecliptic->draw( skyp );
+        drawComponent( m_CLines, skyp, "draw constellation lines" );
+        break;
 
-    m_DeepSky->draw( skyp );
+    case GuideLayer:
+        drawComponent( m_Equator, skyp, "draw equator" );
 
-    m_CustomCatalogs->draw( skyp );
-    m_internetResolvedComponent->draw( skyp );
-    m_manualAdditionsComponent->draw( skyp );
+        drawComponent( m_Ecliptic, skyp, "draw ecliptic" );
+        break;
 
-    m_Stars->draw( skyp );
+    case DeepSkyLayer:
+        drawComponent( m_DeepSky, skyp, "draw deep sky" );
 
-    m_SolarSystem->drawTrails( skyp );
-    m_SolarSystem->draw( skyp );
+        drawComponent( m_CustomCatalogs, skyp, "draw custom catalogs" );
+        drawComponent( m_internetResolvedComponent, skyp, "draw internet resolved" );
+        drawComponent( m_manualAdditionsComponent, skyp, "draw manual additions" );
+        break;
 
-    m_Satellites->draw( skyp );
+    case StarLayer:
+        drawComponent( m_Stars, skyp, "draw stars" );
+        break;
 
-    m_Supernovae->draw(skyp);
+    case SolarSystemLayer:
+        {
+            FrameProfiler::Timer timer( "draw trails" );
+            m_SolarSystem->drawTrails( skyp );
+        }
+        drawComponent( m_SolarSystem, skyp, "draw solar system" );
 
-    map->drawObjectLabels( labelObjects() );
+        drawComponent( m_Satellites, skyp, "draw satellites" );
 
-    m_skyLabeler->drawQueuedLabels();
-    m_CNames->draw( skyp );
-    m_Stars->drawLabels();
-    m_DeepSky->drawLabels();
+        drawComponent( m_Supernovae, skyp, "draw supernovae" );
+        break;
 
-    m_ObservingList->pen = QPen( QColor(data->colorScheme()->colorNamed( "ObsListColor" )), 1. );
-    if( KStars::Instance() && !m_ObservingList->list )
-        m_ObservingList->list = new SkyObjectList( KSUtils::makeVanillaPointerList( KStarsData::Instance()->observingList()->sessionList() ) ); // Make sure we never delete the pointers in m_ObservingList->list!
-    if( m_ObservingList )
-        m_ObservingList->draw( skyp );
+    case ForegroundLayer:
+        m_ObservingList->pen = QPen( QColor(data->colorScheme()->colorNamed( "ObsListColor" )), 1. );
+        if( KStars::Instance() && !m_ObservingList->list )
+            m_ObservingList->list = new SkyObjectList( KSUtils::makeVanillaPointerList( KStarsData::Instance()->observingList()->sessionList() ) ); // Make sure we never delete the pointers in m_ObservingList->list!
+        if( m_ObservingList )
+            drawComponent( m_ObservingList, skyp, "draw observing list" );
 
-    m_Flags->draw( skyp );
+        drawComponent( m_Flags, skyp, "draw flags" );
 
-    m_StarHopRouteList->pen = QPen( QColor(data->colorScheme()->colorNamed( "StarHopRouteColor" )), 1. );
-    m_StarHopRouteList->draw( skyp );
+        m_StarHopRouteList->pen = QPen( QColor(data->colorScheme()->colorNamed( "StarHopRouteColor" )), 1. );
+        drawComponent( m_StarHopRouteList, skyp, "draw star hop route" );
 
-    m_ArtificialHorizon->draw( skyp );
+        drawComponent( m_ArtificialHorizon, skyp, "draw artificial horizon" );
 
-    m_Horizon->draw( skyp );
+        drawComponent( m_Horizon, skyp, "draw horizon" );
+        break;
 
-    m_skyMesh->inDraw( false );
+    default:
+        break;
+    }
+#else
+    Q_UNUSED(layer)
+    Q_UNUSED(skyp)
+#endif
+}
 
-    // DEBUG Edit. Keywords: Trixel boundaries. Currently works only in QPainter mode
-    // -jbb uncomment these to see trixel outlines:
-    /*
-    QPainter *psky = dynamic_cast< QPainter *>( skyp );
-    if( psky ) {
-        qDebug() << "Drawing trixel boundaries for debugging.";
-        psky->setPen(  QPen( QBrush( QColor( "yellow" ) ), 1, Qt::SolidLine ) );
-        m_skyMesh->draw( *psky, OBJ_NEAREST_BUF );
-        SkyMesh *p;
-        if( p = SkyMesh::Instance( 6 ) ) {
-            qDebug() << "We have a deep sky mesh to draw";
-            p->draw( *psky, OBJ_NEAREST_BUF );
-        }
+bool SkyMapComposite::canDrawConcurrently( DrawLayer layer )
+{
+    return layer == BackgroundLayer || layer == DeepSkyLayer || layer == StarLayer;
+}
 
-        psky->setPen( QPen( QBrush( QColor( "green" ) ), 1, Qt::SolidLine ) );
-        m_skyMesh->draw( *psky, NO_PRECESS_BUF );
-        if( p )
-            p->draw( *psky, NO_PRECESS_BUF );
+void SkyMapComposite::prepareConcurrentDraw()
+{
+#ifndef KSTARS_LITE
+    // Constellation lines are attached to the star objects themselves. Update
+    // those stars now, so that the background and the star layers do not both
+    // write their coordinates while they are drawn.
+    m_CLines->updateStars();
+#endif
+}
+
+void SkyMapComposite::drawLayerLabels( DrawLayer layer )
+{
+#ifndef KSTARS_LITE
+    // The labels of stars and deep-sky objects are drawn by drawLabels()
+    // from the positions found during their last draw, so only the guide
+    // labels drawn along with their lines need to be repeated here.
+    if ( layer == GuideLayer ) {
+        m_Equator->drawLabels();
+        m_Ecliptic->drawLabels();
     }
-    */
+#else
+    Q_UNUSED(layer)
+#endif
+}
+
+void SkyMapComposite::drawLabels( SkyPainter *skyp )
+{
+#ifndef KSTARS_LITE
+    FrameProfiler::Timer timer( "draw labels" );
+    SkyMap::Instance()->drawObjectLabels( labelObjects() );
+
+    m_skyLabeler->drawQueuedLabels();
+    m_CNames->draw( skyp );
+    m_Stars->drawLabels();
+    m_DeepSky->drawLabels();
+#else
+    Q_UNUSED(skyp)
+#endif
+}
+
+void SkyMapComposite::endDraw()
+{
+#ifndef KSTARS_LITE
+    m_skyMesh->inDraw( false );
 #endif
 }
 
@@ -542,6 +682,17 @@ QList<SkyObject*> SkyMapComposite::findObjectsInArea( const SkyPoint& p1, const
 }
 
 SkyObject* SkyMapComposite::findByName( const QString &name ) {
+    // Once everything is loaded, all the names are in a single hash, which
+    // is filled again on the first search after objects were added or removed
+    if ( m_Loader->isFinished() && QThread::currentThread() == thread() ) {
+        if ( ! m_NameLookupValid ) {
+            m_NameLookup.clear();
+            indexNames( m_NameLookup );
+            m_NameLookupValid = true;
+        }
+        return m_NameLookup.value( name.toLower() );
+    }
+
     //We search the children in an "intelligent" order (most-used
     //object types first), in order to avoid wasting too much time
     //looking for a match.  The most important part of this ordering
@@ -566,9 +717,23 @@ SkyObject* SkyMapComposite::findByName( const QString &name ) {
     o = m_Satellites->findByName(name);
     if ( o ) return o;
 
+    // The object may belong to a component which is still loading. Waiting for
+    // it would block the GUI, callers search again on objectNamesChanged().
     return 0;
 }
 
+void SkyMapComposite::indexNames( QHash<QString, SkyObject*> &index ) {
+    m_SolarSystem->indexNames( index );
+    m_DeepSky->indexNames( index );
+    m_CustomCatalogs->indexNames( index );
+    m_internetResolvedComponent->indexNames( index );
+    m_manualAdditionsComponent->indexNames( index );
+    m_CNames->indexNames( index );
+    m_Stars->indexNames( index );
+    m_Supernovae->indexNames( index );
+    m_Satellites->indexNames( index );
+}
+
 
 SkyObject* SkyMapComposite::findStarByGenetiveName( const QString name ) {
     return m_Stars->findStarByGenetiveName( name );
@@ -593,6 +758,7 @@ void SkyMapComposite::addCustomCatalog( const QString &filename, int index ) {
     CatalogComponent *cc = new CatalogComponent( this, filename, false, index );
     if( cc->objectList().size() ) {
         m_CustomCatalogs->addComponent( cc );
+        emit objectNamesChanged();
     } else {
         delete cc;
     }
@@ -604,6 +770,7 @@ void SkyMapComposite::removeCustomCatalog( const QString &name ) {
 
         if ( ccc->name() == name ) {
             m_CustomCatalogs->removeComponent( ccc );
+            emit objectNamesChanged();
             return;
         }
     }
@@ -630,9 +797,11 @@ void SkyMapComposite::reloadCNames( ) {
     //     m_CNames = 0;
     //     m_CNames = new ConstellationNamesComponent( this, m_Cultures );
     //     SkyMapDrawAbstract::setDrawLock( false );
+    m_Loader->waitFor( "constellation names" );
     objectNames(SkyObject::CONSTELLATION).clear();
     delete m_CNames;
     m_CNames = new ConstellationNamesComponent( this, m_Cultures );
+    emit objectNamesChanged();
 }
 
 void SkyMapComposite::reloadConstellationArt(){
@@ -670,6 +839,8 @@ void SkyMapComposite::reloadDeepSky() {
     // list really bad to delete and regenerate SkyObjects.
 
     SkyMapDrawAbstract::setDrawLock(true);
+    // The catalogs may still be loading
+    m_Loader->waitForAll();
     delete m_CustomCatalogs;
     m_CustomCatalogs = new SkyComposite( this );
     delete m_internetResolvedComponent;
@@ -690,6 +861,7 @@ void SkyMapComposite::reloadDeepSky() {
 
 
     SkyMapDrawAbstract::setDrawLock(false);
+    emit objectNamesChanged();
 #endif
 }
 
@@ -698,6 +870,61 @@ bool SkyMapComposite::isLocalCNames() {
     return m_CNames->isLocalCNames();
 }
 
+void SkyMapComposite::waitForLoading() {
+    m_Loader->waitForAll();
+}
+
+static ObjectNameIndex buildNameIndex( const QHash<int, QVector<QPair<QString, const SkyObject*>>> &lists ) {
+    ObjectNameIndex index;
+    index.build( lists );
+    return index;
+}
+
+void SkyMapComposite::updateNameIndex() {
+    m_NameLookupValid = false;
+    // The objects of the index may be deleted
+    m_NameIndex = ObjectNameIndex();
+    if ( ! m_Loader->isFinished() )
+        return; // built once the last component is loaded
+    if ( m_NameIndexWatcher.isRunning() ) {
+        m_NameIndexOutdated = true;
+        return;
+    }
+    m_NameIndexWatcher.setFuture( QtConcurrent::run( buildNameIndex, m_ObjectLists ) );
+}
+
+void SkyMapComposite::slotNameIndexBuilt() {
+    if ( m_NameIndexOutdated ) {
+        m_NameIndexOutdated = false;
+        updateNameIndex();
+    } else {
+        m_NameIndex = m_NameIndexWatcher.result();
+    }
+}
+
+void SkyMapComposite::slotSolarSystemComputed() {
+    m_SolarSystemPending = false;
+    if ( m_SolarSystemObsolete ) {
+        m_SolarSystemObsolete = false;
+        return;
+    }
+
+    FrameProfiler::Timer timer( "commit solar system" );
+    m_SolarSystem->commitSolarSystemBodies();
+    emit solarSystemUpdated();
+}
+
+void SkyMapComposite::slotComponentsLoaded() {
+    emit objectNamesChanged();
+
+    KStarsData *data = KStarsData::Instance();
+    // Before KStarsData holds the composite, its first time update covers the new objects
+    if ( data->skyComposite() != this )
+        return;
+    data->setFullTimeUpdate();
+    data->updateTime( data->geo() );
+}
+
 void SkyMapComposite::emitProgressText( const QString &message ) {
     emit progressText( message );
 #ifndef Q_OS_ANDROID
@@ -707,6 +934,10 @@ void SkyMapComposite::emitProgressText( const QString &message ) {
     //qDebug() << QString("PROGRESS TEXT: %1\n").arg( message );
 }
 
+void SkyMapComposite::emitObjectNamesChanged() {
+    emit objectNamesChanged();
+}
+
 const QList<DeepSkyObject*>& SkyMapComposite::deepSkyObjects() const {
     return m_DeepSky->objectList();
 }
@@ -18,11 +18,13 @@
 #ifndef SKYMAPCOMPOSITE_H
 #define SKYMAPCOMPOSITE_H
 
+#include <QFutureWatcher>
 #include <QList>
 
 #include "skycomposite.h"
 #include "ksnumbers.h"
 #include "skyobject.h"
+#include "objectnameindex.h"
 
 class SkyMesh;
 class SkyLabeler;
@@ -30,6 +32,7 @@ class SkyMap;
 
 class QPolygonF;
 
+class ComponentLoader;
 class CultureList;
 class ConstellationBoundaryLines;
 class ConstellationLines;
@@ -97,6 +100,18 @@ public:
     	*/
     virtual void updateSolarSystemBodies( KSNumbers *num );
 
+    /**
+     * @short Compute the positions of the solar system bodies for @p num in the background.
+     *
+     * Unlike updateSolarSystemBodies(), the bodies drawn keep their positions until the new
+     * ones are all found, then they are swapped in at once from the event loop and
+     * solarSystemUpdated() is emitted. A call to updateSolarSystemBodies() meanwhile
+     * supersedes the positions being computed.
+     * @return false, without doing anything, if previous positions are still being computed
+     * @sa SolarSystemComposite::computeSolarSystemBodies()
+     */
+    bool updateSolarSystemBodiesInBackground( const KSNumbers &num );
+
     /**
     	*@short Delegate moon position updates to the SolarSystemComposite
     	*
@@ -113,12 +128,75 @@ public:
     	*/
     virtual void updateMoons( KSNumbers *num );
 
+    /**
+        *@enum DrawLayer
+        *The layers of the sky map, in drawing order. Each layer only depends on
+        *some of the view parameters, so the sky map can cache them separately.
+        *@see SkyMapQDraw
+        */
+    enum DrawLayer {
+        BackgroundLayer = 0, ///< Milky Way, coordinate grids, constellation lines, boundaries and art
+        GuideLayer,          ///< Equator and ecliptic, with their labels
+        DeepSkyLayer,        ///< Deep-sky objects and custom catalogs
+        StarLayer,           ///< Stars
+        SolarSystemLayer,    ///< Solar system bodies and their trails, satellites and supernovae
+        ForegroundLayer,     ///< Observing list, flags, star-hop route, artificial horizon and horizon
+        NumDrawLayers
+    };
+
     /**
     	*@short Delegate draw requests to all sub components
     	*@p psky Reference to the QPainter on which to paint
     	*/
     virtual void draw( SkyPainter *skyp );
 
+    /**
+        *@short Prepare a draw cycle made of drawLayer() calls
+        *This indexes the visible part of the sky and resets the labeler.
+        *@return false if a draw cycle is already in progress, in which case nothing must be drawn
+        */
+    bool beginDraw();
+
+    /**
+        *@short Draw the components of one layer
+        *Layers must be drawn in the order of DrawLayer, and drawLabels() must be called
+        *right after the SolarSystemLayer. The layers for which canDrawConcurrently() is
+        *true are the exception: once prepareConcurrentDraw() has been called, they may be
+        *drawn at the same time from several threads, each with its own painter, as long
+        *as they are all finished before the SolarSystemLayer is drawn.
+        */
+    void drawLayer( DrawLayer layer, SkyPainter *skyp );
+
+    /**
+        *@return true if the layer can be drawn outside of the GUI thread, concurrently
+        *with the other such layers. These layers do not use the SkyLabeler: the labels
+        *of their objects are only drawn by drawLabels().
+        */
+    static bool canDrawConcurrently( DrawLayer layer );
+
+    /**
+        *@short Prepare drawing the layers for which canDrawConcurrently() is true in parallel
+        *Must be called from the GUI thread after beginDraw(), before starting to draw them.
+        */
+    void prepareConcurrentDraw();
+
+    /**
+        *@short Repeat the labels that a layer which is not redrawn in this cycle would have drawn
+        *This must be called at the place of the layer in the drawing order. The view must not
+        *have changed since the layer was last drawn.
+        */
+    void drawLayerLabels( DrawLayer layer );
+
+    /**
+        *@short Draw the name labels of all layers
+        */
+    void drawLabels( SkyPainter *skyp );
+
+    /**
+        *@short Finish a draw cycle started with beginDraw()
+        */
+    void endDraw();
+
     /**
       *@return the object nearest a given point in the sky.
       *@param p The point to find an object near
@@ -145,12 +223,17 @@ public:
     	*all be checked for a match.
     	*@note Overloaded from SkyComposite.  In this version, we search 
     	*the most likely object classes first to be more efficient.
+    	*@note While components are loaded in the background, their objects
+    	*are not found yet. objectNamesChanged() is emitted once all are loaded.
     	*@p name the name to be matched
     	*@return a pointer to the SkyObject whose name matches
     	*the argument, or a NULL pointer if no match was found.
     	*/
     virtual SkyObject* findByName( const QString &name );
 
+    /** @short Add the names of the children, in the order findByName() searches them */
+    virtual void indexNames( QHash<QString, SkyObject*> &index );
+
     /**
       *@return the list of objects in the region defined by skypoints 
       *@param p1 first sky point (top-left vertex of rectangular region)
@@ -204,8 +287,26 @@ public:
     //Accessors for StarComponent
     SkyObject* findStarByGenetiveName( const QString name );
     virtual void emitProgressText( const QString &message );
+    virtual void emitObjectNamesChanged();
     QList<SkyObject*>& labelObjects() { return m_LabeledObjects; }
 
+    /** @short The loader of the components whose data is read in the background.
+     * The stars, planets and deep-sky objects are loaded before the constructor
+     * returns, the other components are finished from the event loop afterwards.
+     */
+    virtual ComponentLoader* loader() { return m_Loader; }
+
+    /** @short Finish loading all the components now, e.g. before searching
+     * all the objects or rendering a sky image without an event loop
+     */
+    void waitForLoading();
+
+    /** @return the index of the names of the objects. It is built in the
+     * background once the components are loaded, and is empty until then
+     * and while it is rebuilt.
+     */
+    inline const ObjectNameIndex& nameIndex() const { return m_NameIndex; }
+
     const QList<DeepSkyObject*>& deepSkyObjects() const;
     const QList<SkyObject*>& constellationNames() const;
     const QList<SkyObject*>& stars() const;
@@ -228,9 +329,28 @@ public:
     QList<SkyComponent*> customCatalogs();
 
     inline TargetListComponent *getStarHopRouteList() { return m_StarHopRouteList; }
+
+public slots:
+    /** @short Rebuild the indexes of the names, after objects were added or removed */
+    void updateNameIndex();
+
 signals:
     void progressText( const QString &message );
 
+    /** @short Emitted when objects are added to or removed from the lists of object names */
+    void objectNamesChanged();
+
+    /** @short Emitted when the positions computed by updateSolarSystemBodiesInBackground() are swapped in */
+    void solarSystemUpdated();
+
+private slots:
+    /** @short Compute the positions of the objects of the components which finished loading */
+    void slotComponentsLoaded();
+
+    void slotNameIndexBuilt();
+
+    void slotSolarSystemComputed();
+
 private:
     virtual QHash<int, QStringList>& getObjectNames();
     virtual QHash<int, QVector<QPair<QString, const SkyObject*>>>& getObjectLists();
@@ -259,6 +379,7 @@ private:
     SyncedCatalogComponent      *m_internetResolvedComponent;
     SyncedCatalogComponent      *m_manualAdditionsComponent;
 
+    ComponentLoader*        m_Loader;
     SkyMesh*                m_skyMesh;
     SkyLabeler*             m_skyLabeler;
 
@@ -270,6 +391,14 @@ private:
     QHash<int, QStringList> m_ObjectNames;
     QHash<int, QVector<QPair<QString, const SkyObject*>>> m_ObjectLists;
     QHash<QString, QString> m_ConstellationNames;
+    ObjectNameIndex m_NameIndex;
+    QFutureWatcher<ObjectNameIndex> m_NameIndexWatcher;
+    bool m_NameIndexOutdated; // the names changed while the index was built
+    QHash<QString, SkyObject*> m_NameLookup; // lower case names for findByName()
+    bool m_NameLookupValid;
+    QFutureWatcher<void> m_SolarSystemWatcher;
+    bool m_SolarSystemPending;  // positions are computed, or were and are not swapped in yet
+    bool m_SolarSystemObsolete; // updateSolarSystemBodies() was called meanwhile
     QString m_internetResolvedCat; // Holds the name of the internet resolved catalog
     QString m_manualAdditionsCat;
 };
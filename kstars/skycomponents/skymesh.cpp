@@ -21,6 +21,8 @@
 #include "projections/projector.h"
 #include "ksnumbers.h"
 
+#include <cmath>
+
 #include <QHash>
 #include <QPolygonF>
 #include <QPointF>
@@ -63,6 +65,8 @@ SkyMesh::SkyMesh( int level) :
 {
     errLimit = HTMesh::size() / 4;
     m_inDraw = false;
+    for ( int i = 0; i < NUM_MESH_BUF; i++ )
+        m_viewportGeneration[i] = 0;
 }
 
 void SkyMesh::aperture(SkyPoint *p0, double radius, MeshBufNum_t bufNum)
@@ -84,7 +88,7 @@ void SkyMesh::aperture(SkyPoint *p0, double radius, MeshBufNum_t bufNum)
         printf("p0 - p2 = %6.4f degrees\n", p0->angularDistanceTo( &p2 ).Degrees() );
     }
 
-    HTMesh::intersect( p1.ra().Degrees(), p1.dec().Degrees(), radius, (BufNum) bufNum);
+    intersectCircle( p1.ra().Degrees(), p1.dec().Degrees(), radius, bufNum );
     m_drawID++;
 
     return;
@@ -92,6 +96,126 @@ void SkyMesh::aperture(SkyPoint *p0, double radius, MeshBufNum_t bufNum)
         printf("Warining: overlapping buffer: %d\n", bufNum);
 }
 
+void SkyMesh::intersectCircle( double ra, double dec, double radius, MeshBufNum_t bufNum )
+{
+    MeshBuffer *buffer = meshBuffer( (BufNum) bufNum );
+
+    // Look for a recent circle covering this one without selecting too many
+    // more trixels.  Hover queries move by small steps, so most of them are
+    // covered by the previous one thanks to the slack added below.
+    double sinDec = sin( dec * dms::DegToRad ), cosDec = cos( dec * dms::DegToRad );
+    for ( int i = 0; i < m_circleCache.size(); i++ ) {
+        const CircleResult &c = m_circleCache.at( i );
+        if ( c.radius < radius || c.radius > radius + 2.0 * CircleSlack )
+            continue;
+        double cosDist = sinDec * sin( c.dec * dms::DegToRad ) +
+            cosDec * cos( c.dec * dms::DegToRad ) * cos( ( ra - c.ra ) * dms::DegToRad );
+        double dist = acos( qBound( -1.0, cosDist, 1.0 ) ) / dms::DegToRad;
+        if ( dist + radius > c.radius )
+            continue;
+
+        if ( i > 0 )
+            m_circleCache.move( i, 0 );
+        const CircleResult &hit = m_circleCache.first();
+        buffer->reset();
+        for ( int j = 0; j < hit.trixels.size(); j++ )
+            buffer->append( hit.trixels.at( j ) );
+        return;
+    }
+
+    CircleResult result;
+    result.ra = ra;
+    result.dec = dec;
+    result.radius = radius + CircleSlack;
+    HTMesh::intersect( ra, dec, result.radius, (BufNum) bufNum );
+
+    MeshIterator region( this, (BufNum) bufNum );
+    result.trixels.reserve( region.size() );
+    while ( region.hasNext() )
+        result.trixels.append( region.next() );
+
+    m_circleCache.prepend( result );
+    if ( m_circleCache.size() > CircleCacheSize )
+        m_circleCache.removeLast();
+}
+
+void SkyMesh::viewport( SkyPoint *center, const Projector *proj, double margin,
+                        MeshBufNum_t bufNum, bool precess )
+{
+    KStarsData* data = KStarsData::Instance();
+    const KSNumbers *num = data->updateNum();
+    const ViewParams &vp = proj->viewParams();
+
+    // Walk along the border of the screen. Unless the projection is gnomonic
+    // the sides are not great circles, so take a few points on each of them.
+    const int perSide = 8;
+    QVector<double> ra, dec;
+    ra.reserve( 4 * perSide );
+    dec.reserve( 4 * perSide );
+    bool usable = true;
+    for ( int side = 0; side < 4 && usable; side++ ) {
+        for ( int i = 0; i < perSide; i++ ) {
+            double t = double( i ) / perSide;
+            QPointF p;
+            switch ( side ) {
+            case 0:  p = QPointF( t * vp.width, 0.0 ); break;
+            case 1:  p = QPointF( vp.width, t * vp.height ); break;
+            case 2:  p = QPointF( ( 1.0 - t ) * vp.width, vp.height ); break;
+            default: p = QPointF( 0.0, ( 1.0 - t ) * vp.height ); break;
+            }
+            if ( proj->unusablePoint( p ) ) {
+                usable = false;
+                break;
+            }
+            SkyPoint sp = proj->fromScreen( p, data->lst(), data->geo()->lat() );
+            double a = sp.ra().radians(), d = sp.dec().radians();
+            if ( precess ) {
+                // Precess back to J2000 with the matrix of the current frame.
+                // Nutation and aberration are well within the margin.
+                double v[3] = { cos( a ) * cos( d ), sin( a ) * cos( d ), sin( d ) };
+                double w[3];
+                for ( int j = 0; j < 3; j++ )
+                    w[j] = num->p1( 0, j ) * v[0] + num->p1( 1, j ) * v[1] + num->p1( 2, j ) * v[2];
+                a = atan2( w[1], w[0] );
+                d = asin( w[2] );
+            }
+            ra.append( a / dms::DegToRad );
+            dec.append( d / dms::DegToRad );
+        }
+    }
+    QVector<double> key = ra + dec;
+    key << margin << ( precess ? 1.0 : 0.0 );
+
+    MeshBuffer *buffer = meshBuffer( (BufNum) bufNum );
+    m_drawID++;
+    if ( usable && key == m_viewportKey[ bufNum ] && buffer->generation() == m_viewportGeneration[ bufNum ] )
+        return;
+
+    // The corners of the screen are right angles, where the edges of the
+    // polygon only move out by margin / sqrt(2) when the vertices move by margin.
+    bool done = usable &&
+        HTMesh::intersect( ra.size(), ra.constData(), dec.constData(), 1.5 * margin, (BufNum) bufNum );
+
+    if ( ! done ) {
+        double radius = qMin( proj->fov(), 180.0 ) + margin;
+        key.clear();
+        key << radius;
+        if ( precess ) {
+            SkyPoint p1( center->ra(), center->dec() );
+            p1.apparentCoord( num->julianDay(), J2000 );
+            key << p1.ra().Degrees() << p1.dec().Degrees();
+        } else {
+            key << center->ra().Degrees() << center->dec().Degrees();
+        }
+        if ( key == m_viewportKey[ bufNum ] && buffer->generation() == m_viewportGeneration[ bufNum ] )
+            return;
+        HTMesh::intersect( key[1], key[2], radius, (BufNum) bufNum );
+    }
+
+    m_viewportKey[ bufNum ] = key;
+    m_viewportGeneration[ bufNum ] = buffer->generation();
+}
+
 Trixel SkyMesh::index(const SkyPoint* p)
 {
     return HTMesh::index( p->ra0().Degrees(), p->dec0().Degrees() );
@@ -115,7 +239,7 @@ void SkyMesh::indexStar( StarObject* star1, StarObject* star2 )
 
 void SkyMesh::index(const SkyPoint *p, double radius, MeshBufNum_t bufNum )
 {
-    HTMesh::intersect( p->ra().Degrees(), p->dec().Degrees(), radius, (BufNum) bufNum );
+    intersectCircle( p->ra().Degrees(), p->dec().Degrees(), radius, bufNum );
 
     return;
     if ( m_inDraw && bufNum != DRAW_BUF )
@@ -19,9 +19,11 @@
 #define SKYMESH_H
 
 
+#include <QAtomicInt>
 #include <QHash>
 #include <QList>
 #include <QObject>
+#include <QVector>
 
 #include <QPainter>
 
@@ -37,6 +39,7 @@ class KSNumbers;
 class StarObject;
 
 class SkyPoint;
+class Projector;
 class QPolygonF;
 
 class QPainter;
@@ -53,6 +56,7 @@ enum MeshBufNum_t {
     NO_PRECESS_BUF  = 1,
     OBJ_NEAREST_BUF = 2,
     IN_CONSTELL_BUF = 3,
+    APERTURE_BUF    = 4,
     NUM_MESH_BUF
 };
 
@@ -135,6 +139,27 @@ public:
      */
     void aperture( SkyPoint *center, double radius, MeshBufNum_t bufNum=DRAW_BUF );
 
+    /**
+     *@short finds the set of trixels that cover the part of the sky visible
+     * through the projector, rather than a circle around the focus.
+     * The outline of the screen is unprojected and the convex polygon it forms
+     * on the sky is intersected with the mesh, after the same reverse precession
+     * correction as aperture().  When the outline does not form a convex
+     * polygon, e.g. at wide fields of view or when the screen extends beyond
+     * the sky, the circular aperture of radius fov() around the center is used.
+     *
+     * The result is kept as long as nothing else is written to the buffer, so
+     * calling this again for the same view in the same frame does not recompute
+     * the intersection.  The drawID gets incremented like in aperture().
+     *@param center Center of the view, used for the circular fallback
+     *@param proj Projector of the view
+     *@param margin Safety margin around the view in degrees
+     *@param bufNum Buffer to use
+     *@param precess if false, no precession correction is done, like in index()
+     */
+    void viewport( SkyPoint *center, const Projector *proj, double margin,
+                   MeshBufNum_t bufNum=DRAW_BUF, bool precess=true );
+
     /** @short returns the index of the trixel containing p.
      */
     Trixel index( const SkyPoint *p );
@@ -284,16 +309,17 @@ public:
     void debug( int debug ) { m_debug = debug; }
 
     /** @return the current drawID which gets incremented each time aperture()
-     * is called.
+     * is called.  It may be read while the sky map layers are drawn in
+     * parallel, hence the atomic counter.
      */
-    DrawID drawID( ) const { return m_drawID; }
+    DrawID drawID( ) const { return m_drawID.load(); }
 
     /** @short increments the drawID and returns the new value.  This is
      * useful when you want to use the drawID to ensure you are not
      * repeating yourself when iterating over the elements of an IndexHash.
      * It is currently used in LineListIndex::reindex().
      */
-    int incDrawID() { return ++m_drawID; }
+    int incDrawID() { return m_drawID.fetchAndAddOrdered( 1 ) + 1; }
 
     /** @short Draws the outline of all the trixels in the specified buffer.
      * This was very useful during debugging.  I don't precess the points
@@ -309,14 +335,35 @@ public:
     void inDraw( bool inDraw ) { m_inDraw = inDraw; }
 
 private:
-    DrawID m_drawID;
+    QAtomicInt m_drawID;
     int    errLimit;
     int    m_debug;
 
     IndexHash   indexHash;
     KSNumbers   m_KSNumbers;
 
+    /** @short fills the buffer with the trixels covering a circle, or with
+     * a recent result covering a slightly larger circle around it.
+     * Used by aperture() and index() for the repeated queries of
+     * objectNearest() while the mouse hovers the sky map.
+     */
+    void intersectCircle( double ra, double dec, double radius, MeshBufNum_t bufNum );
+
+    // Recent circular intersections, most recent first
+    struct CircleResult {
+        double ra, dec, radius;
+        QVector<Trixel> trixels;
+    };
+    QList<CircleResult> m_circleCache;
+    static const int CircleCacheSize = 8;
+    static constexpr double CircleSlack = 0.5; // degrees added to new circles
+
     bool        m_inDraw;
+
+    // What viewport() last wrote to each buffer, see MeshBuffer::generation()
+    QVector<double> m_viewportKey[ NUM_MESH_BUF ];
+    unsigned int    m_viewportGeneration[ NUM_MESH_BUF ];
+
     static int defaultLevel;
     static QMap<int, SkyMesh *> pinstances;
 };
@@ -17,6 +17,8 @@
 
 #include "solarsystemcomposite.h"
 
+#include <QtConcurrent>
+
 #include <KLocalizedString>
 
 #include "solarsystemsinglecomponent.h"
@@ -37,7 +39,7 @@
 #include "planetmoonscomponent.h"
 
 SolarSystemComposite::SolarSystemComposite(SkyComposite *parent ) :
-    SkyComposite(parent)
+    SkyComposite(parent), m_BufferNum( J2000 )
 {
     emitProgressText( i18n("Loading solar system" ) );
     m_Earth = new KSPlanet( I18N_NOOP( "Earth" ), QString(), QColor( "white" ), 12756.28 /*diameter in km*/ );
@@ -100,6 +102,8 @@ SolarSystemComposite::SolarSystemComposite(SkyComposite *parent ) :
 
 SolarSystemComposite::~SolarSystemComposite()
 {
+    // SkyMapComposite waits for computeSolarSystemBodies() before deleting the components
+    clearBuffer();
     delete m_Earth;
 }
 
@@ -146,6 +150,85 @@ void SolarSystemComposite::updateMoons( KSNumbers *num )
     m_JupiterMoons->updateMoons( num );
 }
 
+QFuture<void> SolarSystemComposite::computeSolarSystemBodies( const KSNumbers &num )
+{
+    KStarsData *data = KStarsData::Instance();
+    m_BufferNum = num;
+
+    // The other bodies only read the Earth while they are computed
+    m_Earth->findPosition( &m_BufferNum );
+    foreach ( SolarSystemSingleComponent *comp, m_planets ) {
+        if ( comp->planet() == m_Sun || comp->planet() == m_Moon )
+            comp->updateSolarSystemBodies( &m_BufferNum );
+    }
+
+    // The clones are only made again when other bodies are shown
+    QVector<KSPlanetBase *> bodies = bufferedBodies();
+    bool reuse = ( bodies.size() == m_Buffer.size() );
+    for ( int i = 0; reuse && i < bodies.size(); ++i )
+        reuse = ( bodies[i] == m_Buffer[i].body );
+    if ( ! reuse ) {
+        clearBuffer();
+        foreach ( KSPlanetBase *body, bodies ) {
+            BufferedBody buffered = { body, static_cast<KSPlanetBase *>( body->clone() ) };
+            m_Buffer.append( buffered );
+        }
+    }
+    m_BufferedAsteroids = asteroids();
+    m_BufferedComets = comets();
+
+    const KSNumbers *bufferNum = &m_BufferNum;
+    const KSPlanet *earth = m_Earth;
+    CachingDms lat( *data->geo()->lat() ), lst( *data->lst() );
+    return QtConcurrent::map( m_Buffer, [bufferNum, earth, lat, lst]( BufferedBody &buffered ) {
+        buffered.clone->findPositionWithoutTrail( bufferNum, &lat, &lst, earth );
+        buffered.clone->EquatorialToHorizontal( &lst, &lat );
+    } );
+}
+
+void SolarSystemComposite::commitSolarSystemBodies()
+{
+    // The reloaded asteroids or comets may have been deleted
+    if ( asteroids() != m_BufferedAsteroids || comets() != m_BufferedComets ) {
+        clearBuffer();
+        return;
+    }
+
+    KStarsData *data = KStarsData::Instance();
+    foreach ( const BufferedBody &buffered, m_Buffer ) {
+        buffered.body->copyPosition( *buffered.clone, &m_BufferNum );
+        if ( buffered.body->hasTrail() )
+            buffered.body->updateTrail( data->lst(), data->geo()->lat() );
+    }
+}
+
+QVector<KSPlanetBase *> SolarSystemComposite::bufferedBodies() const
+{
+    QVector<KSPlanetBase *> bodies;
+    foreach ( SolarSystemSingleComponent *comp, m_planets ) {
+        if ( comp->planet() != m_Sun && comp->planet() != m_Moon && comp->selected() )
+            bodies.append( comp->planet() );
+    }
+    if ( m_AsteroidsComponent->selected() ) {
+        foreach ( SkyObject *o, asteroids() )
+            bodies.append( (KSPlanetBase*)o );
+    }
+    if ( m_CometsComponent->selected() ) {
+        foreach ( SkyObject *o, comets() )
+            bodies.append( (KSPlanetBase*)o );
+    }
+    return bodies;
+}
+
+void SolarSystemComposite::clearBuffer()
+{
+    foreach ( const BufferedBody &buffered, m_Buffer )
+        delete buffered.clone;
+    m_Buffer.clear();
+    m_BufferedAsteroids.clear();
+    m_BufferedComets.clear();
+}
+
 void SolarSystemComposite::drawTrails( SkyPainter* skyp )
 {
     if( selected() )
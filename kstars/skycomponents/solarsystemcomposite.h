@@ -18,10 +18,15 @@
 #ifndef SOLARSYSTEMCOMPOSITE_H
 #define SOLARSYSTEMCOMPOSITE_H
 
+#include <QFuture>
+#include <QVector>
+
 #include "skycomposite.h"
 #include "planetmoonscomponent.h"
+#include "ksnumbers.h"
 
 class KSPlanet;
+class KSPlanetBase;
 class KSSun;
 class KSMoon;
 class JupiterMoonsComponent;
@@ -58,6 +63,27 @@ public:
 
     virtual void updateMoons( KSNumbers *num );
 
+    /**
+     * @short Compute the positions of the planets, the asteroids and the comets for @p num
+     * on the global thread pool.
+     *
+     * The positions are found on clones of the bodies, kept from one computation to the next,
+     * so that the bodies drawn keep their positions until commitSolarSystemBodies() hands the
+     * new ones over. The Earth, the Sun and the Moon are updated at once, they are cheap and the
+     * Sun and the Moon are also updated by updateMoons().
+     *
+     * Call this on the main thread, and not again before the returned future is finished.
+     * @return the future of the computation
+     */
+    QFuture<void> computeSolarSystemBodies( const KSNumbers &num );
+
+    /**
+     * @short Hand the positions found by computeSolarSystemBodies() over to the bodies.
+     * Its future must be finished. Nothing is done if the asteroids or the comets were
+     * reloaded meanwhile.
+     */
+    void commitSolarSystemBodies();
+
     void drawTrails( SkyPainter *skyp );
 
     CometsComponent* cometsComponent();
@@ -68,6 +94,17 @@ public:
 
     const QList<SolarSystemSingleComponent *>& planets() const;
 private:
+    // A body whose position is computed in the background, on its clone
+    struct BufferedBody {
+        KSPlanetBase *body;
+        KSPlanetBase *clone;
+    };
+
+    /** @return the bodies computed by computeSolarSystemBodies(), depending on what is shown */
+    QVector<KSPlanetBase *> bufferedBodies() const;
+
+    void clearBuffer();
+
     KSPlanet *m_Earth;
     KSSun *m_Sun;
     KSMoon *m_Moon;
@@ -77,6 +114,10 @@ private:
     QList<SolarSystemSingleComponent *> m_planets;
     QList<SkyObject *> m_planetObjects;
     QList<SkyObject *> m_moons;
+
+    QVector<BufferedBody> m_Buffer;
+    QList<SkyObject *> m_BufferedAsteroids, m_BufferedComets; // the lists m_Buffer was computed from
+    KSNumbers m_BufferNum;      // the time of the positions of m_Buffer
 };
 
 #endif
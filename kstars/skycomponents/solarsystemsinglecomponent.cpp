@@ -74,6 +74,12 @@ SkyObject* SolarSystemSingleComponent::findByName( const QString &name ) {
     return 0;
 }
 
+void SolarSystemSingleComponent::indexNames( QHash<QString, SkyObject*> &index ) {
+    indexName( index, m_Planet->name(), m_Planet );
+    indexName( index, m_Planet->longname(), m_Planet );
+    indexName( index, m_Planet->name2(), m_Planet );
+}
+
 SkyObject* SolarSystemSingleComponent::objectNearest( SkyPoint *p, double &maxrad ) {
     double r = m_Planet->angularDistanceTo( p ).Degrees();
     if( r < maxrad ) {
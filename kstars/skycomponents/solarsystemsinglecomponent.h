@@ -63,6 +63,8 @@ public:
     virtual void updateSolarSystemBodies( KSNumbers *num );
 
     virtual SkyObject* findByName( const QString &name );
+
+    virtual void indexNames( QHash<QString, SkyObject*> &index );
     virtual SkyObject* objectNearest( SkyPoint *p, double &maxrad );
     virtual void draw( SkyPainter *skyp );
 
@@ -41,6 +41,7 @@
 #include "starblockfactory.h"
 
 #include "projections/projector.h"
+#include "auxiliary/frameprofiler.h"
 
 
 #if defined(Q_OS_FREEBSD) || defined(Q_OS_NETBSD)
@@ -55,7 +56,7 @@ StarComponent *StarComponent::pinstance = 0;
 
 StarComponent::StarComponent(SkyComposite *parent )
     : ListComponent(parent), m_reindexNum(J2000), m_FaintMagnitude(-5.0),
-      starsLoaded(false), focusStar(NULL)
+      starsLoaded(false), focusStar(NULL), m_Mutex(QMutex::Recursive)
 {
     m_skyMesh = SkyMesh::Instance();
     m_StarBlockFactory = StarBlockFactory::Instance();
@@ -243,9 +244,15 @@ float StarComponent::zoomMagnitudeLimit() {
 void StarComponent::draw( SkyPainter *skyp )
 {
 #ifndef KSTARS_LITE
+    // Labels are kept until the next draw, so that drawLabels() can be repeated
+    for ( int i = 0; i <= MAX_LINENUMBER_MAG; i++ )
+        m_labelList[ i ]->clear();
+
     if( !selected() )
         return;
 
+    QMutexLocker locker( &m_Mutex );
+
     SkyMap *map             = SkyMap::Instance();
     const Projector *proj   = map->projector();
     KStarsData* data        = KStarsData::Instance();
@@ -298,7 +305,13 @@ void StarComponent::draw( SkyPainter *skyp )
 
     m_StarBlockFactory->drawID = m_skyMesh->drawID();
 
+    FrameProfiler *profiler = FrameProfiler::Instance();
+    const bool profiling = profiler->isEnabled();
+    QElapsedTimer t_update;
+    qint64 updateTime = 0;
     int nTrixels = 0;
+    int nUpdated = 0;
+    int nDrawn = 0;
 
     while( region.hasNext() ) {
         ++nTrixels;
@@ -316,10 +329,19 @@ void StarComponent::draw( SkyPainter *skyp )
             if ( mag > maglim )
                 break;
 
-            if ( curStar->updateID != updateID )
+            if ( curStar->updateID != updateID ) {
+                // Summed here, a Timer for each star would lock the profiler as often
+                if ( profiling )
+                    t_update.start();
                 curStar->JITupdate();
+                if ( profiling )
+                    updateTime += t_update.nsecsElapsed();
+                ++nUpdated;
+            }
 
             bool drawn = skyp->drawPointSource( curStar, mag, curStar->spchar() );
+            if ( drawn )
+                ++nDrawn;
 
             //FIXME_SKYPAINTER: find a better way to do this.
             if ( drawn && !(m_hideLabels || mag > labelMagLim) )
@@ -335,6 +357,11 @@ void StarComponent::draw( SkyPainter *skyp )
         skyp->drawPointSource(focusStar, mag, focusStar->spchar() );
     }
 
+    profiler->addTime( "update stars", updateTime );
+    profiler->addCount( "trixels visited", nTrixels );
+    profiler->addCount( "stars updated", nUpdated );
+    profiler->addCount( "stars drawn", nDrawn );
+
     // Now draw each of our DeepStarComponents
     for( int i =0; i < m_DeepStarComponents.size(); ++i ) {
         m_DeepStarComponents.at( i )->draw( skyp );
@@ -369,7 +396,6 @@ void StarComponent::drawLabels()
         for ( int j = 0; j < list->size(); j++ ) {
             labeler->drawNameLabel( list->at(j).obj, list->at(j).o );
         }
-        list->clear();
     }
 
 }
@@ -541,6 +567,15 @@ SkyObject* StarComponent::findByName( const QString &name ) {
     return 0;
 }
 
+void StarComponent::indexNames( QHash<QString, SkyObject*> &index ) {
+    foreach( SkyObject* o, m_ObjectList ) {
+        indexName( index, o->name(), o );
+        indexName( index, o->longname(), o );
+        indexName( index, o->name2(), o );
+        indexName( index, ((StarObject *)o)->gname(false), o );
+    }
+}
+
 void StarComponent::objectsInArea( QList<SkyObject*>& list, const SkyRegion& region )
 {
     for( SkyRegion::const_iterator it = region.constBegin(); it != region.constEnd(); ++it )
@@ -554,6 +589,7 @@ void StarComponent::objectsInArea( QList<SkyObject*>& list, const SkyRegion& reg
 }
 
 StarObject *StarComponent::findByHDIndex( int HDnum ) {
+    QMutexLocker locker( &m_Mutex );
     KStarsData* data = KStarsData::Instance();
     StarObject *o;
     BinFileHelper hdidxReader;
@@ -603,6 +639,7 @@ StarObject *StarComponent::findByHDIndex( int HDnum ) {
 //
 SkyObject* StarComponent::objectNearest( SkyPoint *p, double &maxrad )
 {
+    QMutexLocker locker( &m_Mutex );
     m_zoomMagLimit = zoomMagnitudeLimit();
 
     SkyObject *oBest = 0;
@@ -649,9 +686,11 @@ void StarComponent::starsInAperture( QList<StarObject*> &list, const SkyPoint &c
     Q_ASSERT( center.ra0().Degrees() >= 0.0 );
     Q_ASSERT( center.dec0().Degrees() <= 90.0 );
 
-    m_skyMesh->intersect( center.ra0().Degrees(), center.dec0().Degrees(), radius, (BufNum) OBJ_NEAREST_BUF );
+    // Its own buffer, as this may run in a worker while objectNearest() uses OBJ_NEAREST_BUF
+    QMutexLocker locker( &m_Mutex );
+    m_skyMesh->intersect( center.ra0().Degrees(), center.dec0().Degrees(), radius, (BufNum) APERTURE_BUF );
 
-    MeshIterator region( m_skyMesh, OBJ_NEAREST_BUF );
+    MeshIterator region( m_skyMesh, APERTURE_BUF );
 
     if( maglim < -28 )
         maglim = m_FaintMagnitude;
@@ -662,7 +701,7 @@ void StarComponent::starsInAperture( QList<StarObject*> &list, const SkyPoint &c
         for (int i=0; i < starList->size(); ++i) {
             StarObject* star =  starList->at( i );
             if( !star ) continue;
-            if ( star->mag() > m_FaintMagnitude ) continue;
+            if ( star->mag() > maglim ) continue;
             if( star->angularDistanceTo( &center ).Degrees() <= radius )
                 list.append( star );
         }
@@ -46,6 +46,8 @@
 #include "starblockfactory.h"
 #include "skymesh.h"
 
+#include <QMutex>
+
 #ifdef KSTARS_LITE
 class StarItem;
 //#include "kstarslite/skyitems/staritem.h"
@@ -111,6 +113,8 @@ public:
      */
     virtual SkyObject* findByName( const QString &name );
 
+    virtual void indexNames( QHash<QString, SkyObject*> &index );
+
     /**
      * @short Searches the region(s) and appends the SkyObjects found to the list of sky objects
      *
@@ -146,6 +150,15 @@ public:
      */
     void starsInAperture( QList<StarObject*> &list, const SkyPoint &center, float radius, float maglim=-29 );
 
+    /**
+     *@short Lock serializing the star index and the deep star blocks
+     *
+     * Drawing and the searches lock it themselves. Code that calls
+     * starsInAperture() away from the GUI thread must hold it as long as
+     * it reads the returned stars, since drawing may recycle their blocks.
+     */
+    QMutex *mutex() { return &m_Mutex; }
+
 
     // TODO: Make byteSwap a template method and put it in byteorder.h
     // It should ideally handle 32-bit, 16-bit fields and starData and
@@ -199,6 +212,8 @@ private:
     QHash<int, StarObject*> m_HDHash;
     QVector<DeepStarComponent*> m_DeepStarComponents;
 
+    QMutex         m_Mutex;
+
     /**
      *@short adds a label to the lists of labels to be drawn prioritized
      *by magnitude.
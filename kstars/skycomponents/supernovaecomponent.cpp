@@ -127,6 +127,7 @@ void SupernovaeComponent::loadData()
         if(sup) objectLists(SkyObject::SUPERNOVA).append(QPair<QString, const SkyObject*>(serialNo, sup));
         objectNames(SkyObject::SUPERNOVA).append(serialNo);
     }
+    emitObjectNamesChanged();
     //notifyNewSupernovae();
 }
 
@@ -142,6 +143,12 @@ SkyObject* SupernovaeComponent::findByName(const QString& name)
     return 0;
 }
 
+void SupernovaeComponent::indexNames(QHash<QString, SkyObject*>& index)
+{
+    foreach (SkyObject* o, m_ObjectList)
+        indexName(index, o->name(), o);
+}
+
 SkyObject* SupernovaeComponent::objectNearest(SkyPoint* p, double& maxrad)
 {
     SkyObject* oBest=0;
@@ -46,6 +46,7 @@ public:
     virtual bool selected();
     virtual void update(KSNumbers* num = 0);
     virtual SkyObject* findByName(const QString& name);
+    virtual void indexNames(QHash<QString, SkyObject*>& index);
     virtual SkyObject* objectNearest(SkyPoint* p, double& maxrad);
 
     /**
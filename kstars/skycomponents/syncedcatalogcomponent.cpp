@@ -101,6 +101,7 @@ DeepSkyObject *SyncedCatalogComponent::addObject( CatalogEntryData catalogEntry
         objectLists()[ newObj->type() ].append( QPair<QString, const SkyObject *>(newObj->name(), newObj) );
     }
     m_ObjectList.append( newObj );
+    emitObjectNamesChanged();
     qDebug() << "Added new SkyObject " << newObj->name() << " to synced catalog " << m_catName << " which now contains " << m_ObjectList.count() << " objects.";
     return newObj;
 }
@@ -311,8 +311,9 @@ bool SkyGLPainter::drawDeepSkyObject(DeepSkyObject* obj, bool drawImage)
     }
 
     //Init texture if it doesn't exist and we would be drawing it anyways
-    if( drawImage  &&  !obj->image().isNull() ) {
-        drawTexturedRectangle( obj->image(), vec, pa, w, h);
+    QImage image = drawImage ? obj->image() : QImage();
+    if( !image.isNull() ) {
+        drawTexturedRectangle( image, vec, pa, w, h);
     } else {
         //If the buffer is full, flush it
         if(m_idx[type] == BUFSIZE)
@@ -141,7 +141,7 @@ SkyMap* SkyMap::Instance( )
 
 SkyMap::SkyMap() :
     QGraphicsView( KStars::Instance() ),
-    computeSkymap(true), rulerMode(false),
+    computeSkymap(true), computeAllLayers(true), rulerMode(false),
     data( KStarsData::Instance() ), pmenu(0),
     ClickedObject(0), FocusObject(0), m_proj(0),
     m_previewLegend(false), m_objPointingMode(false)
@@ -409,9 +409,9 @@ void SkyMap::slotUpdateSky( bool now ) {
     updateFocus();
 
     if ( now )
-        QTimer::singleShot( 0, this, SLOT( forceUpdateNow() ) ); // Why is it done this way rather than just calling forceUpdateNow()? -- asimha
+        QTimer::singleShot( 0, this, SLOT( forceTimeUpdateNow() ) ); // Why is it done this way rather than just calling forceUpdateNow()? -- asimha
     else
-        forceUpdate();
+        forceTimeUpdate();
 }
 
 void SkyMap::slotDSS() {
@@ -988,6 +988,9 @@ void SkyMap::slotZoomDefault() {
 
 void SkyMap::setZoomFactor(double factor) {
     Options::setZoomFactor(  KSUtils::clamp(factor, MINZOOM, MAXZOOM)  );
+    // Zoomed in, the coordinates may be too old for the new scale, as
+    // forceUpdate() keeps them
+    data->updateSky();
     forceUpdate();
     emit zoomChanged();
 }
@@ -995,7 +998,23 @@ void SkyMap::setZoomFactor(double factor) {
 // force a new calculation of the skymap (used instead of update(), which may skip the redraw)
 // if now=true, SkyMap::paintEvent() is run immediately, rather than being added to the event queue
 // also, determine new coordinates of mouse cursor.
+// The coordinates of the objects are kept: a change of the view does not change them.
 void SkyMap::forceUpdate( bool now )
+{
+    computeAllLayers = true;
+    forceTimeUpdate( now );
+}
+
+// same as forceUpdate(), but the stars also recompute their apparent and horizontal coordinates
+void SkyMap::forceCoordinateUpdate( bool now )
+{
+    data->incUpdateID();
+    forceUpdate( now );
+}
+
+// same as forceUpdate(), but the sky map may keep the layers which do not depend on time
+// KStarsData::updateTime() already invalidated the coordinates which depend on the time
+void SkyMap::forceTimeUpdate( bool now )
 {
     QPoint mp( mapFromGlobal( QCursor::pos() ) );
     if (! projector()->unusablePoint( mp )) {
@@ -1005,9 +1024,6 @@ void SkyMap::forceUpdate( bool now )
 
     computeSkymap = true;
 
-    // Ensure that stars are recomputed
-    data->incUpdateID();
-
     if( now )
         m_SkyMapDraw->repaint();
     else
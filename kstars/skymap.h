@@ -74,7 +74,7 @@ class SkyMap : public QGraphicsView {
     Q_OBJECT
 
     friend class SkyMapDrawAbstract; // FIXME: SkyMapDrawAbstract requires a lot of access to SkyMap
-    friend class SkyMapQDraw; // FIXME: SkyMapQDraw requires access to computeSkymap
+    friend class SkyMapQDraw; // FIXME: SkyMapQDraw requires access to computeSkymap and computeAllLayers
 
  protected:
     /**
@@ -293,10 +293,13 @@ class SkyMap : public QGraphicsView {
     SkyPoint getCenterPoint();
 
 public slots:
-    /** Recalculates the positions of objects in the sky, and then repaints the sky map.
-     * If the positions don't need to be recalculated, use update() instead of forceUpdate().
+    /** Recalculates the projection of the objects in the sky, and then repaints the sky map.
+     * This is for a change of the view or of what is drawn: the coordinates of the objects
+     * are reused, they only change with the time and the location, see KStarsData::updateTime().
+     * If nothing needs to be recalculated, use update() instead of forceUpdate().
      * This saves a lot of CPU time.
      * @param now if true, paintEvent() is run immediately.  Otherwise, it is added to the event queue
+     * @see forceCoordinateUpdate()
      */
     void forceUpdate( bool now=false );
 
@@ -305,9 +308,28 @@ public slots:
      */
     void forceUpdateNow() { forceUpdate( true ); }
 
+    /** @short Like forceUpdate(), but the stars also recompute their coordinates.
+     * Use it when an option changing the apparent coordinates of the stars was modified.
+     * @param now if true, paintEvent() is run immediately.  Otherwise, it is added to the event queue
+     */
+    void forceCoordinateUpdate( bool now=false );
+
+    /** @short Recalculates the sky map after the simulation time changed.
+     * Unlike forceUpdate(), the layers of the sky map which do not depend on the
+     * time are reused if the view did not change otherwise.
+     * @param now if true, paintEvent() is run immediately.  Otherwise, it is added to the event queue
+     * @see SkyMapQDraw
+     */
+    void forceTimeUpdate( bool now=false );
+
+    /** @short Convenience function; simply calls forceTimeUpdate(true).
+     * @see forceTimeUpdate()
+     */
+    void forceTimeUpdateNow() { forceTimeUpdate( true ); }
+
     /**
-     * @short Update the focus point and call forceUpdate()
-     * @param now is passed on to forceUpdate()
+     * @short Update the focus point and call forceTimeUpdate()
+     * @param now is passed on to forceTimeUpdate()
      */
     void slotUpdateSky( bool now );
 
@@ -611,6 +633,9 @@ private:
     //if false only old pixmap will repainted with bitBlt(), this
     // saves a lot of cpu usage
     bool computeSkymap;
+    // if false only the layers of the skymap which depend on time are
+    // recomputed, see SkyMapQDraw
+    bool computeAllLayers;
     // True if we are either looking for angular distance or star hopping directions
     bool rulerMode;
     // True only if we are looking for star hopping directions. If
@@ -22,6 +22,7 @@
 
 
 
+#include <QFontDatabase>
 #include <QPainter>
 #include <QPixmap>
 
@@ -33,6 +34,7 @@
 #include "kstarsdata.h"
 #include "ksnumbers.h"
 #include "ksutils.h"
+#include "auxiliary/frameprofiler.h"
 #include "skyobjects/skyobject.h"
 #include "skyobjects/deepskyobject.h"
 #include "skyobjects/starobject.h"
@@ -85,6 +87,9 @@ void SkyMapDrawAbstract::drawOverlays( QPainter& p, bool drawFov ) {
 
     drawZoomBox( p );
 
+    if ( Options::showFrameProfile() )
+        drawFrameProfile( p );
+
     // FIXME: Maybe we should take care of this differently. Maybe
     // drawOverlays should remain in SkyMap, since it just calls
     // certain drawing functions which are implemented in
@@ -104,6 +109,21 @@ void SkyMapDrawAbstract::drawAngleRuler( QPainter &p ) {
                m_SkyMap->m_proj->toScreen( m_SkyMap->AngularRuler.point(1) ) ); // FIXME: Again, AngularRuler should be something better -- maybe a class in itself. After all it's used for more than one thing after we integrate the StarHop feature.
 }
 
+void SkyMapDrawAbstract::drawFrameProfile( QPainter &p ) {
+    QString text = FrameProfiler::Instance()->report() + '\n' + SkyLabeler::Instance()->frameReport();
+
+    p.save();
+    p.setFont( QFontDatabase::systemFont( QFontDatabase::FixedFont ) );
+    QRect rect = p.fontMetrics().boundingRect( QRect( 0, 0, m_SkyMap->width(), m_SkyMap->height() ), Qt::AlignLeft | Qt::AlignTop, text );
+    rect.moveTopRight( QPoint( m_SkyMap->width() - 10, 10 ) );
+    QColor background = m_KStarsData->colorScheme()->colorNamed( "BoxBGColor" );
+    background.setAlpha( 160 );
+    p.fillRect( rect.adjusted( -4, -4, 4, 4 ), background );
+    p.setPen( m_KStarsData->colorScheme()->colorNamed( "BoxTextColor" ) );
+    p.drawText( rect, Qt::AlignLeft | Qt::AlignTop, text );
+    p.restore();
+}
+
 void SkyMapDrawAbstract::drawZoomBox( QPainter &p ) {
     //draw the manual zoom-box, if it exists
     if ( m_SkyMap->ZoomRect.isValid() ) {
@@ -365,6 +385,9 @@ void SkyMapDrawAbstract::exportSkyImage(SkyQPainter *painter, bool scale)
     m_KStarsData->skyComposite()->draw(painter);
     drawOverlays(*painter);
     painter->setVectorStars( vectorStarState ); // Restore the state of the painter
+
+    // The labels kept for the cached layers of the sky map were overwritten
+    m_SkyMap->computeAllLayers = true;
 }
 
 /* JM 2016-05-03: Not needed since we're not using OpenGL for now
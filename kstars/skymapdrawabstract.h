@@ -85,6 +85,13 @@ class SkyMapDrawAbstract {
     	*/
     void drawZoomBox( QPainter &psky );
 
+    /**
+    	*@short Draw the report of the frame profiler in the top right corner of the sky map.
+    	*@param psky reference to the QPainter on which to draw (this should be the Sky pixmap).
+    	*@see FrameProfiler
+    	*/
+    void drawFrameProfile( QPainter &psky );
+
     /**Draw a dashed line from the Angular-Ruler start point to the current mouse cursor,
     	*when in Angular-Ruler mode.
     	*@param psky reference to the QPainter on which to draw (this should be the Sky pixmap). 
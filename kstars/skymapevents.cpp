@@ -55,6 +55,7 @@
 void SkyMap::resizeEvent( QResizeEvent * )
 {
     computeSkymap = true; // skymap must be new computed
+    computeAllLayers = true;
 
     //FIXME: No equivalent for this line in Qt4 ??
     //	if ( testWState( Qt::WState_AutoMask ) ) updateMask();
@@ -329,7 +330,7 @@ void SkyMap::keyPressEvent( QKeyEvent *e )
             // Toggle relativistic corrections
             Options::setUseRelativistic( ! Options::useRelativistic() );
             qDebug() << "Relativistc corrections: " << Options::useRelativistic();
-            forceUpdate();
+            forceCoordinateUpdate();
             break;
         }
 
@@ -20,9 +20,23 @@
 #include "skymap.h"
 #include "projections/projector.h"
 #include "printing/legend.h"
+#include "Options.h"
+#include "skycomponents/skylabeler.h"
+#include "auxiliary/frameprofiler.h"
 
-SkyMapQDraw::SkyMapQDraw( SkyMap *sm ) : QWidget( sm ), SkyMapDrawAbstract( sm ) {
+#include <QThread>
+#include <QtConcurrent>
+
+// Largest shift, in pixels, of the stars and deep-sky objects kept from an
+// earlier frame in horizontal coordinates
+static const double MaxLayerShift = 1.0;
+
+SkyMapQDraw::SkyMapQDraw( SkyMap *sm ) : QWidget( sm ), SkyMapDrawAbstract( sm ), m_ProfilerFromOption( false ) {
     m_SkyPixmap = new QPixmap( width(), height() );
+    m_Layers.resize( SkyMapComposite::NumDrawLayers );
+    m_LayerValid.fill( false, SkyMapComposite::NumDrawLayers );
+    m_LayerLST.fill( 0.0, SkyMapComposite::NumDrawLayers );
+    m_View = currentView();
 }
 
 SkyMapQDraw::~SkyMapQDraw() {
@@ -60,28 +74,101 @@ void SkyMapQDraw::paintEvent( QPaintEvent *event ) {
             return ; // exit because the pixmap is repainted and that's all what we want
         }
 
+    FrameProfiler *profiler = FrameProfiler::Instance();
+    // Leave alone a profiling started over D-Bus
+    if ( Options::showFrameProfile() && !profiler->isEnabled() ) {
+        profiler->setEnabled( true );
+        m_ProfilerFromOption = true;
+    } else if ( !Options::showFrameProfile() && m_ProfilerFromOption ) {
+        profiler->setEnabled( false );
+        m_ProfilerFromOption = false;
+    }
+    profiler->beginFrame();
+
     // FIXME: used to to notify infobox about possible change of object coordinates
     // Not elegant at all. Should find better option
     m_SkyMap->showFocusCoords();
     m_SkyMap->setupProjector();
-    
-    SkyQPainter psky(this, m_SkyPixmap); 
-    //FIXME: we may want to move this into the components.
-    psky.begin();
-    
-    //Draw all sky elements
-    psky.drawSkyBackground();
+
+    // Find out which layers have to be redrawn
+    ViewState view = currentView();
+    if ( m_SkyMap->computeAllLayers || !( view == m_View ) ) {
+        m_LayerValid.fill( false );
+        m_View = view;
+        m_SkyMap->computeAllLayers = false;
+    }
+    double lst = m_KStarsData->lst()->Degrees();
+
+    SkyMapComposite *composite = m_KStarsData->skyComposite();
 
     // Set Clipping
     QPainterPath path;
     path.addPolygon(m_SkyMap->projector()->clipPoly());
-    psky.setClipPath(path);
-    psky.setClipping(true);
 
-    m_KStarsData->skyComposite()->draw( &psky );
-    //Finish up
-    psky.end();
-    
+    if ( composite->beginDraw() ) {
+        QVector<bool> redraw( SkyMapComposite::NumDrawLayers );
+        for ( int layer = 0; layer < SkyMapComposite::NumDrawLayers; ++layer ) {
+            redraw[ layer ] = !m_LayerValid[ layer ] || dependsOnTime( layer, m_LayerLST[ layer ], lst );
+            if ( !redraw[ layer ] )
+                continue;
+            QImage &image = m_Layers[ layer ];
+            if ( image.size() != size() )
+                image = QImage( size(), QImage::Format_ARGB32_Premultiplied );
+            image.fill( Qt::transparent );
+        }
+
+        // Draw the independent layers on the thread pool, while the GUI thread
+        // goes on with the layers which use the labeler.
+        QList<int> concurrentLayers;
+        if ( Options::parallelRendering() && QThread::idealThreadCount() > 1 ) {
+            for ( int layer = 0; layer < SkyMapComposite::NumDrawLayers; ++layer ) {
+                if ( redraw[ layer ] && SkyMapComposite::canDrawConcurrently( SkyMapComposite::DrawLayer( layer ) ) )
+                    concurrentLayers.append( layer );
+            }
+            // Not worth it for a single layer
+            if ( concurrentLayers.size() < 2 )
+                concurrentLayers.clear();
+        }
+        QImage *images = m_Layers.data();
+        QFuture<void> concurrentDraw;
+        if ( !concurrentLayers.isEmpty() ) {
+            composite->prepareConcurrentDraw();
+            concurrentDraw = QtConcurrent::map( concurrentLayers, [this, images, &path]( int layer ) {
+                drawLayer( layer, &images[ layer ], path );
+            } );
+        }
+
+        for ( int layer = 0; layer < SkyMapComposite::NumDrawLayers; ++layer ) {
+            // The labels of stars and deep-sky objects are only known once they are drawn
+            if ( layer == SkyMapComposite::SolarSystemLayer )
+                concurrentDraw.waitForFinished();
+
+            if ( !redraw[ layer ] ) {
+                // Keep the image, but the labels have to be drawn again in the same order
+                composite->drawLayerLabels( SkyMapComposite::DrawLayer( layer ) );
+                continue;
+            }
+            if ( !concurrentLayers.contains( layer ) )
+                drawLayer( layer, &images[ layer ], path );
+
+            m_LayerValid[ layer ] = true;
+            m_LayerLST[ layer ] = lst;
+        }
+        composite->endDraw();
+        profiler->addCount( "labels placed", SkyLabeler::Instance()->hits() );
+    }
+
+    {
+        FrameProfiler::Timer timer( "compose layers" );
+        QPainter pixmapPainter( m_SkyPixmap );
+        foreach( const QImage &image, m_Layers ) {
+            if ( !image.isNull() )
+                pixmapPainter.drawImage( 0, 0, image );
+        }
+        pixmapPainter.end();
+    }
+    profiler->endFrame();
+
     QPainter psky2;
     psky2.begin( this );
     psky2.drawLine(0,0,1,1); // Dummy op.
@@ -100,8 +187,87 @@ void SkyMapQDraw::paintEvent( QPaintEvent *event ) {
 
 }
 
+void SkyMapQDraw::drawLayer( int layer, QImage *image, const QPainterPath &clip ) {
+    SkyMapComposite *composite = m_KStarsData->skyComposite();
+
+    SkyQPainter psky( image, image->size() );
+    //FIXME: we may want to move this into the components.
+    psky.begin();
+
+    //Draw all sky elements
+    if ( layer == SkyMapComposite::BackgroundLayer )
+        psky.drawSkyBackground();
+
+    psky.setClipPath( clip );
+    psky.setClipping( true );
+
+    composite->drawLayer( SkyMapComposite::DrawLayer( layer ), &psky );
+    if ( layer == SkyMapComposite::SolarSystemLayer )
+        composite->drawLabels( &psky );
+
+    //Finish up
+    psky.end();
+}
+
 void SkyMapQDraw::resizeEvent( QResizeEvent *e ) {
     Q_UNUSED(e);
     delete m_SkyPixmap;
     m_SkyPixmap = new QPixmap( width(), height() );
+    m_LayerValid.fill( false );
+}
+
+SkyMapQDraw::ViewState SkyMapQDraw::currentView() const {
+    ViewState view;
+    SkyPoint *focus = m_SkyMap->focus();
+    // The sky drifts under a fixed horizontal focus, see dependsOnTime()
+    if ( Options::useAltAz() ) {
+        view.focusRA = focus ? focus->az().Degrees() : 0.0;
+        view.focusDec = focus ? focus->alt().Degrees() : 0.0;
+    } else {
+        view.focusRA = focus ? focus->ra().Degrees() : 0.0;
+        view.focusDec = focus ? focus->dec().Degrees() : 0.0;
+    }
+    view.width = width();
+    view.height = height();
+    view.zoomFactor = Options::zoomFactor();
+    view.projection = Options::projection();
+    view.useAltAz = Options::useAltAz();
+    view.useRefraction = Options::useRefraction();
+    view.showGround = Options::showGround();
+    view.updateNumID = m_KStarsData->updateNumID();
+    return view;
+}
+
+bool SkyMapQDraw::ViewState::operator==( const ViewState &other ) const {
+    return focusRA == other.focusRA && focusDec == other.focusDec &&
+        width == other.width && height == other.height &&
+        zoomFactor == other.zoomFactor && projection == other.projection &&
+        useAltAz == other.useAltAz && useRefraction == other.useRefraction &&
+        showGround == other.showGround && updateNumID == other.updateNumID;
+}
+
+bool SkyMapQDraw::dependsOnTime( int layer, double layerLST, double lst ) const {
+    switch ( layer ) {
+    case SkyMapComposite::SolarSystemLayer:
+    case SkyMapComposite::ForegroundLayer:
+        // Solar system bodies, satellites and the horizon move all the time
+        return true;
+    default: {
+        double turn = qAbs( lst - layerLST );
+        if ( turn > 180.0 )
+            turn = 360.0 - turn;
+        // The sky turns on the screen in horizontal coordinates. No point
+        // moves farther than the turn of the sky, so the layer is kept
+        // until it would be off by more than MaxLayerShift pixels.
+        if ( Options::useAltAz() )
+            return turn * dms::DegToRad * Options::zoomFactor() > MaxLayerShift;
+        if ( layer == SkyMapComposite::BackgroundLayer && Options::showHorizontalGrid() )
+            return true;
+        // Objects more than 1 degree below the horizon are not drawn when the
+        // ground is filled, and the ground hides the objects down to that margin.
+        if ( Options::showGround() )
+            return turn >= 1.0;
+        return false;
+    }
+    }
 }
@@ -20,11 +20,28 @@
 
 #include "skymapdrawabstract.h"
 
+#include<QImage>
+#include<QPainterPath>
+#include<QVector>
 #include<QWidget>
 
 /**
  *@short This class draws the SkyMap using native QPainter. It
  * implements SkyMapDrawAbstract
+ *
+ * Each layer of the sky map (see SkyMapComposite::DrawLayer) is
+ * drawn into its own image, and the images are composited into the
+ * sky pixmap. When the sky map is recomputed because the simulation
+ * time changed (SkyMap::forceTimeUpdate()), only the layers which
+ * depend on time are redrawn, as long as the focus, zoom, size and
+ * projection did not change. In equatorial coordinates, the deep-sky
+ * and star layers are kept until the sky has turned by 1 degree, the
+ * margin below the horizon within which objects are still drawn. In
+ * horizontal coordinates, they are kept until the sky has turned by
+ * about a pixel on the screen.
+ *
+ * With the ParallelRendering option, the layers which do not place
+ * labels are drawn concurrently on the thread pool.
  *@version 1.0
  *@author Akarsh Simha <akarsh.simha@kdemail.net>
  */
@@ -51,7 +68,46 @@ class SkyMapQDraw : public QWidget, public SkyMapDrawAbstract {
     virtual void resizeEvent( QResizeEvent *e );
 
     QPixmap *m_SkyPixmap;
-    
+
+ private:
+    /**
+     *@short The view parameters all the layers depend on
+     */
+    struct ViewState {
+        double focusRA, focusDec;  // azimuth and altitude in horizontal coordinates
+        int width, height;
+        double zoomFactor;
+        int projection;
+        bool useAltAz, useRefraction, showGround;
+        unsigned int updateNumID;
+
+        bool operator==( const ViewState &other ) const;
+    };
+
+    /**
+     *@return the current view parameters
+     */
+    ViewState currentView() const;
+
+    /**
+     *@return true if the given layer, drawn when the local sidereal time was
+     * @p layerLST, must be redrawn at the local sidereal time @p lst
+     */
+    bool dependsOnTime( int layer, double layerLST, double lst ) const;
+
+    /**
+     *@short Draw one layer of the sky map into its image
+     * This runs on the thread pool for the layers which
+     * SkyMapComposite::canDrawConcurrently(), if parallel rendering is enabled.
+     */
+    void drawLayer( int layer, QImage *image, const QPainterPath &clip );
+
+    QVector<QImage> m_Layers;      // one image per SkyMapComposite::DrawLayer
+    QVector<bool> m_LayerValid;
+    QVector<double> m_LayerLST;    // LST in degrees when each layer was drawn
+    ViewState m_View;              // view the layers were drawn with
+    bool m_ProfilerFromOption;     // the frame profiler was enabled by the ShowFrameProfile option
+
 };
 
 #endif
@@ -27,8 +27,6 @@ ConstellationsArt::ConstellationsArt(dms midpointra, dms midpointdec, double pa,
     width = w;
     height = h;
 
-    //loadImage();
-
     //This sets both current and J2000 RA/DEC to the values ra and dec.
     setRA(midpointra);
     setDec(midpointdec);
@@ -38,8 +36,7 @@ ConstellationsArt::~ConstellationsArt()
 {
 }
 
-void ConstellationsArt::loadImage()
+QImage ConstellationsArt::image( int size )
 {
-    constellationArtImage = TextureManager::getImage( imageFileName );
-    imageLoaded=true;
+    return TextureManager::requestImage( imageFileName, size );
 }
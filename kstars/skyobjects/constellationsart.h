@@ -47,9 +47,7 @@ class ConstellationsArt: public SkyObject{
 
 private:
     QString abbrev, imageFileName;
-    QImage constellationArtImage;
     double positionAngle, width, height;
-    bool imageLoaded=false;
 
 public:
 
@@ -68,11 +66,13 @@ public:
     /** *Destructor */
      ~ConstellationsArt();
 
-    /** @return an object's image */
-    const QImage& image() { if (imageLoaded) return constellationArtImage; else { loadImage(); return constellationArtImage;}}
-
-    /** Load the object's image. This also scales the object's image to 1024x1024 pixels. */
-    void loadImage();
+    /**
+     * @return an object's image, or a null image while it is being loaded
+     * @param size the size of the image on screen, in pixels. A downscaled image
+     * may be returned, 0 requests the full image.
+     * @see TextureManager::requestImage()
+     */
+    QImage image( int size = 0 );
 
     /** @return an object's abbreviation */
     inline QString getAbbrev() const { return abbrev;}
@@ -43,7 +43,7 @@
 DeepSkyObject::DeepSkyObject( const DeepSkyObject &o )
     : SkyObject( o )
     , PositionAngle( o.PositionAngle )
-    , m_image( o.m_image )
+    , m_textureName( o.m_textureName )
     , UGC( o.UGC )
     , PGC( o.PGC )
     , MajorAxis( o.MajorAxis )
@@ -71,9 +71,6 @@ DeepSkyObject::DeepSkyObject( int t, dms r, dms d, float m,
     updateID = updateNumID = 0;
     customCat = NULL;
     Flux = 0;
-
-    // Disable image loading on init
-    //loadImage();
 }
 
 DeepSkyObject::DeepSkyObject( const CatalogEntryData &data, CatalogComponent *cat )
@@ -101,9 +98,6 @@ DeepSkyObject::DeepSkyObject( const CatalogEntryData &data, CatalogComponent *ca
     updateID = updateNumID = 0;
     customCat = cat;
     Flux = data.flux;
-
-    // Disable image loading on init
-    //loadImage();
 }
 
 DeepSkyObject* DeepSkyObject::clone() const
@@ -138,11 +132,11 @@ void DeepSkyObject::setCatalog( const QString &cat ) {
     else Catalog = (unsigned char)CAT_UNKNOWN;
 }
 
-void DeepSkyObject::loadImage()
+QImage DeepSkyObject::image( int size )
 {
-    QString tname = name().toLower().remove(' ');
-    m_image = TextureManager::getImage( tname );
-    imageLoaded=true;
+    if ( m_textureName.isEmpty() )
+        m_textureName = name().toLower().remove(' ');
+    return TextureManager::requestImage( m_textureName, size );
 }
 
 double DeepSkyObject::labelOffset() const {
@@ -160,11 +160,13 @@ public:
     	*/
     inline int pgc() const { return PGC; }
 
-    /** @return an object's image */
-    const QImage& image() { if (imageLoaded) return m_image; else { loadImage(); return m_image;} }
-
-    /** Try to load the object's image */
-    void loadImage();
+    /**
+     * @return an object's image, or a null image while it is being loaded
+     * @param size the size of the image on screen, in pixels. A downscaled image
+     * may be returned, 0 requests the full image.
+     * @see TextureManager::requestImage()
+     */
+    QImage image( int size = 0 );
 
     /**
       *@return true if the object is in the Messier catalog
@@ -199,7 +201,7 @@ private:
 
 
     double PositionAngle;
-    QImage m_image;
+    QString m_textureName; // name of the object's image, set on first use
     QList<const SkyObject *> m_Parents; // Q: Should we use KStars UUIDs, DB UUIDs, or SkyObject * pointers? Q: Should we extend this to stars? -- asimha
     QList<const SkyObject *> m_Children; // Q: Should we use KStars UUIDs, DB UUIDs, or SkyObject * pointers? Q: Should we extend this to stars? -- asimha
     QStringList m_AlternateDesignations; // Alternate names. FIXME: These should be superseded by designation UIDs in the database
@@ -210,7 +212,6 @@ private:
     int UGC, PGC;
     float MajorAxis, MinorAxis, Flux;
     unsigned char Catalog;
-    bool imageLoaded=false;
 };
 
 #endif
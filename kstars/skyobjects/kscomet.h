@@ -130,7 +130,7 @@ public:
     /**
      *@return the estimated angular size of the tail as a dms
      */
-    inline dms getTailAngSize() { return dms( TailAngSize ); }
+    inline dms getTailAngSize() const { return dms( TailAngSize ); }
 
     /**
      *@return the estimated diameter of the nucleus in km
@@ -32,6 +32,8 @@
 #include "ksutils.h"
 #include "kssun.h"
 #include "kstarsdata.h"
+#include "chebyshevcache.h"
+#include "Options.h"
 #ifndef KSTARS_LITE
 #include "kspopupmenu.h"
 #endif
@@ -69,7 +71,7 @@ namespace {
 KSMoon::KSMoon()
         : KSPlanetBase( I18N_NOOP( "Moon" ), QString(), QColor("white"), 3474.8 /*diameter in km*/ )
 {
-    instance_count++;
+    instance_count.ref();
     //Reset object type
     setType( SkyObject::MOON );
 }
@@ -77,7 +79,7 @@ KSMoon::KSMoon()
 KSMoon::KSMoon(const KSMoon& o) :
     KSPlanetBase(o)
 {
-    instance_count++;
+    instance_count.ref();
 }
 
 KSMoon* KSMoon::clone() const
@@ -87,8 +89,8 @@ KSMoon* KSMoon::clone() const
 }
 
 KSMoon::~KSMoon() {
-    instance_count--;
-    if(instance_count <= 0) {
+    // Clones may be created and destroyed on worker threads (e.g. by KSConjunct)
+    if( !instance_count.deref() ) {
         LRData.clear();
         BData.clear();
         data_loaded = false;
@@ -96,9 +98,11 @@ KSMoon::~KSMoon() {
 }
 
 bool KSMoon::data_loaded = false;
-int KSMoon::instance_count = 0;
+QAtomicInt KSMoon::instance_count = 0;
 QList<KSMoon::MoonLRData> KSMoon::LRData;
 QList<KSMoon::MoonBData> KSMoon::BData;
+// Segments of two days, in Julian centuries
+ChebyshevCache KSMoon::cache( 2.0 / 36525.0, 12 );
 
 
 bool KSMoon::loadData() {
@@ -150,20 +154,41 @@ bool KSMoon::loadData() {
 }
 
 bool KSMoon::findGeocentricPosition( const KSNumbers *num, const KSPlanetBase* ) {
+    double values[3];
+
+    if (!loadData()) return false;
+
+    if ( Options::cacheEphemerides() )
+        cache.evaluate( num->julianCenturies(), values, &KSMoon::calcSeries );
+    else
+        calcSeries( num->julianCenturies(), values );
+
+    //Geocentric coordinates
+    setEcLong( dms( values[0] ).reduce() );
+    setEcLat(  dms( values[1] ) );
+    Rearth = values[2];
+
+    EclipticToEquatorial( num->obliquity() );
+
+    //Determine position angle
+    findPA( num );
+
+    return true;
+}
+
+void KSMoon::calcSeries( double T, double *values ) {
     //Algorithms in this subroutine are taken from Chapter 45 of "Astronomical Algorithms"
     //by Jean Meeus (1991, Willmann-Bell, Inc. ISBN 0-943396-35-2.  http://www.willbell.com/math/mc1.htm)
     //updated to Jean Messus (1998, Willmann-Bell, http://www.naughter.com/aa.html )
 
-    double T, L, D, M, M1, F, A1, A2, A3;
+    double L0, L, D, M, M1, F, A1, A2, A3;
     double sumL, sumR, sumB;
 
-    //Julian centuries since J2000
-    T = num->julianCenturies();
-
     double Et = 1.0 - 0.002516*T - 0.0000074*T*T;
 
-    //Moon's mean longitude
-    L = degToRad( 218.3164477 + 481267.88123421*T - 0.0015786*T*T + T*T*T/538841.0 - T*T*T*T/65194000.0 );
+    //Moon's mean longitude, in degrees. It is kept continuous for the ChebyshevCache.
+    L0 = 218.3164477 + 481267.88123421*T - 0.0015786*T*T + T*T*T/538841.0 - T*T*T*T/65194000.0;
+    L = degToRad( L0 );
     //Moon's mean elongation
     D = degToRad( 297.8501921 + 445267.1114034*T - 0.0018819*T*T + T*T*T/545868.0 - T*T*T*T/113065000.0 );
     //Sun's mean anomaly
@@ -182,8 +207,6 @@ bool KSMoon::findGeocentricPosition( const KSNumbers *num, const KSPlanetBase* )
     sumL = 0.0;
     sumR = 0.0;
 
-    if (!loadData()) return false;
-
     for ( int i=0; i < LRData.size(); ++i ) {
         const MoonLRData& mlrd = LRData[i];
 
@@ -212,17 +235,10 @@ bool KSMoon::findGeocentricPosition( const KSNumbers *num, const KSPlanetBase* )
     sumL += ( 3958.0*sin( A1 ) + 1962.0*sin( L-F ) + 318.0*sin( A2 ) );
     sumB += ( -2235.0*sin( L ) + 382.0*sin( A3 ) + 175.0*sin( A1-F ) + 175.0*sin( A1+F ) + 127.0*sin( L-M1 ) - 115.0*sin( L+M1 ) );
 
-    //Geocentric coordinates
-    setEcLong( dms( sumL/1000000.0 + L * 180.0 / dms::PI) ); //convert radians to degrees
-    setEcLat(  dms( sumB/1000000.0 ) );
-    Rearth = ( 385000.56 + sumR/1000.0 )/AU_KM; //distance from Earth, in AU
-
-    EclipticToEquatorial( num->obliquity() );
-
-    //Determine position angle
-    findPA( num );
-
-    return true;
+    //Geocentric ecliptic longitude and latitude in degrees, and distance from Earth in AU
+    values[0] = sumL/1000000.0 + L0;
+    values[1] = sumB/1000000.0;
+    values[2] = ( 385000.56 + sumR/1000.0 )/AU_KM;
 }
 
 void KSMoon::findMagnitude(const KSNumbers*)
@@ -18,7 +18,10 @@
 #ifndef KSMOON_H_
 #define KSMOON_H_
 
+#include <QAtomicInt>
+
 #include "ksplanetbase.h"
+#include "chebyshevcache.h"
 #include "dms.h"
 
 /** @class KSMoon
@@ -95,7 +98,7 @@ private:
     virtual void findMagnitude(const KSNumbers*);
 
     static bool data_loaded;
-    static int instance_count;
+    static QAtomicInt instance_count;
 
     /** @class MoonLRData
      * Encapsulates the Longitude and radius terms of the sums
@@ -131,6 +134,16 @@ private:
     };
 
     static QList<MoonBData> BData;
+
+    /** Sum the lunar series.
+     * @param T Julian centuries since J2000
+     * @param values the geocentric ecliptic longitude (not reduced) and latitude, in degrees,
+     * and the distance from Earth, in AU, are returned in this array
+     */
+    static void calcSeries( double T, double *values );
+
+    /** Chebyshev approximation of calcSeries(), used unless disabled by the CacheEphemerides option */
+    static ChebyshevCache cache;
     unsigned int iPhase;
 };
 
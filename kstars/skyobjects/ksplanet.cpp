@@ -25,10 +25,13 @@
 #include <QTextStream>
 
 #include <QDebug>
+#include <QMutexLocker>
 
 #include "ksnumbers.h"
 #include "ksutils.h"
 #include "ksfilereader.h"
+#include "chebyshevcache.h"
+#include "Options.h"
 
 KSPlanet::OrbitDataManager KSPlanet::odm;
 
@@ -39,6 +42,26 @@ KSPlanet::OrbitDataManager::OrbitDataManager() {
     //EMPTY
 }
 
+KSPlanet::OrbitDataManager::~OrbitDataManager() {
+    qDeleteAll( caches );
+}
+
+ChebyshevCache *KSPlanet::OrbitDataManager::cache( const QString &n, const OrbitDataColl &odc ) {
+    QString nl = n.toLower();
+    QMutexLocker locker( &mutex );
+
+    ChebyshevCache *c = caches.value( nl );
+    if ( ! c ) {
+        // The leading term of the L1 series is the mean motion of the planet, in radians per millennium
+        double period = 10.0 / 365250.0;
+        if ( odc.Lon[1].size() && odc.Lon[1][0].A > 0.0 )
+            period = 2.0 * dms::PI / odc.Lon[1][0].A;
+        c = new ChebyshevCache( period / 8.0, 12 );
+        caches.insert( nl, c );
+    }
+    return c;
+}
+
 bool KSPlanet::OrbitDataManager::readOrbitData(const QString &fname,
         QVector<OrbitData> *vector)
 {
@@ -69,6 +92,9 @@ bool KSPlanet::OrbitDataManager::loadData( KSPlanet::OrbitDataColl &odc, const Q
     int nCount = 0;
     QString nl = n.toLower();
 
+    // The data may be requested from several threads, e.g. by KSConjunct
+    QMutexLocker locker( &mutex );
+
     if ( hash.contains( nl ) ) {
         odc = hash[nl];
         return true;  //orbit data already loaded
@@ -182,14 +208,8 @@ bool KSPlanet::loadData() {
 }
 
 void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const {
-    double sum[6];
     OrbitDataColl odc;
-    double Tpow[6];
-
-    Tpow[0] = 1.0;
-    for (int i=1; i<6; ++i) {
-        Tpow[i] = Tpow[i-1] * Tau;
-    }
+    double values[3];
 
     if ( ! odm.loadData( odc, untranslatedName() ) ) {
         epret.longitude = dms(0.0);
@@ -199,23 +219,44 @@ void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const {
         return;
     }
 
+    if ( Options::cacheEphemerides() ) {
+        ChebyshevCache *cache = odm.cache( untranslatedName(), odc );
+        cache->evaluate( Tau, values, [&odc]( double t, double *v ) { calcSeries( odc, t, v ); } );
+    } else {
+        calcSeries( odc, Tau, values );
+    }
+
+    epret.longitude.setRadians( values[0] );
+    epret.longitude.setD( epret.longitude.reduce().Degrees() );
+    epret.latitude.setRadians( values[1] );
+    epret.radius = values[2];
+
+    /*
+    qDebug() << name() << " pre: Lat = " << epret.latitude.toDMSString() << " Long = " <<
+    	epret.longitude.toDMSString() << " Dist = " << epret.radius << endl;
+    */
+
+}
+
+void KSPlanet::calcSeries( const OrbitDataColl &odc, double Tau, double *values ) {
+    double sum[6];
+    double Tpow[6];
+
+    Tpow[0] = 1.0;
+    for (int i=1; i<6; ++i) {
+        Tpow[i] = Tpow[i-1] * Tau;
+    }
+
     //Ecliptic Longitude
     for (int i=0; i<6; ++i) {
         sum[i] = 0.0;
         for (int j = 0; j < odc.Lon[i].size(); ++j) {
             sum[i] += odc.Lon[i][j].A * cos( odc.Lon[i][j].B + odc.Lon[i][j].C*Tau );
-            /*
-            qDebug() << "sum[" << i <<"] =" << sum[i] <<
-            	" A = " << odc.Lon[i][j].A << " B = " << odc.Lon[i][j].B <<
-            	" C = " << odc.Lon[i][j].C << endl;
-            	*/
         }
         sum[i] *= Tpow[i];
-        //qDebug() << name() << " : sum[" << i << "] = " << sum[i];
     }
 
-    epret.longitude.setRadians( sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5] );
-    epret.longitude.setD( epret.longitude.reduce().Degrees() );
+    values[0] = sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5];
 
     //Compute Ecliptic Latitude
     for (uint i=0; i<6; ++i) {
@@ -226,8 +267,7 @@ void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const {
         sum[i] *= Tpow[i];
     }
 
-
-    epret.latitude.setRadians( sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5] );
+    values[1] = sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5];
 
     //Compute Heliocentric Distance
     for (uint i=0; i<6; ++i) {
@@ -238,13 +278,7 @@ void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const {
         sum[i] *= Tpow[i];
     }
 
-    epret.radius = sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5];
-
-    /*
-    qDebug() << name() << " pre: Lat = " << epret.latitude.toDMSString() << " Long = " <<
-    	epret.longitude.toDMSString() << " Dist = " << epret.radius << endl;
-    */
-
+    values[2] = sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5];
 }
 
 bool KSPlanet::findGeocentricPosition( const KSNumbers *num, const KSPlanetBase *Earth ) {
@@ -20,10 +20,13 @@
 
 #include <QVector>
 #include <QHash>
+#include <QMutex>
 
 #include "ksplanetbase.h"
 #include "dms.h"
 
+class ChebyshevCache;
+
 /** @class KSPlanet
  *A subclass of KSPlanetBase for seven of the major planets in the solar system
  *(Earth and Pluto have their own specialized classes derived from KSPlanetBase).  
@@ -78,6 +81,8 @@ public:
     /** Calculate the ecliptic longitude and latitude of the planet for
     	*the given date (expressed in Julian Millenia since J2000).  A reference
     	*to the ecliptic coordinates is returned as the second object.
+    	*@note Unless disabled by the CacheEphemerides option, the result is
+    	*interpolated from Chebyshev polynomials fitted to the series, see ChebyshevCache.
     	*@param jm Julian Millenia (=jd/1000)
     	*@param ret The ecliptic coordinates are returned by reference through this argument.
     	*/
@@ -142,6 +147,14 @@ protected:
         OBArray Dst;
     };
 
+    /** Sum the VSOP87 series of a planet.
+    	*@param odc the orbital data of the planet
+    	*@param Tau Julian Millenia since J2000
+    	*@param values the ecliptic longitude (not reduced) and latitude, in radians,
+    	*and the distance from the Sun, in AU, are returned in this array
+    	*/
+    static void calcSeries( const OrbitDataColl &odc, double Tau, double *values );
+
 
     /** OrbitDataManager places the OrbitDataColl objects for all planets in a QDict
     	*indexed by the planets' names.  It also loads the positional data of each planet
@@ -164,6 +177,16 @@ protected:
         	*/
         bool loadData( OrbitDataColl &odc, const QString &n);
 
+        /** Destructor. Deletes the ephemeris caches. */
+        ~OrbitDataManager();
+
+        /** @return the ephemeris cache of a planet, created on first use.
+        	*The segments of the cache cover an eighth of the period of the planet.
+        	*@param n the name of the planet
+        	*@param odc the orbital data of the planet, used to find its mean motion
+        	*/
+        ChebyshevCache *cache( const QString &n, const OrbitDataColl &odc );
+
     private:
         /** Read a single orbital data file from disk into an OrbitData vector.
         *The data files are named "name.[LBR][0...5].vsop", where 
@@ -174,6 +197,8 @@ protected:
         bool readOrbitData(const QString &fname, QVector<KSPlanet::OrbitData> *vector);
 
         QHash<QString, OrbitDataColl> hash;
+        QHash<QString, ChebyshevCache*> caches;
+        QMutex mutex;
     };
 
     static OrbitDataManager odm;
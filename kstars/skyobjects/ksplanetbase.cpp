@@ -107,20 +107,30 @@ void KSPlanetBase::updateCoords( const KSNumbers *num, bool includePlanets, cons
 {
     KStarsData *kd = KStarsData::Instance();
     if ( includePlanets ) {
-        kd->skyComposite()->earth()->findPosition( num ); //since we don't pass lat & LST, localizeCoords will be skipped
+        // Use a copy of the Earth, so that the Earth of the sky map keeps its current position.
+        // This also allows computing positions of clones from worker threads (e.g. SkyCalendar).
+        KSPlanet earth( *kd->skyComposite()->earth() );
+        earth.findPositionOnly( num ); //since we don't pass lat & LST, localizeCoords will be skipped
 
         if ( lat && LST ) {
-            findPosition( num, lat, LST, kd->skyComposite()->earth() );
+            findPosition( num, lat, LST, &earth );
             //Don't add to the trail this time
             if( hasTrail() )
                 Trail.takeLast();
         } else {
-            findGeocentricPosition( num, kd->skyComposite()->earth() );
+            findGeocentricPosition( num, &earth );
         }
     }
 }
 
 void KSPlanetBase::findPosition( const KSNumbers *num, const CachingDms *lat, const CachingDms *LST, const KSPlanetBase *Earth ) {
+    findPositionWithoutTrail( num, lat, LST, Earth );
+
+    if ( hasTrail() )
+        addTrailPoint( num );
+}
+
+void KSPlanetBase::findPositionWithoutTrail( const KSNumbers *num, const CachingDms *lat, const CachingDms *LST, const KSPlanetBase *Earth ) {
     // DEBUG edit
     findGeocentricPosition( num, Earth );  //private function, reimplemented in each subclass
     findPhase();
@@ -129,12 +139,6 @@ void KSPlanetBase::findPosition( const KSNumbers *num, const CachingDms *lat, co
     if ( lat && LST )
         localizeCoords( num, lat, LST ); //correct for figure-of-the-Earth
 
-    if ( hasTrail() ) {
-        addToTrail( KStarsDateTime( num->getJD() ).toString( "yyyy.MM.dd hh:mm" ) + i18nc("Universal time", "UT") ); // TODO: Localize date/time format?
-        if ( Trail.size() > TrailObject::MaxTrail )
-            clipTrail();
-    }
-
     findMagnitude(num);
 
     if ( type() == SkyObject::COMET ) {
@@ -149,6 +153,36 @@ void KSPlanetBase::findPosition( const KSNumbers *num, const CachingDms *lat, co
 
 }
 
+void KSPlanetBase::copyPosition( const KSPlanetBase &other, const KSNumbers *num ) {
+    SkyPoint::operator=( other );
+    ep = other.ep;
+    helEcPos = other.helEcPos;
+    Rearth = other.Rearth;
+    Phase = other.Phase;
+    PositionAngle = other.PositionAngle;
+    AngularSize = other.AngularSize;
+    setMag( other.mag() );
+
+    if ( type() == SkyObject::COMET )
+        ((KSComet *)this)->setTailAngSize( static_cast<const KSComet &>( other ).getTailAngSize().Degrees() );
+
+    if ( hasTrail() )
+        addTrailPoint( num );
+}
+
+void KSPlanetBase::addTrailPoint( const KSNumbers *num ) {
+    addToTrail( KStarsDateTime( num->getJD() ).toString( "yyyy.MM.dd hh:mm" ) + i18nc("Universal time", "UT") ); // TODO: Localize date/time format?
+    if ( Trail.size() > TrailObject::MaxTrail )
+        clipTrail();
+}
+
+void KSPlanetBase::findPositionOnly( const KSNumbers *num, const CachingDms *lat, const CachingDms *LST, const KSPlanetBase *Earth ) {
+    findGeocentricPosition( num, Earth );
+
+    if ( lat && LST )
+        localizeCoords( num, lat, LST );
+}
+
 bool KSPlanetBase::isMajorPlanet() const {
     if ( name() == i18n( "Mercury" ) || name() == i18n( "Venus" ) || name() == i18n( "Mars" ) ||
          name() == i18n( "Jupiter" ) || name() == i18n( "Saturn" ) || name() == i18n( "Uranus" ) ||
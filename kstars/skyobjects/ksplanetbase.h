@@ -158,6 +158,34 @@ public:
      */
     void findPosition( const KSNumbers *num, const CachingDms *lat=0, const CachingDms *LST=0, const KSPlanetBase *Earth = 0 );
 
+    /** @short Find position only, including correction for Figure-of-the-Earth.
+     * Unlike findPosition(), the phase, magnitude, texture and trail are left untouched, so this
+     * is cheaper and does not access any global state. It is meant for searches that evaluate
+     * positions many times, possibly on private clones from worker threads.
+     * @param num KSNumbers pointer for the target date/time
+     * @param lat pointer to the geographic latitude; if NULL, we skip localizeCoords()
+     * @param LST pointer to the local sidereal time; if NULL, we skip localizeCoords()
+     * @param Earth pointer to the Earth (not used for the Moon)
+     */
+    void findPositionOnly( const KSNumbers *num, const CachingDms *lat=0, const CachingDms *LST=0, const KSPlanetBase *Earth = 0 );
+
+    /** @short Find position, phase, angular size and magnitude, but leave the trail untouched.
+     * Only this object is modified, so this may run on a private clone from a worker thread;
+     * copyPosition() then hands the result over to the body shown in the sky map.
+     * @param num KSNumbers pointer for the target date/time
+     * @param lat pointer to the geographic latitude; if NULL, we skip localizeCoords()
+     * @param LST pointer to the local sidereal time; if NULL, we skip localizeCoords()
+     * @param Earth pointer to the Earth (not used for the Moon)
+     */
+    void findPositionWithoutTrail( const KSNumbers *num, const CachingDms *lat=0, const CachingDms *LST=0, const KSPlanetBase *Earth = 0 );
+
+    /** @short Take over what findPositionWithoutTrail() computed for @p other, a clone of this body,
+     * and add the new position to the trail like findPosition() does.
+     * @param other the clone whose position was found
+     * @param num KSNumbers pointer for the date/time of that position
+     */
+    void copyPosition( const KSPlanetBase &other, const KSNumbers *num );
+
     /** @return the Planet's position angle. */
     virtual double pa() const { return PositionAngle; }
 
@@ -255,6 +283,9 @@ private:
      */
     void localizeCoords( const KSNumbers *num, const CachingDms *lat, const CachingDms *LST );
 
+    /** @short Add the current position to the trail, labelled with the date/time of @p num */
+    void addTrailPoint( const KSNumbers *num );
+
     double PositionAngle, AngularSize, PhysicalSize;
     QColor m_Color;
 };
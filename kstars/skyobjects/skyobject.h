@@ -269,8 +269,10 @@ public:
      *@param dt  date/time for which the coords will be computed.
      *@param geo pointer to geographic location (used for solar system only)
      *@note Does not update the horizontal coordinates. Call EquatorialToHorizontal for that.
+     *@note The rise, set and transit times are computed from this, so a subclass may
+     *reimplement it to compute the coordinates another way.
      */
-    SkyPoint recomputeCoords( const KStarsDateTime &dt, const GeoLocation *geo=0 ) const;
+    virtual SkyPoint recomputeCoords( const KStarsDateTime &dt, const GeoLocation *geo=0 ) const;
 
     /**
      * @short Like recomputeCoords, but also calls EquatorialToHorizontal before returning
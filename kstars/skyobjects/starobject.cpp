@@ -294,7 +294,7 @@ void StarObject::updateCoords( const KSNumbers *num, bool , const CachingDms*, c
 
 bool StarObject::getIndexCoords( const KSNumbers *num, CachingDms &ra, CachingDms &dec )
 {
-    static double pmms;
+    double pmms;
 
     // =================== NOTE: CODE DUPLICATION ====================
     // If you modify this, please also modify the other getIndexCoords
@@ -372,7 +372,7 @@ bool StarObject::getIndexCoords( const KSNumbers *num, CachingDms &ra, CachingDm
 
 bool StarObject::getIndexCoords( const KSNumbers *num, double *ra, double *dec )
 {
-    static double pmms;
+    double pmms;
 
     // =================== NOTE: CODE DUPLICATION ====================
     // If you modify this, please also modify the other getIndexCoords
@@ -41,6 +41,7 @@
 #include "ksutils.h"
 
 #include <QMap>
+#include <QtMath>
 #include <QWidget>
 
 #include <functional>
@@ -71,8 +72,9 @@ namespace {
 
     // Cache for star images.
     //
-    // These pixmaps are never deallocated. Not really good...
-    QPixmap* imageCache[nSPclasses][nStarSizes] = {{0}};
+    // These images are never deallocated. Not really good...
+    // QImage rather than QPixmap so that sky map layers may be painted from worker threads.
+    QImage* imageCache[nSPclasses][nStarSizes] = {{0}};
 }
 
 int SkyQPainter::starColorMode = 0;
@@ -181,7 +183,7 @@ void SkyQPainter::initStarImages()
     }
 
     foreach( char color, ColorMap.keys() ) {
-        QPixmap BigImage( 15, 15 );
+        QImage BigImage( 15, 15, QImage::Format_ARGB32_Premultiplied );
         BigImage.fill( Qt::transparent );
 
         QPainter p;
@@ -217,10 +219,10 @@ void SkyQPainter::initStarImages()
         p.end();
 
         // Cache array slice
-        QPixmap** pmap = imageCache[ harvardToIndex(color) ];
+        QImage** pmap = imageCache[ harvardToIndex(color) ];
         for( int size = 1; size < nStarSizes; size++ ) {
             if( !pmap[size] )
-                pmap[size] = new QPixmap();
+                pmap[size] = new QImage();
             *pmap[size] = BigImage.scaled( size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation );
         }
     }
@@ -250,50 +252,69 @@ void SkyQPainter::drawSkyLine(SkyPoint* a, SkyPoint* b)
     } //FIXME: what if both are offscreen but the line isn't?
 }
 
-void SkyQPainter::drawSkyPolyline(LineList* list, SkipList* skipList, LineListLabel* label)
+void SkyQPainter::projectLineList(LineList* list)
 {
     SkyList *points = list->points();
-    bool isVisible, isVisibleLast;
-
-    QPointF   oLast = m_proj->toScreen( points->first(), true, &isVisibleLast );
-    // & with the result of checkVisibility to clip away things below horizon
-    isVisibleLast &= m_proj->checkVisibility( points->first() );
-    QPointF oThis, oThis2;
+    KStarsData *data = KStarsData::Instance();
+    long double jd = data->updateNum()->julianDay();
+    double lst = data->lst()->Degrees();
+    double lat = data->geo()->lat()->Degrees();
+
+    // The coordinates of a list brought up to date by LineListIndex only depend on the
+    // time and the latitude, not on the update IDs which any forced update increments.
+    // Other lists may change without notice.
+    if ( list->updateID == data->updateID() && list->screenViewID == m_proj->viewID()
+         && list->screenJD == jd && list->screenLST == lst && list->screenLat == lat
+         && list->screenPoints.size() == points->size() )
+        return;
 
-    for ( int j = 1 ; j < points->size() ; j++ ) {
-        SkyPoint* pThis = points->at( j );
-        oThis2 = oThis = m_proj->toScreen( pThis, true, &isVisible );
+    QVector<Vector2f> screen( points->size() );
+    list->screenPoints.resize( points->size() );
+    list->screenVisible.resize( points->size() );
+    m_proj->toScreenBatch( *points, true, screen.data(), list->screenVisible.data() );
+    for ( int i = 0; i < points->size(); ++i ) {
+        list->screenPoints[ i ] = KSUtils::vecToPoint( screen[ i ] );
         // & with the result of checkVisibility to clip away things below horizon
-        isVisible &= m_proj->checkVisibility(pThis);
-        bool doSkip = false;
-        if( skipList ) {
-            doSkip = skipList->skip(j);
-        }
+        list->screenVisible[ i ] = list->screenVisible[ i ] && m_proj->checkVisibility( points->at( i ) );
+    }
+    list->screenViewID = m_proj->viewID();
+    list->screenJD = jd;
+    list->screenLST = lst;
+    list->screenLat = lat;
+}
 
-        bool pointsVisible = false;
-        //Temporary solution to avoid random lines in Gnomonic projection and draw lines up to horizon
-        if(SkyMap::Instance()->projector()->type() == Projector::Gnomonic) {
-            if ( isVisible && isVisibleLast ) pointsVisible = true;
-        } else {
-            if ( isVisible || isVisibleLast ) pointsVisible = true;
-        }
+void SkyQPainter::drawSkyPolyline(LineList* list, SkipList* skipList, LineListLabel* label)
+{
+    projectLineList( list );
+    const QVector<QPointF> &screenPoints = list->screenPoints;
+    const QVector<bool> &screenVisible = list->screenVisible;
+    if ( screenPoints.isEmpty() )
+        return;
 
-        if ( !doSkip ) {
-            if(pointsVisible) {
-                drawLine( oLast, oThis );
-                if ( label )
-                    label->updateLabelCandidates( oThis.x(), oThis.y(), list, j );
-            }
-        }
+    //Temporary solution to avoid random lines in Gnomonic projection and draw lines up to horizon
+    bool gnomonic = ( SkyMap::Instance()->projector()->type() == Projector::Gnomonic );
 
-        oLast = oThis2;
-        isVisibleLast = isVisible;
+    for ( int j = 1 ; j < screenPoints.size() ; j++ ) {
+        if( skipList && skipList->skip(j) )
+            continue;
+
+        bool pointsVisible;
+        if ( gnomonic )
+            pointsVisible = screenVisible[ j ] && screenVisible[ j - 1 ];
+        else
+            pointsVisible = screenVisible[ j ] || screenVisible[ j - 1 ];
+
+        if(pointsVisible) {
+            drawLine( screenPoints[ j - 1 ], screenPoints[ j ] );
+            if ( label )
+                label->updateLabelCandidates( screenPoints[ j ].x(), screenPoints[ j ].y(), list, j );
+        }
     }
 }
 
 void SkyQPainter::drawSkyPolygon(LineList* list, bool forceClip)
 {
-    bool isVisible, isVisibleLast;
+    bool isVisible = false, isVisibleLast;
     SkyList *points = list->points();
     QPolygonF polygon;
 
@@ -312,32 +333,30 @@ void SkyQPainter::drawSkyPolygon(LineList* list, bool forceClip)
         return;
     }
 
+    projectLineList( list );
+    const QVector<QPointF> &screenPoints = list->screenPoints;
+    const QVector<bool> &screenVisible = list->screenVisible;
+    if ( screenPoints.isEmpty() )
+        return;
 
-    SkyPoint* pLast = points->last();
-    QPointF   oLast = m_proj->toScreen( pLast, true, &isVisibleLast );
-    // & with the result of checkVisibility to clip away things below horizon
-    isVisibleLast &= m_proj->checkVisibility(pLast);
-
-    for ( int i = 0; i < points->size(); ++i ) {
-        SkyPoint* pThis = points->at( i );
-        QPointF oThis = m_proj->toScreen( pThis, true, &isVisible );
-        // & with the result of checkVisibility to clip away things below horizon
-        isVisible &= m_proj->checkVisibility(pThis);
+    int last = screenPoints.size() - 1;
+    isVisibleLast = screenVisible[ last ];
 
+    for ( int i = 0; i < screenPoints.size(); ++i ) {
+        isVisible = screenVisible[ i ];
 
         if ( isVisible && isVisibleLast ) {
-            polygon << oThis;
+            polygon << screenPoints[ i ];
         } else if ( isVisibleLast ) {
-            QPointF oMid = m_proj->clipLine( pLast, pThis );
+            QPointF oMid = m_proj->clipLine( points->at( last ), points->at( i ) );
             polygon << oMid;
         } else if ( isVisible ) {
-            QPointF oMid = m_proj->clipLine( pThis, pLast );
+            QPointF oMid = m_proj->clipLine( points->at( i ), points->at( last ) );
             polygon << oMid;
-            polygon << oThis;
+            polygon << screenPoints[ i ];
         }
 
-        pLast = pThis;
-        oLast = oThis;
+        last = i;
         isVisibleLast = isVisible;
     }
 
@@ -420,9 +439,9 @@ void SkyQPainter::drawPointSource(const QPointF& pos, float size, char sp)
     int isize = qMin(static_cast<int>(size), 14);
     if( !m_vectorStars || starColorMode == 0  ) {
         // Draw stars as bitmaps, either because we were asked to, or because we're painting real colors
-        QPixmap* im = imageCache[ harvardToIndex(sp) ][isize];
+        QImage* im = imageCache[ harvardToIndex(sp) ][isize];
         float offset = 0.5 * im->width();
-        drawPixmap( QPointF(pos.x()-offset, pos.y()-offset), *im );
+        drawImage( QPointF(pos.x()-offset, pos.y()-offset), *im );
     }
     else {
         // Draw stars as vectors, for better printing / SVG export etc.
@@ -466,6 +485,11 @@ bool SkyQPainter::drawConstellationArtImage(ConstellationsArt *obj)
     float w = obj->getWidth()*60*dms::PI*zoom/10800;
     float h = obj->getHeight()*60*dms::PI*zoom/10800;
 
+    // Null while the image is being loaded in the background
+    QImage image = obj->image( qCeil( qMax( w, h ) ) );
+    if ( image.isNull() )
+        return false;
+
     save();
 
     setRenderHint(QPainter::SmoothPixmapTransform);
@@ -473,7 +497,7 @@ bool SkyQPainter::drawConstellationArtImage(ConstellationsArt *obj)
     translate(constellationmidpoint);
     rotate(positionangle);
     setOpacity(0.7);
-    drawImage( QRect(-0.5*w, -0.5*h, w, h), obj->image() );
+    drawImage( QRect(-0.5*w, -0.5*h, w, h), image );
     setOpacity(1);
 
     setRenderHint(QPainter::SmoothPixmapTransform, false);
@@ -515,10 +539,15 @@ bool SkyQPainter::drawDeepSkyImage(const QPointF& pos, DeepSkyObject* obj, float
     double w = obj->a() * dms::PI * zoom/10800.0;
     double h = obj->e() * w;
 
+    // Null while the image is being loaded in the background
+    QImage image = obj->image( qCeil( qMax( w, h ) ) );
+    if ( image.isNull() )
+        return false;
+
     save();
     translate(pos);
     rotate( positionAngle );
-    drawImage( QRect(-0.5*w, -0.5*h, w, h), obj->image() );
+    drawImage( QRect(-0.5*w, -0.5*h, w, h), image );
     restore();
 
     return true;
@@ -93,6 +93,9 @@ public:
 private:
     virtual bool drawDeepSkyImage (const QPointF& pos, DeepSkyObject* obj,
                                          float positionAngle);
+    /** Compute the screen positions of the points of a line list, unless
+        those of its last draw are still valid for the current view. */
+    void projectLineList(LineList* list);
     QPaintDevice *m_pd;
     const Projector* m_proj;
     bool m_vectorStars;
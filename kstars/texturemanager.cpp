@@ -21,7 +21,6 @@
 #include "texturemanager.h"
 #ifdef KSTARS_LITE
 #include <QStandardPaths>
-#include <QImage>
 #else
 #include "skymap.h"
 #include "kstars.h"
@@ -29,15 +28,16 @@
 
 #include "auxiliary/kspaths.h"
 #include "kspaths.h"
+#include "Options.h"
+
+#include <QMutexLocker>
+#include <QTimer>
+#include <QtConcurrent>
 
 #ifdef HAVE_OPENGL
 # include <QGLWidget>
 #endif
 
-// We returning reference to image. We refer to this image when search
-// for image fails
-const static QImage emptyImage;
-
 TextureManager* TextureManager::m_p;
 
 
@@ -47,56 +47,136 @@ TextureManager *TextureManager::Create() {
     return m_p;
 }
 
-const QImage& TextureManager::getImage(const QString& name)
+QImage TextureManager::getImage(const QString& name)
 {
     Create();
     if(name.isEmpty())
-        return emptyImage;
-    CacheIter it = findTexture( name );
-    if( it != m_p->m_textures.constEnd() ) {
-        return *it;
-    } else {
-        return emptyImage;
+        return QImage();
+
+    CacheKey key( name, 0 );
+    {
+        QMutexLocker locker( &m_p->m_mutex );
+        QImage image = m_p->findTexture( key );
+        if( !image.isNull() || m_p->m_missing.contains( name ) )
+            return image;
     }
+
+    // Read the file without holding the lock, the drawing threads keep using the cache
+    QImage image;
+    QString filename = locateTexture( name );
+    if( !filename.isNull() )
+        image = QImage( filename, "PNG" );
+
+    QMutexLocker locker( &m_p->m_mutex );
+    if( image.isNull() )
+        m_p->m_missing.insert( name );
+    else
+        m_p->insertTexture( key, image );
+    return image;
 }
 
-// FIXME: should be cache images which are not found?
-TextureManager::CacheIter TextureManager::findTexture(const QString& name)
+QImage TextureManager::requestImage(const QString& name, int size)
 {
     Create();
-    // Lookup in cache first
-    CacheIter it = m_p->m_textures.constFind( name );
-    if( it != m_p->m_textures.constEnd() ) {
-        return it;
-    } else {
-        // Try to load from file in 'textures' subdirectory
-        QString filename = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("textures/%1.png").arg(name));
-        if( !filename.isNull() ) {
-            return (TextureManager::CacheIter)m_p->m_textures.insert( name, QImage(filename,"PNG") );
-        } else {
-            //Try to load from the file in 'skycultures/western' subdirectory for western constellation art
-            QString filename = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("skycultures/western/%1.png").arg(name));
-            if( !filename.isNull() ) {
-                return (TextureManager::CacheIter)m_p->m_textures.insert( name, QImage(filename,"PNG") );
-               } else {
-                //Try to load from the file in 'skycultures/inuit' subdirectory for Inuit constellation art
-                QString filename = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("skycultures/inuit/%1.png").arg(name));
-                if( !filename.isNull() ) {
-                    return (TextureManager::CacheIter)m_p->m_textures.insert( name, QImage(filename,"PNG") );
-                   }else {
-                // Try to load from file in main data directory
-
-                filename = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("%1.png").arg(name));
-                if( !filename.isNull() ) {
-                    return (TextureManager::CacheIter)m_p->m_textures.insert( name, QImage(filename,"PNG") );
-                } else {
-                    return m_p->m_textures.constEnd();
-                }
-
-              }
-            }
+    if(name.isEmpty())
+        return QImage();
+
+    CacheKey key( name, variantSize( size ) );
+    QMutexLocker locker( &m_p->m_mutex );
+    QImage image = m_p->findTexture( key );
+    if( !image.isNull() || m_p->m_missing.contains( name ) )
+        return image;
+
+    // Until the variant is ready, draw the full image if we have it
+    QImage full;
+    if( key.second )
+        full = m_p->findTexture( CacheKey( name, 0 ) );
+    if( !m_p->m_pending.contains( key ) ) {
+        m_p->m_pending.insert( key );
+        QtConcurrent::run( m_p, &TextureManager::loadTexture, key, full );
+    }
+    return full;
+}
+
+int TextureManager::variantSize(int size)
+{
+    // Variants are powers of two, so that a texture drawn at a slowly
+    // changing size (e.g. while zooming) is not rescaled for every frame
+    if( size <= 0 || size > 512 )
+        return 0;
+    int variant = 32;
+    while( variant < size )
+        variant *= 2;
+    return variant;
+}
+
+QImage TextureManager::findTexture(const CacheKey& key)
+{
+    QImage *image = m_textures.object( key );
+    return image ? *image : QImage();
+}
+
+void TextureManager::insertTexture(const CacheKey& key, const QImage& image, bool shared)
+{
+    int budget = qMax( 1, Options::textureCacheSize() ) * 1024;
+    if( m_textures.maxCost() != budget )
+        m_textures.setMaxCost( budget );
+    // Images larger than the whole budget are not cached, the caller still gets them
+    m_textures.insert( key, new QImage( image ), shared ? 0 : qMax( 1, image.byteCount() / 1024 ) );
+}
+
+void TextureManager::loadTexture(const CacheKey& key, QImage full)
+{
+    if( full.isNull() ) {
+        QString filename = locateTexture( key.first );
+        if( !filename.isNull() )
+            full = QImage( filename, "PNG" );
+    }
+    QImage image = key.second ? scaleTexture( full, key.second ) : full;
+
+    {
+        QMutexLocker locker( &m_mutex );
+        m_pending.remove( key );
+        if( full.isNull() ) {
+            m_missing.insert( key.first );
+            return;
         }
+        // Only the requested variant is kept: the full image of a texture
+        // which is drawn small would use the budget for nothing
+        insertTexture( key, image, image.cacheKey() == full.cacheKey() && m_textures.contains( CacheKey( key.first, 0 ) ) );
     }
+    emit textureLoaded( key.first );
+}
+
+QString TextureManager::locateTexture(const QString& name)
+{
+    // Try the 'textures' subdirectory, then the constellation art of the
+    // western and Inuit sky cultures, then the main data directory
+    static const char * const patterns[] = {
+        "textures/%1.png", "skycultures/western/%1.png", "skycultures/inuit/%1.png", "%1.png"
+    };
+    for( const char *pattern : patterns ) {
+        QString filename = KSPaths::locate( QStandardPaths::GenericDataLocation, QString( pattern ).arg( name ) );
+        if( !filename.isNull() )
+            return filename;
+    }
+    return QString();
+}
+
+QImage TextureManager::scaleTexture(const QImage& image, int size)
+{
+    if( image.isNull() || qMax( image.width(), image.height() ) <= size )
+        return image;
+    return image.scaled( size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation );
+}
+
+void TextureManager::slotUpdateSkyMap()
+{
+#ifndef KSTARS_LITE
+    SkyMap *map = SkyMap::Instance();
+    if( map )
+        map->forceUpdate();
+#endif
 }
 
 #ifdef HAVE_OPENGL
@@ -112,9 +192,9 @@ void TextureManager::bindTexture(const QString& name, QGLWidget* cxt)
     Create();
     Q_ASSERT( "Must be called only with valid GL context" && cxt );
 
-    CacheIter it = findTexture( name );
-    if( it != m_p->m_textures.constEnd() )
-        bindImage( *it, cxt );
+    QImage image = getImage( name );
+    if( !image.isNull() )
+        bindImage( image, cxt );
 }
 
 void TextureManager::bindFromImage(const QImage& image, QGLWidget* cxt)
@@ -140,4 +220,17 @@ void TextureManager::bindFromImage(const QImage& image, QGLWidget* cxt)
 #endif
 
 TextureManager::TextureManager(QObject* parent): QObject(parent)
-{}
+{
+    m_textures.setMaxCost( qMax( 1, Options::textureCacheSize() ) * 1024 );
+
+    m_updateTimer = new QTimer( this );
+    m_updateTimer->setSingleShot( true );
+    m_updateTimer->setInterval( 100 );
+    connect( m_updateTimer, SIGNAL( timeout() ), this, SLOT( slotUpdateSkyMap() ) );
+    // Emitted from the loading threads, so the connection is queued.
+    // The timer is not restarted, textures loaded during a pan must show up meanwhile
+    connect( this, &TextureManager::textureLoaded, m_updateTimer, [this]() {
+        if( !m_updateTimer->isActive() )
+            m_updateTimer->start();
+    } );
+}
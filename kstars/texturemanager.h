@@ -21,14 +21,27 @@
 #define TEXTUREMANAGER_H
 
 #include <QObject>
-#include <QHash>
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QPair>
+#include <QSet>
 
 #include <config-kstars.h>
 
 class QGLWidget;
-class QImage;
+class QTimer;
 
 /** @brief a singleton class to manage texture loading/retrieval
+ *
+ *  Textures are kept in a least recently used cache whose size is
+ *  bounded by Options::textureCacheSize(). Besides the full images,
+ *  downscaled variants are cached for textures which are drawn small
+ *  on the screen.
+ *
+ *  requestImage() never blocks on the disk: textures which are not in
+ *  the cache are loaded on a background thread and the sky map is
+ *  updated once they are ready. It may be called from any thread.
  */
 class TextureManager : public QObject
 {
@@ -38,9 +51,18 @@ public:
     static TextureManager* Create();
 
     /** Return texture image. If image is not found in cache tries to
-     *  load it from disk if that fails too returns reference to empty
-     *  image. */
-    static const QImage& getImage(const QString& name);
+     *  load it from disk if that fails too returns an empty image. */
+    static QImage getImage(const QString& name);
+
+    /** Return texture image without waiting for it to be loaded.
+     *  @param name the name of the texture
+     *  @param size the size of the texture on screen, in pixels. If
+     *  positive, a variant downscaled to no less than this size may be
+     *  returned. Zero requests the full image.
+     *  @return the texture, or a null image if the texture is still being
+     *  loaded or does not exist. textureLoaded() is emitted once it is
+     *  ready. */
+    static QImage requestImage(const QString& name, int size = 0);
 
 #ifdef HAVE_OPENGL
     /** Bind OpenGL texture. Acts similarly to getImage but does
@@ -51,21 +73,62 @@ public:
     static void bindFromImage(const QImage& image, QGLWidget* cxt);
 #endif
 
+signals:
+    /** Emitted when a texture requested with requestImage() finished loading */
+    void textureLoaded(const QString& name);
+
+private slots:
+    /** Update the sky map with the textures loaded since the last update */
+    void slotUpdateSkyMap();
+
 private:
-    /** Shorthand for iterator to hashtable */
-    typedef QHash<QString,QImage>::const_iterator CacheIter;
+    /** A texture variant: the name of the texture and the longest side
+     *  of the downscaled image, or 0 for the full image */
+    typedef QPair<QString,int> CacheKey;
 
     /** Private constructor */
     explicit TextureManager(QObject* parent = 0);
-    /** Try find image in the cache and then to load it from disk if
-     *  it's not found */
-    static CacheIter findTexture(const QString& name);
 
+    /** @return the size of the downscaled variant used for @p size
+     *  pixels on screen, or 0 for the full image */
+    static int variantSize(int size);
+
+    /** Find a texture in the cache. Must be called with m_mutex locked.
+     *  @return the texture, or a null image if it is not cached */
+    QImage findTexture(const CacheKey& key);
+
+    /** Insert a texture in the cache, evicting the least recently used
+     *  ones if the memory budget is exceeded. Must be called with m_mutex
+     *  locked.
+     *  @param shared true if @p image shares its data with a cached
+     *  texture, it is then not accounted for in the memory budget */
+    void insertTexture(const CacheKey& key, const QImage& image, bool shared = false);
+
+    /** Load a texture, or a downscaled variant of it, and insert it in
+     *  the cache. This is run on a background thread by requestImage().
+     *  @param full the full image if it is already cached, or a null image */
+    void loadTexture(const CacheKey& key, QImage full);
+
+    /** @return the file of the texture @p name, searched for in the data
+     *  directories, or a null string if there is none */
+    static QString locateTexture(const QString& name);
+
+    /** @return @p image downscaled so its longest side is @p size, or
+     *  @p image itself if it is already small enough */
+    static QImage scaleTexture(const QImage& image, int size);
 
     // Pointer to singleton instance
     static TextureManager* m_p;
-    // List of named textures
-    QHash<QString,QImage> m_textures;
+    // Named textures and their downscaled variants, cost in kilobytes
+    QCache<CacheKey,QImage> m_textures;
+    // Textures which are being loaded in the background
+    QSet<CacheKey> m_pending;
+    // Textures which do not exist in the data directories
+    QSet<QString> m_missing;
+    // Protects the members above, the cache is shared with the drawing threads
+    QMutex m_mutex;
+    // Coalesces the sky map updates when several textures are loaded at once
+    QTimer* m_updateTimer;
 
     // Prohibit copying
     TextureManager(const TextureManager&);
@@ -335,27 +335,33 @@ void ConjunctionsTool::slotCompute (void)
     }
 
     if ( FilterTypeComboBox->currentIndex() != 0 ) {
+        // Collect the objects and search all their pairs with Object2 at once
+        QList<SkyObject *> searchObjects;
+        QList< QPair<int, int> > pairs;
+        QStringList pairNames;
+        searchObjects << Object2;
+        foreach( const QString &object, objects ) {
+            SkyObject *o = data->skyComposite()->findByName( object );
+            if ( !o )
+                continue;
+            searchObjects << o;
+            pairs << qMakePair( searchObjects.size() - 1, 0 );
+            pairNames << object;
+        }
+
         // Show a progress dialog while processing
-        QProgressDialog progressDlg( i18n( "Compute conjunction..." ), i18n( "Abort" ), 0, objects.count(), this);
+        QProgressDialog progressDlg( i18n( "Compute conjunction..." ), i18n( "Abort" ), 0, 100, this);
         progressDlg.setWindowModality( Qt::WindowModal );
-        progressDlg.setValue( 0 );
-
-        foreach( QString object, objects ) {
-            // If the user click on the 'cancel' button
-            if ( progressDlg.wasCanceled() )
-                break;
+        progressDlg.setLabelText( i18n( "Compute conjunctions with %1", Object2->name() ) );
+        progressDlg.setValue( progress );
+        connect( &ksc, SIGNAL(madeProgress(int)), &progressDlg, SLOT(setValue(int)) );
+        connect( &progressDlg, SIGNAL(canceled()), &ksc, SLOT(cancel()) );
 
-            // Update progress dialog
-            ++progress;
-            progressDlg.setValue( progress );
-            progressDlg.setLabelText( i18n( "Compute conjunction between %1 and %2", Object2->name(), object ) );
-
-            // Compute conjuction
-            Object1 = data->skyComposite()->findByName( object );
-            showConjunctions( ksc.findClosestApproach(*Object1, *Object2, startJD, stopJD, maxSeparation, opposition), object, Object2->name() );
-        }
+        QList< QMap<long double, dms> > results = ksc.findClosestApproaches( searchObjects, pairs, startJD, stopJD, maxSeparation, opposition );
+        for ( int i = 0; i < results.size(); ++i )
+            showConjunctions( results.at( i ), pairNames.at( i ), Object2->name() );
 
-        progressDlg.setValue( objects.count() );
+        progressDlg.setValue( 100 );
     } else {
         // Change cursor while we search for conjunction
         QApplication::setOverrideCursor( QCursor(Qt::WaitCursor) );
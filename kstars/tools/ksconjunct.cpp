@@ -19,15 +19,58 @@
 
 #include <cmath>
 
+#include <QEventLoop>
+#include <QFutureWatcher>
+#include <QScopedPointer>
+#include <QtConcurrent>
+
 #include "ksnumbers.h"
 #include "skyobjects/ksplanetbase.h"
 #include "skyobjects/ksplanet.h"
 #include "skyobjects/ksasteroid.h"
 #include "skyobjects/kscomet.h"
+#include "skyobjects/starobject.h"
 #include "kstarsdata.h"
 
-KSConjunct::KSConjunct() {
+namespace {
+    // Largest apparent motion of an object between two samples of its ephemeris table, in degrees
+    const double MaxSampleMotion = 2.0;
+    // Bounds on the step of an ephemeris table, in days
+    const double MinSampleStep = 0.01;
+    const double MaxSampleStep = 30.0;
+    // Number of one-day probes used to estimate the apparent motion of an object
+    const int RateProbes = 8;
+    // Sampled minima are refined if they are within this many degrees of the maximum separation,
+    // to allow for the interpolation error (mostly due to the parallax of the Moon)
+    const double SeparationMargin = 0.5;
+    // Precision of the time of closest approach, in days
+    const double PreciseTolerance = 1.0 / 86400.0;
+
+    void toUnitVector( const SkyPoint *p, double v[3] ) {
+        double sinRA, cosRA, sinDec, cosDec;
+        p->ra().SinCos( sinRA, cosRA );
+        p->dec().SinCos( sinDec, cosDec );
+        v[0] = cosDec * cosRA;
+        v[1] = cosDec * sinRA;
+        v[2] = sinDec;
+    }
+
+    // Angle between two unit vectors, in radians. The cross product keeps it accurate for small angles.
+    double angleBetween( const double a[3], const double b[3] ) {
+        double cx = a[1]*b[2] - a[2]*b[1];
+        double cy = a[2]*b[0] - a[0]*b[2];
+        double cz = a[0]*b[1] - a[1]*b[0];
+        return atan2( sqrt( cx*cx + cy*cy + cz*cz ), a[0]*b[0] + a[1]*b[1] + a[2]*b[2] );
+    }
+}
+
+KSConjunct::KSConjunct() : opposition( false ), m_StartJD( 0 ), m_StopJD( 0 ), m_MaxSeparation( 0.0 ) {
     geoPlace = KStarsData::Instance()->geo();
+    m_Earth = new KSPlanet( I18N_NOOP( "Earth" ), QString(), QColor( "white" ), 12756.28 /*diameter in km*/ );
+}
+
+KSConjunct::~KSConjunct() {
+    delete m_Earth;
 }
 
 void KSConjunct::setGeoLocation( GeoLocation *geo ) {
@@ -37,168 +80,311 @@ void KSConjunct::setGeoLocation( GeoLocation *geo ) {
         geoPlace = KStarsData::Instance()->geo();
 }
 
+void KSConjunct::cancel() {
+    m_Cancelled.storeRelease( 1 );
+}
+
 QMap<long double, dms> KSConjunct::findClosestApproach(SkyObject& Object1, KSPlanetBase& Object2, long double startJD, long double stopJD, dms maxSeparation,bool _opposition) {
+    QList<SkyObject *> objects;
+    objects << &Object1 << &Object2;
+    QList< QPair<int, int> > pairs;
+    pairs << qMakePair( 0, 1 );
 
-  QMap<long double, dms> Separations;
-  QPair<long double, dms> extremum;
-  dms Dist;
-  dms prevDist;
-  double step, step0;
-  int Sign, prevSign;
-  opposition=_opposition;
-  //  qDebug() << "Entered KSConjunct::findClosestApproach() with startJD = " << (double)startJD;
-  //  qDebug() << "Initial Positional Information: \n";
-  //  qDebug() << Object1.name() << ": RA = " << Object1.ra() -> toHMSString() << "; Dec = " << Object1.dec() -> toDMSString() << "\n";
-  //  qDebug() << Object2.name() << ": RA = " << Object2.ra() -> toHMSString() << "; Dec = " << Object2.dec() -> toDMSString() << "\n";
-  prevSign = 0;
-
-  step0 = (stopJD - startJD) / 4.0;  // I'm an idiot for having done this without having the lines that follow -- asimha
-
-  // TODO: Work out a solid footing on which one can decide step0. -- asimha
-  if( step0 > 24.8 * 365.25 ) // Sample pluto's orbit (248.09 years) at least 10 times.
-      step0 = 24.8 * 365.25;
-
-  // FIXME: This can be done better, but for now, I'm doing it the dumb way -- asimha
-  if( Object1.name() == i18n( "Neptune" ) || Object2.name() == i18n( "Neptune" ) || Object1.name() == i18n( "Uranus" ) || Object2.name() == i18n( "Uranus" ) )
-      if( step0 > 3652.5 )
-          step0 = 3652.5;
-  if( Object1.name() == i18n( "Jupiter" ) || Object2.name() == i18n( "Jupiter" ) || Object1.name() == i18n( "Saturn" ) || Object2.name() == i18n( "Saturn" ) )
-      if( step0 > 365.25 )
-          step0 = 365;
-  if(Object1.name() == i18n( "Mars" ) || Object2.name() == i18n( "Mars" ))
-    if (step0 > 10.0)
-      step0 = 10.0;
-  if(Object1.name() == i18n( "Venus" ) || Object1.name() == i18n( "Mercury" ) || Object2.name() == i18n( "Mercury" ) || Object2.name() == i18n( "Venus" ))
-    if (step0 > 5.0)
-      step0 = 5.0;
-  if(Object1.name() == "Moon" || Object2.name() == "Moon")
-    if (step0 > 0.25)
-      step0 = 0.25;
-
-  step = step0;
-
-  //	qDebug() << "Initial Separation between " << Object1.name() << " and " << Object2.name() << " = " << (prevDist.toDMSString());
-
-  long double jd = startJD;
-  prevDist = findDistance(jd, &Object1, &Object2);
-  jd += step;
-  while ( jd <= stopJD ) {
-    int progress = int( 100.0*(jd - startJD)/(stopJD - startJD) );
-    emit madeProgress( progress );
-
-    Dist = findDistance(jd, &Object1, &Object2);
-    Sign = sgn(Dist - prevDist);
-    //	qDebug() << "Dist = " << Dist.toDMSString() << "; prevDist = " << prevDist.toDMSString() << "; Difference = " << (Dist.Degrees() - prevDist.Degrees()) << "; Step = " << step;
-
-    //How close are we to a conjunction, and how fast are we approaching one?
-    double factor = fabs( (Dist.Degrees() - prevDist.Degrees()) / Dist.Degrees());
-    if ( factor > 10.0 ) { //let's go faster!
-        step = step0 * factor/10.0;
-    } else { //slow down, we're getting close!
-        step = step0;
+    QList< QMap<long double, dms> > results = findClosestApproaches( objects, pairs, startJD, stopJD, maxSeparation, _opposition );
+    return results.isEmpty() ? QMap<long double, dms>() : results.first();
+}
+
+QList< QMap<long double, dms> > KSConjunct::findClosestApproaches( const QList<SkyObject *> &objects, const QList< QPair<int, int> > &pairs,
+                                                                   long double startJD, long double stopJD, const dms &maxSeparation, bool _opposition ) {
+    QList< QMap<long double, dms> > results;
+
+    opposition = _opposition;
+    m_StartJD = startJD;
+    m_StopJD = stopJD;
+    m_MaxSeparation = maxSeparation.radians();
+    m_Cancelled.storeRelease( 0 );
+
+    if( stopJD <= startJD || objects.isEmpty() )
+        return results;
+
+    // Clones and orbital data are prepared here, on the calling thread: loading the data of
+    // the planets and the Moon, and creating their textures, is not thread-safe.
+    m_Earth->loadData();
+    QVector<EphemerisTable> tables( objects.size() );
+    for( int i = 0; i < objects.size(); ++i ) {
+        tables[i].object = objects[i]->clone();
+        KSPlanetBase *p = dynamic_cast<KSPlanetBase*>( tables[i].object );
+        if( p )
+            p->loadData();
     }
 
-    if( Sign != prevSign && prevSign == -1) { //all right, we may have just passed a conjunction
-        if ( step > step0 ) { //mini-loop to back up and make sure we're close enough
-            //            qDebug() << "Entering slow loop: " << endl;
-            jd -= step;
-            step = step0;
-            Sign = prevSign;
-            while ( jd <= stopJD ) {
-                Dist = findDistance(jd, &Object1, &Object2);
-                Sign = sgn(Dist - prevDist);
-                //	qDebug() << "Dist=" << Dist.toDMSString() << "; prevDist=" << prevDist.toDMSString() << "; Diff=" << (Dist.Degrees() - prevDist.Degrees()) << "djd=" << (int)(jd - startJD);
-                if ( Sign != prevSign ) break;
-
-                prevDist = Dist;
-                prevSign = Sign;
-                jd += step;
-            }
-        }
+    waitFor( QtConcurrent::map( tables, [this]( EphemerisTable &table ) { sampleEphemeris( table ); } ), 0, 50 );
 
-        //	qDebug() << "Sign = " << Sign << " and " << "prevSign = " << prevSign << ": Entering findPrecise()\n";
-        if(findPrecise(&extremum, &Object1, &Object2, jd, step, Sign))
-            if(extremum.second.radians() < maxSeparation.radians())
-                Separations.insert(extremum.first, extremum.second);
-    }
+    QVector< QMap<long double, dms> > scans( pairs.size() );
+    QVector<int> indices( pairs.size() );
+    for( int i = 0; i < indices.size(); ++i )
+        indices[i] = i;
+
+    waitFor( QtConcurrent::map( indices, [&]( int i ) {
+                const QPair<int, int> &pair = pairs.at( i );
+                scans[i] = scanPair( tables.at( pair.first ), tables.at( pair.second ) );
+            } ), 50, 50 );
 
-    prevDist = Dist;
-    prevSign = Sign;
-    jd += step;
-  }
+    for( int i = 0; i < tables.size(); ++i )
+        delete tables[i].object;
 
-  return Separations;
+    results = scans.toList();
+    return results;
 }
 
+void KSConjunct::waitFor( const QFuture<void> &future, int progressStart, int progressSpan ) {
+    QFutureWatcher<void> watcher;
+    QEventLoop loop;
 
-dms KSConjunct::findDistance(long double jd, SkyObject *Object1, KSPlanetBase *Object2)
-{
-  KStarsDateTime t(jd);
-  KSNumbers num(jd);
-  dms dist;
-
-  KSPlanet *m_Earth = new KSPlanet( I18N_NOOP( "Earth" ), QString(), QColor( "white" ), 12756.28 /*diameter in km*/ );
-  m_Earth -> findPosition( &num );
-  CachingDms LST(geoPlace->GSTtoLST(t.gst()));
-
-  KSPlanetBase* p = dynamic_cast<KSPlanetBase*>(Object1);
-  if( p )
-      p->findPosition(&num, geoPlace->lat(), &LST, m_Earth);
-  else
-      Object1->updateCoordsNow( &num );
-
-  Object2->findPosition(&num, geoPlace->lat(), &LST, m_Earth);
-  dist.setRadians(Object1 -> angularDistanceTo(Object2).radians());
-  if( opposition ) {
-      dist.setD( 180 - dist.Degrees() );
-  }
-  return dist;
+    connect( &watcher, &QFutureWatcher<void>::finished, &loop, &QEventLoop::quit );
+    connect( &watcher, &QFutureWatcher<void>::progressValueChanged, this, [&]( int value ) {
+        int range = watcher.progressMaximum() - watcher.progressMinimum();
+        if( range > 0 )
+            emit madeProgress( progressStart + progressSpan * ( value - watcher.progressMinimum() ) / range );
+    });
+
+    watcher.setFuture( future );
+    if( !watcher.isFinished() )
+        loop.exec();
+    watcher.waitForFinished();
+
+    emit madeProgress( progressStart + progressSpan );
+}
+
+void KSConjunct::EphemerisTable::positionAt( long double jd, double v[3] ) const {
+    double t = (double)( jd - startJD ) / step;
+    int i = qBound( 0, int( floor( t ) ), x.size() - 2 );
+    double f = t - i;
+
+    v[0] = x[i] + f * ( x[i+1] - x[i] );
+    v[1] = y[i] + f * ( y[i+1] - y[i] );
+    v[2] = z[i] + f * ( z[i+1] - z[i] );
+
+    double norm = sqrt( v[0]*v[0] + v[1]*v[1] + v[2]*v[2] );
+    v[0] /= norm;
+    v[1] /= norm;
+    v[2] /= norm;
+}
+
+void KSConjunct::findPosition( SkyObject *object, const KSNumbers *num, const CachingDms *LST, const KSPlanetBase *Earth, double v[3] ) const {
+    KSPlanetBase *p = dynamic_cast<KSPlanetBase*>( object );
+    if( p )
+        p->findPositionOnly( num, geoPlace->lat(), LST, Earth );
+    else {
+        // SkyPoint::updateCoords() would read the Sun of the sky map for the deflection of the light,
+        // while the clock updates it. The deflection is below two arcseconds anyway, so it is left out.
+        CachingDms ra0( object->ra0() ), dec0( object->dec0() );
+        StarObject *star = dynamic_cast<StarObject*>( object );
+        if( star )
+            star->getIndexCoords( num, ra0, dec0 );
+        SkyPoint apparent( ra0, dec0 );
+        apparent.precessFromAnyEpoch( J2000, num->julianDay() );
+        apparent.nutate( num );
+        apparent.aberrate( num );
+        object->setRA( apparent.ra() );
+        object->setDec( apparent.dec() );
+    }
+
+    toUnitVector( object, v );
 }
 
-bool KSConjunct::findPrecise(QPair<long double, dms> *out, SkyObject *Object1, KSPlanetBase *Object2, long double jd, double step, int prevSign) {
-  dms prevDist;
-  int Sign;
-  dms Dist;
-
-  if( out == NULL ) {
-    qDebug() << "ERROR: Argument out to KSConjunct::findPrecise(...) was NULL!";
-    return false;
-  }
-
-  prevDist = findDistance(jd, Object1, Object2);
-
-  step = -step / 2.0;
-  prevSign = -prevSign;
-
-  while(true) {
-    jd += step;
-    Dist = findDistance(jd, Object1, Object2);
-    //    qDebug() << "Dist=" << Dist.toDMSString() << "; prevDist=" << prevDist.toDMSString() << "; Diff=" << (Dist.Degrees() - prevDist.Degrees()) << "step=" << step;
-
-    if(fabs(step) < 1.0 / (24.0*60.0) ) {
-      out -> first = jd - step / 2.0;
-      out -> second = findDistance(jd - step/2.0, Object1, Object2);
-      if(out -> second.radians() < findDistance(jd - 5.0, Object1, Object2).radians())
-        return true;
-      else
-        return false;
+void KSConjunct::sampleEphemeris( EphemerisTable &table ) const {
+    if( m_Cancelled.loadAcquire() )
+        return;
+
+    QScopedPointer<KSPlanetBase> earth( m_Earth->clone() );
+    double v0[3], v1[3];
+
+    // Estimate the fastest apparent motion of the object over the range.
+    // This replaces the former hard-coded step sizes per planet.
+    double span = (double)( m_StopJD - m_StartJD );
+    double rate = 0.0;  // degrees per day
+    for( int i = 0; i < RateProbes; ++i ) {
+        long double jd = m_StartJD + span * i / ( RateProbes - 1 );
+
+        KSNumbers num0( jd );
+        earth->findPositionOnly( &num0 );
+        CachingDms LST0( geoPlace->GSTtoLST( KStarsDateTime( jd ).gst() ) );
+        findPosition( table.object, &num0, &LST0, earth.data(), v0 );
+
+        KSNumbers num1( jd + 1.0 );
+        earth->findPositionOnly( &num1 );
+        CachingDms LST1( geoPlace->GSTtoLST( KStarsDateTime( jd + 1.0 ).gst() ) );
+        findPosition( table.object, &num1, &LST1, earth.data(), v1 );
+
+        rate = qMax( rate, angleBetween( v0, v1 ) / dms::DegToRad );
+    }
+
+    double step = ( rate > 0.0 ) ? MaxSampleMotion / rate : MaxSampleStep;
+    step = qMax( MinSampleStep, qMin( step, qMin( MaxSampleStep, span / 4.0 ) ) );
+
+    // Sample one step past the end of the range, so that it can always be interpolated
+    int count = int( ceil( span / step ) ) + 2;
+    table.startJD = m_StartJD;
+    table.step = step;
+    table.x.resize( count );
+    table.y.resize( count );
+    table.z.resize( count );
+
+    for( int i = 0; i < count; ++i ) {
+        if( m_Cancelled.loadAcquire() )
+            return;
+
+        long double jd = m_StartJD + step * i;
+        KSNumbers num( jd );
+        earth->findPositionOnly( &num );
+        CachingDms LST( geoPlace->GSTtoLST( KStarsDateTime( jd ).gst() ) );
+        findPosition( table.object, &num, &LST, earth.data(), v0 );
+
+        table.x[i] = v0[0];
+        table.y[i] = v0[1];
+        table.z[i] = v0[2];
     }
-    Sign = sgn(Dist - prevDist);
-    if(Sign != prevSign) {
-      step = -step / 2.0;
-      Sign = -Sign;
+}
+
+QMap<long double, dms> KSConjunct::scanPair( const EphemerisTable &table1, const EphemerisTable &table2 ) const {
+    QMap<long double, dms> Separations;
+
+    if( m_Cancelled.loadAcquire() || table1.x.size() < 2 || table2.x.size() < 2 )
+        return Separations;
+
+    double span = (double)( m_StopJD - m_StartJD );
+    int count = int( ceil( span / qMin( table1.step, table2.step ) ) );
+    double step = span / count;
+
+    QVector<double> dist( count + 1 );
+    double v1[3], v2[3];
+    for( int i = 0; i <= count; ++i ) {
+        long double jd = m_StartJD + step * i;
+        table1.positionAt( jd, v1 );
+        table2.positionAt( jd, v2 );
+        dist[i] = angleBetween( v1, v2 );
+        if( opposition )
+            dist[i] = dms::PI - dist[i];
+    }
+
+    // Private copies for the refinement, created only once a candidate has been found
+    QScopedPointer<SkyObject> object1, object2;
+    QScopedPointer<KSPlanetBase> earth;
+    double limit = m_MaxSeparation + SeparationMargin * dms::DegToRad;
+
+    for( int i = 1; i < count; ++i ) {
+        if( !( dist[i] <= dist[i-1] && dist[i] < dist[i+1] && dist[i] < limit ) )
+            continue;
+
+        if( m_Cancelled.loadAcquire() )
+            break;
+
+        if( !earth ) {
+            object1.reset( table1.object->clone() );
+            object2.reset( table2.object->clone() );
+            earth.reset( m_Earth->clone() );
+        }
+
+        QPair<long double, dms> extremum;
+        findPrecise( &extremum, object1.data(), object2.data(), earth.data(),
+                     m_StartJD + step * ( i - 1 ), m_StartJD + step * i, m_StartJD + step * ( i + 1 ) );
+
+        if( extremum.first > m_StartJD && extremum.first < m_StopJD && extremum.second.radians() < m_MaxSeparation )
+            Separations.insert( extremum.first, extremum.second );
     }
-    prevSign = Sign;
-    prevDist = Dist;
-  }
+
+    return Separations;
 }
 
-int KSConjunct::sgn(dms a) {
+double KSConjunct::findDistance( long double jd, SkyObject *Object1, SkyObject *Object2, KSPlanetBase *Earth ) const
+{
+  KSNumbers num( jd );
+  double v1[3], v2[3];
 
-  // Auxiliary function used by the KSConjunct::findClosestApproach(...)
-  // method and the KSConjunct::findPrecise(...) method
+  Earth->findPositionOnly( &num );
+  CachingDms LST( geoPlace->GSTtoLST( KStarsDateTime( jd ).gst() ) );
 
-  return ((a.radians() > 0)?1:((a.radians() < 0)?-1:0));
+  findPosition( Object1, &num, &LST, Earth, v1 );
+  findPosition( Object2, &num, &LST, Earth, v2 );
 
+  double dist = angleBetween( v1, v2 );
+  if( opposition )
+      dist = dms::PI - dist;
+  return dist;
 }
 
+void KSConjunct::findPrecise( QPair<long double, dms> *out, SkyObject *Object1, SkyObject *Object2, KSPlanetBase *Earth,
+                              long double a, long double b, long double c ) const {
+    // Brent's method, see e.g. "Numerical Recipes", section 10.2.
+    // Abscissae are kept in days relative to a, to keep full precision in doubles.
+    const double CGold = 0.3819660;
+    const int MaxIterations = 100;
+
+    double lo = 0.0, hi = (double)( c - a );
+    double x = (double)( b - a ), w = x, v = x;
+    double fx = findDistance( a + x, Object1, Object2, Earth );
+    double fw = fx, fv = fx;
+    double d = 0.0, e = 0.0;
+
+    for( int iter = 0; iter < MaxIterations; ++iter ) {
+        double xm = 0.5 * ( lo + hi );
+        double tol1 = PreciseTolerance;
+        double tol2 = 2.0 * tol1;
+
+        if( fabs( x - xm ) <= tol2 - 0.5 * ( hi - lo ) )
+            break;
+
+        if( fabs( e ) > tol1 ) {
+            // Try a parabolic fit through x, w and v
+            double r = ( x - w ) * ( fx - fv );
+            double q = ( x - v ) * ( fx - fw );
+            double p = ( x - v ) * q - ( x - w ) * r;
+            q = 2.0 * ( q - r );
+            if( q > 0.0 )
+                p = -p;
+            q = fabs( q );
+            double etemp = e;
+            e = d;
+            if( fabs( p ) >= fabs( 0.5 * q * etemp ) || p <= q * ( lo - x ) || p >= q * ( hi - x ) ) {
+                e = ( x >= xm ) ? lo - x : hi - x;
+                d = CGold * e;
+            } else {
+                d = p / q;
+                double u = x + d;
+                if( u - lo < tol2 || hi - u < tol2 )
+                    d = ( xm - x >= 0.0 ) ? tol1 : -tol1;
+            }
+        } else {
+            e = ( x >= xm ) ? lo - x : hi - x;
+            d = CGold * e;
+        }
+
+        double u = ( fabs( d ) >= tol1 ) ? x + d : x + ( d >= 0.0 ? tol1 : -tol1 );
+        double fu = findDistance( a + u, Object1, Object2, Earth );
+
+        if( fu <= fx ) {
+            if( u >= x )
+                lo = x;
+            else
+                hi = x;
+            v = w; fv = fw;
+            w = x; fw = fx;
+            x = u; fx = fu;
+        } else {
+            if( u < x )
+                lo = u;
+            else
+                hi = u;
+            if( fu <= fw || w == x ) {
+                v = w; fv = fw;
+                w = u; fw = fu;
+            } else if( fu <= fv || v == x || v == w ) {
+                v = u; fv = fu;
+            }
+        }
+    }
+
+    out->first = a + x;
+    out->second.setRadians( fx );
+}
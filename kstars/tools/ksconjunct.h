@@ -21,6 +21,9 @@
 
 #include <QMap>
 #include <QObject>
+#include <QVector>
+#include <QFuture>
+#include <QAtomicInt>
 
 #include "dms.h"
 #include "skyobjects/skyobject.h"
@@ -33,6 +36,8 @@ class KSNumbers;
 class KSPlanetBase;
 class KSPlanet; 
 class dms;
+class CachingDms;
+class GeoLocation;
 
 /**
   *@class KSConjunct
@@ -49,16 +54,16 @@ class KSConjunct :public QObject {
  
  public:
   /**
-    *Constructor.  Instantiates a KSNumbers for internal computations.
+    *Constructor.  Creates the private copy of the Earth used for internal computations.
     */
   
   KSConjunct();
 
   /**
-   *Destructor.  (Empty)
+   *Destructor.
    */
 
-  ~KSConjunct() { }
+  ~KSConjunct();
 
   /**
    *@short Sets the geographic location to compute conjunctions at
@@ -81,54 +86,132 @@ class KSConjunct :public QObject {
    */
 
   QMap<long double, dms> findClosestApproach(SkyObject& Object1, KSPlanetBase& Object2, long double startJD, long double stopJD, dms maxSeparation, bool _opposition=false);
-  
+
+  /**
+   *@short Compute the closest approaches of many pairs of objects in the given range
+   *
+   *The positions of every object are first sampled over the range into an ephemeris
+   *table, one object per task on the global thread pool. The step of each table is
+   *chosen from the apparent motion of the object, so that it moves by at most a couple
+   *of degrees between samples. All pairs are then scanned concurrently: local minima of
+   *the separation are bracketed from the interpolated tables and refined with Brent's
+   *method on exact positions.
+   *
+   *The objects are not modified; the search works on private copies of them. While the
+   *search runs, the event loop is processed so that progress can be shown.
+   *
+   *@param objects  The objects taking part in the search
+   *@param pairs    Pairs of indices into @p objects whose approaches are searched
+   *@param startJD  Julian Day corresponding to start of the calculation period
+   *@param stopJD   Julian Day corresponding to end of the calculation period
+   *@param maxSeparation  Maximum separation between the objects of a pair to be output
+   *@param opposition A parameter to see if we are computing conjunction or opposition
+   *@return For each pair, in the order of @p pairs, a map of julian days of close conjunctions against separation
+   */
+
+  QList< QMap<long double, dms> > findClosestApproaches( const QList<SkyObject *> &objects, const QList< QPair<int, int> > &pairs,
+                                                         long double startJD, long double stopJD, const dms &maxSeparation, bool _opposition=false );
+
+ public slots:
+  /**
+   *@short Abort the running search. The pairs already scanned are still returned.
+   */
+  void cancel();
+
  signals:
   void madeProgress( int progress );
 
  private:
 
   /**
-    *@short Finds the angular distance between two solar system objects.
-    *
-    *@param jd  Julian Day corresponding to the time of computation
-    *@param Object1  A pointer to the first solar system object
-    *@param Object2  A pointer to the second solar system object
-    *
-    *@return The angular distance between the two bodies.
+    *@class EphemerisTable
+    *Apparent positions of one object sampled at a fixed step, stored as unit vectors
+    *so that positions in between samples can be interpolated linearly.
     */
+  class EphemerisTable {
+  public:
+      EphemerisTable() : object( 0 ), step( 0.0 ) {}
+
+      /**
+        *@short Interpolate the position of the object
+        *@param jd  Julian Day, within the sampled range
+        *@param v   The unit vector of the position is returned here
+        */
+      void positionAt( long double jd, double v[3] ) const;
+
+      SkyObject *object;   // Private copy of the object, owned by KSConjunct
+      long double startJD;
+      double step;
+      QVector<double> x, y, z;
+  };
 
-  // TODO: Make pointers to Object1 and Object2 private objects instead of passing them to the methods again and again. 
-  //       Should improve performance, at least marginally.
-
-  dms findDistance(long double jd, SkyObject *Object1, KSPlanetBase *Object2);
+  /**
+    *@short Sample the position of the object of the table over the search range
+    */
+  void sampleEphemeris( EphemerisTable &table ) const;
 
   /**
-    *@short Compute the precise value of the extremum once the extremum has been detected.
+    *@short Find the minima of the separation of two objects
     *
-    *@param out  A pointer to a QPair that stores the Julian Day and Separation corresponding to the extremum
-    *@param Object1  A pointer to the first solar system body
-    *@param Object2  A pointer to the second solar system body
-    *@param jd  Julian day corresponding to the endpoint of the interval where extremum was detected.
-    *@param step  The step in jd taken during computation earlier. (Defines the interval size)
-    *@param prevSign The previous sign of increment in moving from jd - step to jd
+    *@return Hash containing julian days of close conjunctions against separation
+    */
+  QMap<long double, dms> scanPair( const EphemerisTable &table1, const EphemerisTable &table2 ) const;
+
+  /**
+    *@short Compute the position of an object
     *
-    *@return true if the extremum is a minimum
+    *@param object  The object, whose coordinates are updated
+    *@param num     KSNumbers for the time of computation
+    *@param LST     Local sidereal time at the time of computation
+    *@param Earth   The Earth, already updated to the time of computation
+    *@param v       The unit vector of the position is returned here
     */
+  void findPosition( SkyObject *object, const KSNumbers *num, const CachingDms *LST, const KSPlanetBase *Earth, double v[3] ) const;
 
-  bool findPrecise(QPair<long double, dms> *out, SkyObject *Object1, KSPlanetBase *Object2, long double jd, double step, int prevSign);
+  /**
+    *@short Finds the angular distance between two objects.
+    *
+    *@param jd  Julian Day corresponding to the time of computation
+    *@param Object1  A pointer to the first object
+    *@param Object2  A pointer to the second object
+    *@param Earth  A pointer to the Earth used for the computation
+    *
+    *@return The angular distance between the two bodies in radians, or its
+    *supplement when searching for oppositions.
+    */
+  double findDistance( long double jd, SkyObject *Object1, SkyObject *Object2, KSPlanetBase *Earth ) const;
 
   /**
-    *@short Return the sign of an angle
+    *@short Compute the precise value of a minimum of the distance once it has been bracketed.
     *
-    *@param a  The angle whose sign has to be returned
+    *Uses Brent's method (parabolic interpolation combined with golden section search).
     *
-    *@return (-1, 0, 1) if a.radians() is (-ve, zero, +ve)
+    *@param out  A pointer to a QPair that stores the Julian Day and Separation corresponding to the minimum
+    *@param Object1  A pointer to the first object
+    *@param Object2  A pointer to the second object
+    *@param Earth  A pointer to the Earth used for the computation
+    *@param a  Julian day of the start of the bracketing interval
+    *@param b  Julian day of the bracketing point, where the distance is lower than at both ends
+    *@param c  Julian day of the end of the bracketing interval
     */
+  void findPrecise( QPair<long double, dms> *out, SkyObject *Object1, SkyObject *Object2, KSPlanetBase *Earth,
+                    long double a, long double b, long double c ) const;
 
-  int sgn(dms a);
+  /**
+    *@short Wait for a background computation to finish while processing events
+    *
+    *@param future  The computation
+    *@param progressStart  Progress reported when the computation starts
+    *@param progressSpan  Progress increment between the start and the end of the computation
+    */
+  void waitFor( const QFuture<void> &future, int progressStart, int progressSpan );
 
   bool opposition;
   GeoLocation *geoPlace;
+  KSPlanet *m_Earth;
+  long double m_StartJD, m_StopJD;
+  double m_MaxSeparation;
+  QAtomicInt m_Cancelled;
 };
 
 #endif
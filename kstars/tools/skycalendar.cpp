@@ -26,6 +26,7 @@
 #include <QDebug>
 #include <KPlotting/KPlotObject>
 #include <QPushButton>
+#include <QtConcurrent>
 
 #include "calendarwidget.h"
 #include "geolocation.h"
@@ -34,6 +35,39 @@
 #include "kstarsdata.h"
 #include "skyobjects/ksplanet.h"
 #include "skycomponents/skymapcomposite.h"
+#include "ksnumbers.h"
+
+namespace {
+
+/**
+ * A copy of a planet which computes its coordinates with findPositionOnly(), from its own
+ * copy of the Earth. Its rise, set and transit times can then be computed on a worker thread
+ * without touching the bodies of the sky map, nor creating and deleting clones there.
+ */
+class CalendarPlanet : public KSPlanet
+{
+public:
+    CalendarPlanet( const KSPlanet &planet, const KSPlanet &earth ) :
+        KSPlanet( planet ), m_Planet( planet ), m_Earth( earth ) {}
+
+    virtual SkyPoint recomputeCoords( const KStarsDateTime &dt, const GeoLocation *geo=0 ) const {
+        KSNumbers num( dt.djd() );
+        m_Earth.findPositionOnly( &num );
+        if ( geo ) {
+            CachingDms LST = geo->GSTtoLST( dt.gst() );
+            m_Planet.findPositionOnly( &num, geo->lat(), &LST, &m_Earth );
+        } else {
+            m_Planet.findPositionOnly( &num, 0, 0, &m_Earth );
+        }
+        return m_Planet;
+    }
+
+private:
+    mutable KSPlanet m_Planet;
+    mutable KSPlanet m_Earth;
+};
+
+}
 
 SkyCalendarUI::SkyCalendarUI( QWidget *parent )
     : QFrame( parent )
@@ -84,34 +118,112 @@ SkyCalendar::SkyCalendar( QWidget *parent )
 
     connect( scUI->CreateButton, SIGNAL(clicked()), this, SLOT(slotFillCalendar()) );
     connect( scUI->LocationButton, SIGNAL(clicked()), this, SLOT(slotLocation()) );
+    connect( &m_Watcher, SIGNAL(resultReadyAt(int)), this, SLOT(slotChunkReady(int)) );
 }
 
 SkyCalendar::~SkyCalendar() {
+    m_Watcher.cancel();
+    m_Watcher.waitForFinished();
+    qDeleteAll( m_ChunkPlanets );
 }
 
 int SkyCalendar::year()  { return scUI->Year->value(); }
 
 void SkyCalendar::slotFillCalendar() {
-    scUI->CalendarView->resetPlot();
-    scUI->CalendarView->setHorizon();
-    
+    // Abandon the rest of a previous computation. The chunks already received stay cached.
+    m_Watcher.cancel();
+    m_Watcher.waitForFinished();
+    qDeleteAll( m_ChunkPlanets );
+    m_ChunkPlanets.clear();
+
+    m_Key = cacheKey();
+    m_Planets = selectedPlanets();
+
+    QList<EventChunk> chunks;
+    const QHash<int, EventChunk> &events = m_Events[ m_Key ];
+    foreach ( int nPlanet, m_Planets ) {
+        for ( int month = 1; month <= 12; ++month ) {
+            if ( events.contains( nPlanet * 12 + month - 1 ) )
+                continue;
+
+            EventChunk chunk;
+            chunk.key = m_Key;
+            chunk.planet = nPlanet;
+            chunk.year = year();
+            chunk.month = month;
+            chunk.interval = scUI->spinBox_Interval->value();
+            chunk.geo = geo;
+            // Each chunk computes on its own copies, made here on the GUI thread
+            KSPlanet *planet = new CalendarPlanet( *static_cast<KSPlanet *>( KStarsData::Instance()->skyComposite()->planet( nPlanet ) ),
+                                                   *KStarsData::Instance()->skyComposite()->earth() );
+            m_ChunkPlanets << planet;
+            chunk.ksp = planet;
+            chunks << chunk;
+        }
+    }
+
+    if ( ! chunks.isEmpty() )
+        m_Watcher.setFuture( QtConcurrent::mapped( chunks, &SkyCalendar::computeChunk ) );
+
+    drawCalendar();
+}
+
+void SkyCalendar::slotChunkReady( int index ) {
+    EventChunk chunk = m_Watcher.resultAt( index );
+    m_Events[ chunk.key ].insert( chunk.planet * 12 + chunk.month - 1, chunk );
+
+    if ( chunk.key == m_Key )
+        drawCalendar();
+}
+
+QString SkyCalendar::cacheKey() {
+    return QString( "%1;%2;%3;%4;%5" ).arg( year() ).arg( scUI->spinBox_Interval->value() )
+            .arg( geo->fullName() ).arg( geo->lat()->Degrees() ).arg( geo->lng()->Degrees() );
+}
+
+QList<int> SkyCalendar::selectedPlanets() {
+    QList<int> planets;
+
     if ( scUI->checkBox_Mercury->isChecked() )
-        addPlanetEvents( KSPlanetBase::MERCURY );
+        planets << KSPlanetBase::MERCURY;
     if ( scUI->checkBox_Venus->isChecked() )
-        addPlanetEvents( KSPlanetBase::VENUS );
+        planets << KSPlanetBase::VENUS;
     if ( scUI->checkBox_Mars->isChecked() )
-        addPlanetEvents( KSPlanetBase::MARS );
+        planets << KSPlanetBase::MARS;
     if ( scUI->checkBox_Jupiter->isChecked() )
-        addPlanetEvents( KSPlanetBase::JUPITER );
+        planets << KSPlanetBase::JUPITER;
     if ( scUI->checkBox_Saturn->isChecked() )
-        addPlanetEvents( KSPlanetBase::SATURN );
+        planets << KSPlanetBase::SATURN;
     if ( scUI->checkBox_Uranus->isChecked() )
-        addPlanetEvents( KSPlanetBase::URANUS );
+        planets << KSPlanetBase::URANUS;
     if ( scUI->checkBox_Neptune->isChecked() )
-        addPlanetEvents( KSPlanetBase::NEPTUNE );
+        planets << KSPlanetBase::NEPTUNE;
     //if ( scUI->checkBox_Pluto->isChecked() )
-        //addPlanetEvents( KSPlanetBase::PLUTO );
-    
+        //planets << KSPlanetBase::PLUTO;
+
+    return planets;
+}
+
+void SkyCalendar::drawCalendar() {
+    scUI->CalendarView->resetPlot();
+    scUI->CalendarView->setHorizon();
+
+    const QHash<int, EventChunk> events = m_Events.value( m_Key );
+    foreach ( int nPlanet, m_Planets ) {
+        QVector<QPointF> vRise, vSet, vTransit;
+        for ( int month = 1; month <= 12; ++month ) {
+            QHash<int, EventChunk>::const_iterator it = events.constFind( nPlanet * 12 + month - 1 );
+            if ( it == events.constEnd() )
+                break;
+            vRise += it->vRise;
+            vSet += it->vSet;
+            vTransit += it->vTransit;
+        }
+
+        if ( ! vRise.isEmpty() )
+            addPlanetEvents( nPlanet, vRise, vSet, vTransit );
+    }
+
     scUI->CalendarView->update();
 }
 
@@ -139,15 +251,18 @@ void SkyCalendar::drawEventLabel( float x1, float y1, float x2, float y2, QStrin
 }
 */
 
-void SkyCalendar::addPlanetEvents( int nPlanet ) {
-    KSPlanetBase *ksp = KStarsData::Instance()->skyComposite()->planet( nPlanet );
-    QColor pColor = ksp->color();
-    QVector<QPointF> vRise, vSet, vTransit;
+SkyCalendar::EventChunk SkyCalendar::computeChunk( const EventChunk &chunk ) {
+    EventChunk result = chunk;
+    const KSPlanetBase *ksp = chunk.ksp;
+    const GeoLocation *geo = chunk.geo;
 
-    for( KStarsDateTime kdt( QDate( year(), 1, 1 ), QTime( 12, 0, 0 ) );
-         kdt.date().year() == year();
-         kdt = kdt.addDays( scUI->spinBox_Interval->value() ) )
+    for( QDate date( chunk.year, chunk.month, 1 ); date.month() == chunk.month; date = date.addDays( 1 ) )
     {
+        // Days are sampled every interval days from the first of January
+        if ( ( date.dayOfYear() - 1 ) % chunk.interval )
+            continue;
+
+        KStarsDateTime kdt( date, QTime( 12, 0, 0 ) );
         float rTime, sTime, tTime;
         
         //Compute rise/set/transit times.  If they occur before noon, 
@@ -192,12 +307,19 @@ void SkyCalendar::addPlanetEvents( int nPlanet ) {
         else
             tTime = -12.0 - tTime;
         
-        float dy = kdt.date().daysInYear() - kdt.date().dayOfYear();
-        vRise << QPointF( rTime, dy );
-        vSet << QPointF( sTime, dy );
-        vTransit << QPointF( tTime, dy );
+        float dy = date.daysInYear() - date.dayOfYear();
+        result.vRise << QPointF( rTime, dy );
+        result.vSet << QPointF( sTime, dy );
+        result.vTransit << QPointF( tTime, dy );
     }    
 
+    return result;
+}
+
+void SkyCalendar::addPlanetEvents( int nPlanet, const QVector<QPointF> &vRise, const QVector<QPointF> &vSet, const QVector<QPointF> &vTransit ) {
+    KSPlanetBase *ksp = KStarsData::Instance()->skyComposite()->planet( nPlanet );
+    QColor pColor = ksp->color();
+
     //Now, find continuous segments in each QVector and add each segment 
     //as a separate KPlotObject
 
@@ -19,10 +19,16 @@
 #define SKYCALENDAR_H_
 
 #include <QDialog>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QVector>
+#include <QPointF>
 
 #include "ui_skycalendar.h"
 
 class GeoLocation;
+class KSPlanetBase;
+class KSPlanet;
 
 class SkyCalendarUI : public QFrame, public Ui::SkyCalendar {
     Q_OBJECT
@@ -52,13 +58,64 @@ class SkyCalendar : public QDialog
         void slotFillCalendar();
         void slotPrint();
         void slotLocation();
+
+    private slots:
+        /**
+         * @short Store a chunk of events computed in the background and redraw the calendar
+         * @param index index of the result in the running computation
+         */
+        void slotChunkReady( int index );
         
     private:
-        void addPlanetEvents( int nPlanet );
+        /**
+         * @struct EventChunk
+         * Rise, set and transit times of one planet during one month, in the coordinates
+         * of the calendar plot. The times are computed in the background, one chunk per task.
+         */
+        struct EventChunk {
+            QString key;
+            int planet;
+            int year;
+            int month;
+            int interval;
+            const GeoLocation *geo;
+            const KSPlanetBase *ksp;
+            QVector<QPointF> vRise, vSet, vTransit;
+        };
+
+        /**
+         * @short Compute the events of a chunk. This is run on the global thread pool.
+         * @param chunk the chunk to compute
+         * @return a copy of the chunk with the events filled in
+         */
+        static EventChunk computeChunk( const EventChunk &chunk );
+
+        /** @return the key of the current year, location and interval in the cache of events */
+        QString cacheKey();
+
+        /** @return the planets selected in the dialog */
+        QList<int> selectedPlanets();
+
+        /**
+         * @short Redraw the calendar from the events available in the cache.
+         * Only the months computed from the beginning of the year are drawn for each planet.
+         */
+        void drawCalendar();
+
+        void addPlanetEvents( int nPlanet, const QVector<QPointF> &vRise, const QVector<QPointF> &vSet, const QVector<QPointF> &vTransit );
         void drawEventLabel( float x1, float y1, float x2, float y2, QString LabelText );
         
         SkyCalendarUI *scUI;
         GeoLocation *geo;
+
+        // Computed events, per year/location key and per planet*12+month
+        QHash<QString, QHash<int, EventChunk> > m_Events;
+        QFutureWatcher<EventChunk> m_Watcher;
+        // Copies of the planets the running computation works on, one per chunk
+        QList<KSPlanet *> m_ChunkPlanets;
+        // Key and planets of the calendar being shown
+        QString m_Key;
+        QList<int> m_Planets;
 };
 
 #endif
@@ -26,6 +26,13 @@
 
 #include <QList>
 
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
 
 QList<StarObject *> * StarHopper::computePath( const SkyPoint &src, const SkyPoint &dest, float fov__, float maglim__, QStringList *metadata_ ) {
     QList<const StarObject *> starHopList_const = computePath_const( src, dest, fov__, maglim__, metadata_ );
@@ -43,37 +50,56 @@ QList<const StarObject *> StarHopper::computePath_const( const SkyPoint &src, co
     start = &src;
     end = &dest;
 
-    came_from.clear();
     result_path.clear();
 
-    // Implements the A* search algorithm
+    qDebug() << "StarHopper is trying to compute a path from source: " << src.ra().toHMSString() << src.dec().toDMSString() << " to destination: " << dest.ra().toHMSString() << dest.dec().toDMSString() << "; a starhop of " << src.angularDistanceTo( &dest ).Degrees() << " degrees!";
 
-    QList<SkyPoint const *> cSet;
-    QList<SkyPoint const *> oSet;
-    QHash<SkyPoint const *, double> g_score;
-    QHash<SkyPoint const *, double> f_score;
-    QHash<SkyPoint const *, double> h_score;
+    buildCorridor();
+
+    // Implements the A* search algorithm, the open set being a binary
+    // heap of (f_score, node). Nodes whose score improved are pushed
+    // again, and outdated entries are skipped when popped.
+
+    const int nodeCount = nodes.size();
+    const double inf = std::numeric_limits<double>::infinity();
+    QVector<double> g_score( nodeCount, inf );
+    QVector<double> f_score( nodeCount, inf );
+    QVector<double> h_score( nodeCount, 0.0 );
+    QVector<bool> closed( nodeCount, false );
+
+    double dx, dy, dz;
+    {
+        double sinRA, cosRA, sinDec, cosDec;
+        dest.ra().SinCos( sinRA, cosRA );
+        dest.dec().SinCos( sinDec, cosDec );
+        dx = cosDec * cosRA;
+        dy = cosDec * sinRA;
+        dz = sinDec;
+    }
+    for( int i = 0; i < nodeCount; ++i ) {
+        double cx = ny[i] * dz - nz[i] * dy;
+        double cy = nz[i] * dx - nx[i] * dz;
+        double cz = nx[i] * dy - ny[i] * dx;
+        double dot = nx[i] * dx + ny[i] * dy + nz[i] * dz;
+        h_score[i] = atan2( sqrt( cx * cx + cy * cy + cz * cz ), dot ) / dms::DegToRad / fov;
+    }
 
-    qDebug() << "StarHopper is trying to compute a path from source: " << src.ra().toHMSString() << src.dec().toDMSString() << " to destination: " << dest.ra().toHMSString() << dest.dec().toDMSString() << "; a starhop of " << src.angularDistanceTo( &dest ).Degrees() << " degrees!";
+    typedef std::pair<double, int> OpenEntry;
+    std::priority_queue< OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry> > oSet;
 
-    oSet.append( &src );
-    g_score[ &src ] = 0;
-    h_score[ &src ] = src.angularDistanceTo( &dest ).Degrees()/fov;
-    f_score[ &src ] = h_score[ &src ];
+    g_score[ 0 ] = 0;
+    f_score[ 0 ] = h_score[ 0 ];
+    oSet.push( OpenEntry( f_score[ 0 ], 0 ) );
 
-    while( !oSet.isEmpty() ) {
-        qDebug() << "Next step";
+    while( !oSet.empty() ) {
         // Find the node with the lowest f_score value
-        SkyPoint const *curr_node = NULL;
-        double lowfscore = 1.0e8;
-        foreach( const SkyPoint *sp, oSet ) {
-            if( f_score[ sp ] < lowfscore ) {
-                lowfscore = f_score[ sp ];
-                curr_node = sp;
-            }
-        }
-        qDebug() << "Lowest fscore (vertex distance-plus-cost score) is " << lowfscore << " with coords: " << curr_node->ra().toHMSString() << curr_node->dec().toDMSString() << ". Considering this node now.";
-        if( curr_node == &dest || (curr_node != &src && h_score[ curr_node ] < 0.5) ) {
+        OpenEntry top = oSet.top();
+        oSet.pop();
+        int curr_node = top.second;
+        if( closed[ curr_node ] || top.first > f_score[ curr_node ] )
+            continue; // Outdated entry
+
+        if( curr_node != 0 && h_score[ curr_node ] < 0.5 ) {
             // We are at destination
             reconstructPath( came_from[ curr_node ] );
             qDebug() << "We've arrived at the destination! Yay! Result path count: " << result_path.count();
@@ -103,7 +129,6 @@ QList<const StarObject *> StarHopper::computePath_const( const SkyPoint &src, co
                         qDebug() << starHopDirections;
                     }
                     metadata->append( starHopDirections );
-                    qDebug() << "Appended starHopDirections to metadata";
                 }
                 prevHop = hopStar;
 
@@ -113,55 +138,34 @@ QList<const StarObject *> StarHopper::computePath_const( const SkyPoint &src, co
             return result_path;
         }
 
-        oSet.removeOne( curr_node );
-        cSet.append( curr_node );
+        closed[ curr_node ] = true;
 
         // FIXME: Make sense. If current node ---> dest distance is
         // larger than src --> dest distance by more than 20%, don't
         // even bother considering it.
 
-        if( h_score[ curr_node ] > h_score[ &src ] * 1.2 ) {
-            qDebug() << "Node under consideration has larger distance to destination (h-score) than start node! Ignoring it.";
+        if( h_score[ curr_node ] > h_score[ 0 ] * 1.2 )
             continue;
-        }
-
-        SkyPoint const *nhd_node;
 
         // Get the list of stars that are neighbours of this node
-        QList<StarObject *> neighbors;
-
-        // FIXME: Actually, this should be done in
-        // HorizontalToEquatorial, but we do it here because SkyPoint
-        // needs a lot of fixing to handle unprecessed and precessed,
-        // equatorial and horizontal coordinates nicely
-        SkyPoint *CurrentNode = const_cast<SkyPoint *>(curr_node);
-        CurrentNode->deprecess( KStarsData::Instance()->updateNum() );
-        qDebug() << "Calling starsInAperture";
-        StarComponent::Instance()->starsInAperture( neighbors, *curr_node, fov, maglim );
-        qDebug() << "Choosing next node from a set of " << neighbors.count();
+        if( !neighborsFound[ curr_node ] ) {
+            findNeighbors( curr_node, fov, maglim, neighborCache[ curr_node ] );
+            neighborsFound[ curr_node ] = true;
+        }
+
         // Look for the potential next node
         double curr_g_score = g_score[ curr_node ];
-        foreach( nhd_node, neighbors ) {
-            if( cSet.contains( nhd_node ) )
+        foreach( int nhd_node, neighborCache[ curr_node ] ) {
+            if( closed[ nhd_node ] )
                 continue;
 
             // Compute the tentative g_score
             double tentative_g_score = curr_g_score + cost( curr_node, nhd_node );
-            bool tentative_better;
-            if( !oSet.contains( nhd_node ) ) {
-                oSet.append( nhd_node );
-                tentative_better = true;
-            }
-            else if( tentative_g_score < g_score[ nhd_node ] )
-                tentative_better = true;
-            else
-                tentative_better = false;
-
-            if( tentative_better ) {
+            if( tentative_g_score < g_score[ nhd_node ] ) {
                 came_from[ nhd_node ] = curr_node;
                 g_score[ nhd_node ] = tentative_g_score;
-                h_score[ nhd_node ] = nhd_node->angularDistanceTo( &dest ).Degrees() / fov;
                 f_score[ nhd_node ] = g_score[ nhd_node ] + h_score[ nhd_node ];
+                oSet.push( OpenEntry( f_score[ nhd_node ], nhd_node ) );
             }
         }
     }
@@ -169,74 +173,164 @@ QList<const StarObject *> StarHopper::computePath_const( const SkyPoint &src, co
     return QList<StarObject const *>(); // Return an empty QList
 }
 
-void StarHopper::reconstructPath( SkyPoint const *curr_node ) {
-    if( curr_node != start ) {
-        StarObject const *s = dynamic_cast<StarObject const *>(curr_node);
-        Q_ASSERT( s );
+void StarHopper::buildCorridor() {
+
+    nodes.clear();
+    nx.clear();
+    ny.clear();
+    nz.clear();
+    nodeMag.clear();
+    grid.clear();
+    patternNames.clear();
+
+    // Unit vector of the source
+    double sx, sy, sz;
+    double sinRA, cosRA, sinDec, cosDec;
+    start->ra().SinCos( sinRA, cosRA );
+    start->dec().SinCos( sinDec, cosDec );
+    sx = cosDec * cosRA; sy = cosDec * sinRA; sz = sinDec;
+
+    // The search only expands nodes within 1.2 times the initial
+    // distance from the destination, and their neighbours lie within
+    // a field of view of them. The star density and pattern tests of
+    // a neighbour look one more field of view around it. A cap around
+    // the destination of that radius covers everything the search can
+    // look at.
+    SkyPoint center;
+    center.setRA( end->ra() );
+    center.setDec( end->dec() );
+    // FIXME: Actually, this should be done in
+    // HorizontalToEquatorial, but we do it here because SkyPoint
+    // needs a lot of fixing to handle unprecessed and precessed,
+    // equatorial and horizontal coordinates nicely
+    center.deprecess( KStarsData::Instance()->updateNum() );
+
+    double span = start->angularDistanceTo( end ).Degrees();
+    double radius = qMin( 1.2 * span + 2.0 * fov, 180.0 );
+
+    QList<StarObject *> stars;
+    StarComponent::Instance()->starsInAperture( stars, center, radius, maglim + 1.0 );
+    qDebug() << "StarHopper fetched " << stars.count() << " stars in a corridor of " << radius << " degrees";
+
+    const int nodeCount = stars.count() + 1;
+    nodes.reserve( nodeCount );
+    nx.reserve( nodeCount );
+    ny.reserve( nodeCount );
+    nz.reserve( nodeCount );
+    nodeMag.reserve( nodeCount );
+
+    nodes.append( start );
+    nx.append( sx );
+    ny.append( sy );
+    nz.append( sz );
+    nodeMag.append( 0.0 ); // Unused, the source is never a hop candidate
+
+    cellSize = 2.0 * sin( 0.5 * fov * dms::DegToRad );
+    foreach( StarObject *star, stars ) {
+        if( star->mag() > maglim + 1.0 )
+            continue;
+        star->ra().SinCos( sinRA, cosRA );
+        star->dec().SinCos( sinDec, cosDec );
+        int index = nodes.size();
+        nodes.append( star );
+        nx.append( cosDec * cosRA );
+        ny.append( cosDec * sinRA );
+        nz.append( sinDec );
+        nodeMag.append( star->mag() );
+
+        qint64 ix = qint64( floor( ( nx[index] + 1.0 ) / cellSize ) );
+        qint64 iy = qint64( floor( ( ny[index] + 1.0 ) / cellSize ) );
+        qint64 iz = qint64( floor( ( nz[index] + 1.0 ) / cellSize ) );
+        grid[ ( ix << 42 ) | ( iy << 21 ) | iz ].append( index );
+    }
+
+    came_from.fill( -1, nodes.size() );
+    starCostCache.fill( std::numeric_limits<float>::quiet_NaN(), nodes.size() );
+    neighborCache.clear();
+    neighborCache.resize( nodes.size() );
+    neighborsFound.fill( false, nodes.size() );
+}
+
+void StarHopper::findNeighbors( int node, double radius, float magLimit, QVector<int> &result ) const {
+    const double x = nx[ node ], y = ny[ node ], z = nz[ node ];
+    const double minDot = cos( radius * dms::DegToRad );
+
+    // The chord of the radius is at most one cell, so the
+    // neighbouring cells contain all the stars we are looking for
+    qint64 ix = qint64( floor( ( x + 1.0 ) / cellSize ) );
+    qint64 iy = qint64( floor( ( y + 1.0 ) / cellSize ) );
+    qint64 iz = qint64( floor( ( z + 1.0 ) / cellSize ) );
+    for( qint64 i = ix - 1; i <= ix + 1; ++i ) {
+        for( qint64 j = iy - 1; j <= iy + 1; ++j ) {
+            for( qint64 k = iz - 1; k <= iz + 1; ++k ) {
+                QHash<qint64, QVector<int> >::const_iterator cell = grid.constFind( ( i << 42 ) | ( j << 21 ) | k );
+                if( cell == grid.constEnd() )
+                    continue;
+                foreach( int other, cell.value() ) {
+                    if( other == node || nodeMag[ other ] > magLimit )
+                        continue;
+                    if( x * nx[ other ] + y * ny[ other ] + z * nz[ other ] >= minDot )
+                        result.append( other );
+                }
+            }
+        }
+    }
+}
+
+double StarHopper::nodeDistance( int a, int b ) const {
+    double cx = ny[a] * nz[b] - nz[a] * ny[b];
+    double cy = nz[a] * nx[b] - nx[a] * nz[b];
+    double cz = nx[a] * ny[b] - ny[a] * nx[b];
+    double dot = nx[a] * nx[b] + ny[a] * ny[b] + nz[a] * nz[b];
+    return atan2( sqrt( cx * cx + cy * cy + cz * cz ), dot ) / dms::DegToRad;
+}
+
+void StarHopper::reconstructPath( int curr_node ) {
+    while( curr_node > 0 ) {
+        StarObject const *s = static_cast<StarObject const *>( nodes[ curr_node ] );
         result_path.prepend( s );
-        reconstructPath( came_from[ s ] );
+        curr_node = came_from[ curr_node ];
     }
 }
 
-float StarHopper::cost( const SkyPoint *curr, const SkyPoint *next ) {
+float StarHopper::cost( int curr, int next ) {
 
     // This is a very heuristic method, that tries to produce a cost
     // for each hop.
 
-    float netcost = 0;
-
-    // Convert 'next' into a StarObject
-    if( next == start ) {
-        // If the next hop is back to square one, junk it
-        return 1e8;
-    }
-    bool isThisTheEnd = (next == end);
-
-    float magcost, speccost;
-    magcost = speccost = 0;
-
-    if( !isThisTheEnd ) {
-        // We ought to be dealing with a star
-        StarObject const *nextstar = dynamic_cast<StarObject const *>(next);
-        Q_ASSERT( nextstar );
-
-        // Test 1: How bright is the star?
-        magcost = nextstar->mag() - 7.0 + 5 * log10( fov ); // The brighter, the better. FIXME: 8.0 is now an arbitrary reference to the average faint star. Should actually depend on FOV, something like log( FOV ).
-
-        // Test 2: Is the star strikingly red / yellow coloured?
-        QString SpType = nextstar->sptype();
-        char spclass = SpType.at( 0 ).toLatin1();
-        speccost = ( spclass == 'G' || spclass == 'K' || spclass == 'M' ) ? -0.3 : 0;
-        /*
-        // Test 3: Is the star in the general direction of the object?
-        // We use the cosine rule to find the angle between the hop direction, and the direction to destination
-        // a = side joining curr to end
-        // b = side joining curr to next
-        // c = side joining next to end
-        // C = angle between curr-next and curr-end
-        double sina, sinb, cosa, cosb;
-        curr->angularDistanceTo(dest).SinCos( &sina, &cosa );
-        curr->angularDistanceTo(next).SinCos( &sinb, &cosb );
-        double cosc = cos(next->angularDistanceTo(end).radians());
-        double cosC = ( cosc - cosa * cosb ) / (sina * sinb);
-        float dircost;
-        if( cosC < 0 ) // Wrong direction!
-        dircost = 1e8; // Some humongous number;
-        else
-        dircost = sqrt( 1 - cosC * cosC ) / cosC; // tan( C )
-        */
-    }
+    Q_ASSERT( next > 0 );
 
     // Test 4: How far is the hop?
-    double distcost = (curr->angularDistanceTo( next ).Degrees() / fov); // 1 "magnitude" incremental cost for 1 FOV. Is this even required, or is it just equivalent to halving our distance unit? I think it is required since the hop is not necessarily in the direction of the object -- asimha
+    double distcost = nodeDistance( curr, next ) / fov; // 1 "magnitude" incremental cost for 1 FOV. Is this even required, or is it just equivalent to halving our distance unit? I think it is required since the hop is not necessarily in the direction of the object -- asimha
 
     // Test 5: How effective is the hop? [Might not be required with A*]
     //    double distredcost = -((src->angularDistanceTo( dest ).Degrees() - next->angularDistanceTo( dest ).Degrees()) * 60 / fov)*3; // 3 "magnitudes" for 1 FOV closer
 
+    float netcost = starCost( next ) + distcost;
+    if( netcost < 0 )
+        netcost = 0.1; // FIXME: Heuristics aren't supposed to be entirely random. This one is.
+    return netcost;
+}
+
+float StarHopper::starCost( int next ) {
+
+    if( !std::isnan( starCostCache[ next ] ) )
+        return starCostCache[ next ];
+
+    StarObject const *nextstar = static_cast<StarObject const *>( nodes[ next ] );
+
+    // Test 1: How bright is the star?
+    float magcost = nextstar->mag() - 7.0 + 5 * log10( fov ); // The brighter, the better. FIXME: 8.0 is now an arbitrary reference to the average faint star. Should actually depend on FOV, something like log( FOV ).
+
+    // Test 2: Is the star strikingly red / yellow coloured?
+    QString SpType = nextstar->sptype();
+    char spclass = SpType.isEmpty() ? 0 : SpType.at( 0 ).toLatin1();
+    float speccost = ( spclass == 'G' || spclass == 'K' || spclass == 'M' ) ? -0.3 : 0;
+
     // Test 6: Is the destination an asterism? Are there bright stars clustered nearby?
-    QList<StarObject *> localNeighbors;
-    StarComponent::Instance()->starsInAperture( localNeighbors, *next, fov/10, maglim + 1.0 );
-    double stardensitycost = 1 - localNeighbors.count(); // -1 "magnitude" for every neighbouring star
+    QVector<int> localNeighbors;
+    findNeighbors( next, fov/10, maglim + 1.0, localNeighbors );
+    double stardensitycost = -localNeighbors.count(); // -1 "magnitude" for every neighbouring star, the star itself not being penalized
 
     // Test 7: Identify star patterns
 
@@ -245,73 +339,66 @@ float StarHopper::cost( const SkyPoint *curr, const SkyPoint *next ) {
 
     double patterncost = 0;
     QString patternName;
-    if( !isThisTheEnd ) {
-        // We ought to be dealing with a star
-        StarObject const *nextstar = dynamic_cast<StarObject const *>(next);
-        Q_ASSERT( nextstar );
-
-        float factor = 1.0;
-        while( factor <= 10.0 ) {
-            localNeighbors.clear();
-            StarComponent::Instance()->starsInAperture( localNeighbors, *next, fov/factor, nextstar->mag() + 1.0 ); // Use a larger aperture for pattern identification; max 1.0 mag difference
-            foreach( StarObject *star, localNeighbors ) {
-                if( star == nextstar )
-                    localNeighbors.removeOne( star );
-                else if( fabs( star->mag() - nextstar->mag() ) > 1.0 )
-                    localNeighbors.removeOne( star );
-            } // Now, we should have a pruned list
-            factor += 1.0;
-            if( localNeighbors.size() == 2 )
-                break;
+
+    float factor = 1.0;
+    while( factor <= 10.0 ) {
+        // Use a larger aperture for pattern identification; max 1.0 mag difference
+        QVector<int> candidates;
+        findNeighbors( next, fov/factor, nextstar->mag() + 1.0, candidates );
+        localNeighbors.clear();
+        foreach( int star, candidates ) {
+            if( fabs( nodeMag[ star ] - nextstar->mag() ) <= 1.0 )
+                localNeighbors.append( star );
+        } // Now, we should have a pruned list
+        factor += 1.0;
+        if( localNeighbors.size() == 2 )
+            break;
+    }
+    factor -= 1.0;
+    if( localNeighbors.size() == 2 ) {
+        patternName = "triangle (of similar magnitudes)"; // any three stars form a triangle!
+        // Try to find triangles. Note that we assume that the standard Euclidian metric works on a sphere for small angles, i.e. the celestial sphere is nearly flat over our FOV.
+        const SkyPoint *star1 = nodes[ localNeighbors[0] ];
+        double dRA1 = nextstar->ra().radians() - star1->ra().radians();
+        double dDec1 = nextstar->dec().radians() - star1->dec().radians();
+        double dist1sqr = dRA1 * dRA1 + dDec1 * dDec1;
+
+        const SkyPoint *star2 = nodes[ localNeighbors[1] ];
+        double dRA2 = nextstar->ra().radians() - star2->ra().radians();
+        double dDec2 = nextstar->dec().radians() - star2->dec().radians();
+        double dist2sqr = dRA2 * dRA2 + dDec2 * dDec2;
+
+        // Check for right-angled triangles (without loss of generality, right angle is at this vertex)
+        if( fabs( (dRA1 * dRA2 - dDec1 * dDec2)/sqrt( dist1sqr * dist2sqr ) ) < RIGHT_ANGLE_THRESHOLD ) {
+            // We have a right angled triangle! Give -3 magnitudes!
+            patterncost += -3;
+            patternName = "right-angled triangle";
         }
-        factor -= 1.0;
-        if( localNeighbors.size() == 2 ) {
-            patternName = "triangle (of similar magnitudes)"; // any three stars form a triangle!
-            // Try to find triangles. Note that we assume that the standard Euclidian metric works on a sphere for small angles, i.e. the celestial sphere is nearly flat over our FOV.
-            StarObject *star1 = localNeighbors[0];
-            double dRA1 = nextstar->ra().radians() - star1->ra().radians();
-            double dDec1 = nextstar->dec().radians() - star1->dec().radians();
-            double dist1sqr = dRA1 * dRA1 + dDec1 * dDec1;
-
-            StarObject *star2 = localNeighbors[1];
-            double dRA2 = nextstar->ra().radians() - star2->ra().radians();
-            double dDec2 = nextstar->dec().radians() - star2->dec().radians();
-            double dist2sqr = dRA2 * dRA2 + dDec2 * dDec2;
-
-            // Check for right-angled triangles (without loss of generality, right angle is at this vertex)
-            if( fabs( (dRA1 * dRA2 - dDec1 * dDec2)/sqrt( dist1sqr * dist2sqr ) ) < RIGHT_ANGLE_THRESHOLD ) {
-                // We have a right angled triangle! Give -3 magnitudes!
-                patterncost += -3;
-                patternName = "right-angled triangle";
-            }
 
-            // Check for isosceles triangles (without loss of generality, this is the vertex)
-            if( fabs( (dist1sqr - dist2sqr) / (dist1sqr) ) < EQUAL_EDGE_THRESHOLD ) {
+        // Check for isosceles triangles (without loss of generality, this is the vertex)
+        if( fabs( (dist1sqr - dist2sqr) / (dist1sqr) ) < EQUAL_EDGE_THRESHOLD ) {
+            patterncost += -1;
+            patternName = "isosceles triangle";
+            if( fabs( (dRA2 * dDec1 - dRA1 * dDec2) / sqrt( dist1sqr * dist2sqr ) ) < RIGHT_ANGLE_THRESHOLD ) {
                 patterncost += -1;
-                patternName = "isosceles triangle";
-                if( fabs( (dRA2 * dDec1 - dRA1 * dDec2) / sqrt( dist1sqr * dist2sqr ) ) < RIGHT_ANGLE_THRESHOLD ) {
-                    patterncost += -1;
-                    patternName = "straight line of 3 stars";
-                }
-                // Check for equilateral triangles
-                double dist3 = star1->angularDistanceTo( star2 ).radians();
-                double dist3sqr = dist3 * dist3;
-                if( fabs( (dist3sqr - dist1sqr) / dist1sqr ) < EQUAL_EDGE_THRESHOLD ) {
-                    patterncost += -1;
-                    patternName = "equilateral triangle";
-                }
+                patternName = "straight line of 3 stars";
+            }
+            // Check for equilateral triangles
+            double dist3 = nodeDistance( localNeighbors[0], localNeighbors[1] ) * dms::DegToRad;
+            double dist3sqr = dist3 * dist3;
+            if( fabs( (dist3sqr - dist1sqr) / dist1sqr ) < EQUAL_EDGE_THRESHOLD ) {
+                patterncost += -1;
+                patternName = "equilateral triangle";
             }
         }
-        // TODO: Identify squares.
-        if( ! patternName.isEmpty() ) {
-            patternName += QString(" within %1% of FOV of the marked star").arg( (int)( 100.0/factor ) );
-            patternNames.insert( nextstar, patternName );
-        }
+    }
+    // TODO: Identify squares.
+    if( ! patternName.isEmpty() ) {
+        patternName += QString(" within %1% of FOV of the marked star").arg( (int)( 100.0/factor ) );
+        patternNames.insert( nextstar, patternName );
     }
 
-    netcost = magcost + speccost + distcost + stardensitycost + patterncost;
-    if( netcost < 0 )
-        netcost = 0.1; // FIXME: Heuristics aren't supposed to be entirely random. This one is.
-    qDebug() << "Mag cost: " << magcost << "; Spec Cost: " << speccost << "; Dist Cost: " << distcost << "; Density cost: " << stardensitycost << "; Pattern cost: " << patterncost << "; Net cost: " << netcost << "; Pattern: " << patternName;
-    return netcost;
+    float intrinsiccost = magcost + speccost + stardensitycost + patterncost;
+    starCostCache[ next ] = intrinsiccost;
+    return intrinsiccost;
 }
@@ -29,6 +29,9 @@
 #include "skyobject.h"
 #include "starobject.h"
 
+#include <QHash>
+#include <QVector>
+
 class StarHopper {
  public:
     /**
@@ -51,25 +54,61 @@ class StarHopper {
     // Useful for internal computations
     SkyPoint const *start;
     SkyPoint const *end;
-    QHash<const SkyPoint *, const SkyPoint *> came_from; // Used by the A* search algorithm
     QList<StarObject const *> result_path;
 
+    // Dense node storage for the A* search. Node 0 is the starting
+    // point, the other nodes are the stars of the route corridor.
+    QVector<const SkyPoint *> nodes;
+    QVector<double> nx, ny, nz;                 // Unit vectors of the nodes
+    QVector<float> nodeMag;
+    QVector<int> came_from;                     // Used by the A* search algorithm, -1 if none
+    QVector<float> starCostCache;               // Cost of a star independent of the hop, NaN until computed
+    QVector< QVector<int> > neighborCache;      // Hop candidates within a field of view, computed on demand
+    QVector<bool> neighborsFound;
+
+    // Spatial hash of the star nodes, the cell size being the chord of a field of view
+    QHash<qint64, QVector<int> > grid;
+    double cellSize;
+
+    /**
+     *@short Fetch the stars of the route corridor with a single aperture query and fill the node storage
+     */
+    void buildCorridor();
+
+    /**
+     *@short Find the star nodes around a node
+     *@param node index of the node
+     *@param radius radius of the search, in degrees. Must not exceed the field of view
+     *@param magLimit faintest magnitude of the stars returned
+     *@param result the indices of the stars found are appended to this vector
+     */
+    void findNeighbors( int node, double radius, float magLimit, QVector<int> &result ) const;
+
+    /**
+     *@return the angular distance between two nodes, in degrees
+     */
+    double nodeDistance( int a, int b ) const;
+
     /**
      *@short The cost function for hopping from current position to the a given star, in view of the final destination
-     *@param curr Source SkyPoint
-     *@param next Next point in the hop.
-     *@note If 'next' is neither the starting point of the hop, nor
-     * the ending point, it _has_ to be a StarObject. A dynamic cast
-     * followed by a Q_ASSERT will ensure this.
+     *@param curr index of the source node
+     *@param next index of the next node in the hop, which must be a star
+     */
+    float cost( int curr, int next );
+
+    /**
+     *@short The part of the cost of a star that does not depend on the hop
+     * (brightness, colour, star density and patterns). It is computed once per star.
+     *@param next index of the star node
      */
-    float cost( const SkyPoint *curr, const SkyPoint *next );
+    float starCost( int next );
 
     /**
      *@short For internal use by the A* Search Algorithm. Completes
      * the star-hop path. See
      * http://en.wikipedia.org/wiki/A*_search_algorithm for details
      */
-    void reconstructPath( SkyPoint const *curr_node );
+    void reconstructPath( int curr_node );
 
     QHash< SkyPoint const *, QString > patternNames; // if patterns were identified, they are added to this hash.
 
@@ -20,8 +20,15 @@
 #include "kstarsdatetime.h"
 #include "skymapcomposite.h"
 #include "skyobject.h"
+#include "starobject.h"
+#include "ksnumbers.h"
 
-ModelManager::ModelManager(ObsConditions *obs)
+#include <QtConcurrent>
+
+/// Number of interesting objects checked by a worker thread at a time
+static const int BatchSize = 32;
+
+ModelManager::ModelManager(ObsConditions *obs, QObject *parent) : QObject(parent), m_Resolved(false), m_NextBatch(0)
 {
     m_ObsConditions = obs;
     m_PlanetsModel = new SkyObjListModel();
@@ -31,16 +38,17 @@ ModelManager::ModelManager(ObsConditions *obs)
     m_ClustModel = new SkyObjListModel();
     m_NebModel = new SkyObjListModel();
 
-    m_InitObjects[Star_Model] = QList<SkyObject *>();
-    m_InitObjects[Galaxy_Model] = QList<SkyObject *>();
-    m_InitObjects[Constellation_Model] = QList<SkyObject *>();
-    m_InitObjects[Cluster_Model] = QList<SkyObject *>();
-    m_InitObjects[Nebula_Model] = QList<SkyObject *>();
+    connect(&m_Watcher, SIGNAL(resultReadyAt(int)), this, SLOT(slotBatchReady()));
+    connect(&m_Watcher, SIGNAL(finished()), this, SLOT(slotUpdateFinished()));
+
     updateModels(obs);
 }
 
 ModelManager::~ModelManager()
 {
+    m_Watcher.cancel();
+    m_Watcher.waitForFinished();
+
     delete m_PlanetsModel;
     delete m_StarsModel;
     delete m_GalModel;
@@ -52,101 +60,145 @@ ModelManager::~ModelManager()
 void ModelManager::updateModels(ObsConditions *obs)
 {
     m_ObsConditions = obs;
-    m_InitObjects.clear();
-    resetModels();
-
-    KStarsData *data = KStarsData::Instance();
 
-    KSFileReader fileReader;
-    if (!fileReader.open("Interesting.dat")) return;
+    // Batches are small, so a running update stops quickly
+    m_Watcher.cancel();
+    m_Watcher.waitForFinished();
 
-    while (fileReader.hasMoreLines())
-    {
-        QString line = fileReader.readLine();
-
-        if (line.length() == 0 || line[0] == '#')
-            continue;
+    resetModels();
 
-        SkyObject *o;
-        if ((o = data->skyComposite()->findByName(line)))
-        {
-            //qDebug()<<o->longname()<<o->typeName();
-            switch(o->type())
-            {
-                case SkyObject::OPEN_CLUSTER:
-                case SkyObject::GLOBULAR_CLUSTER:
-                case SkyObject::GALAXY_CLUSTER:
-                    m_InitObjects[Cluster_Model].append(o);
-                    break;
-                case SkyObject::PLANETARY_NEBULA:
-                case SkyObject::DARK_NEBULA:
-                case SkyObject::GASEOUS_NEBULA:
-                    m_InitObjects[Nebula_Model].append(o);
-                    break;
-                case SkyObject::STAR:
-                    m_InitObjects[Star_Model].append(o);
-                    break;
-                case SkyObject::CONSTELLATION:
-                    m_InitObjects[Constellation_Model].append(o);
-                    break;
-                case SkyObject::GALAXY:
-                    m_InitObjects[Galaxy_Model].append(o);
-                    break;
-            }
-        }
-    }
+    KStarsData *data = KStarsData::Instance();
 
-    foreach (SkyObject *so, m_InitObjects.value(Star_Model))
+    // Planets move, and computing their phase is not thread-safe, so
+    // the few of them are checked right away
+    foreach (const QString &name, data->skyComposite()->objectNames(SkyObject::PLANET))
     {
-        //qDebug()<<so->longname()<<so->typeName();
+        SkyObject *so = data->skyComposite()->findByName(name);
+        //qDebug()<<so->name()<<so->mag();
         if (m_ObsConditions->isVisible(data->geo(), data->lst(), so))
         {
-            m_StarsModel->addSkyObject(new SkyObjItem(so));
+            if (so->name() == "Sun") continue;
+            m_PlanetsModel->addSkyObject(new SkyObjItem(so));
         }
     }
 
-    foreach (SkyObject *so, m_InitObjects.value(Galaxy_Model))
+    if (!m_Resolved)
     {
-        //qDebug()<<so->longname()<<so->typeName();
-        if (m_ObsConditions->isVisible(data->geo(), data->lst(), so))
+        KSFileReader fileReader;
+        if (!fileReader.open("Interesting.dat")) return;
+
+        while (fileReader.hasMoreLines())
         {
-            m_GalModel->addSkyObject(new SkyObjItem(so));
+            QString line = fileReader.readLine();
+
+            if (line.length() == 0 || line[0] == '#')
+                continue;
+
+            SkyObject *o;
+            if ((o = data->skyComposite()->findByName(line)))
+                m_InitObjects.append(o);
         }
+        m_Resolved = true;
     }
 
-    foreach (SkyObject *so, m_InitObjects.value(Constellation_Model))
+    // The workers only get copies of the catalogue coordinates and
+    // magnitudes, the sky objects themselves belong to this thread
+    KStarsDateTime ut = data->geo()->LTtoUT(KStarsDateTime(QDateTime::currentDateTime().toLocalTime()));
+    KSNumbers num(ut.djd());
+
+    QList<VisibilityBatch> batches;
+    VisibilityBatch batch;
+    batch.jd = ut.djd();
+    batch.lst = *data->lst();
+    batch.lat = *data->geo()->lat();
+    batch.magLim = m_ObsConditions->getTrueMagLim();
+
+    for (int i = 0; i < m_InitObjects.size(); i += BatchSize)
     {
-        if (m_ObsConditions->isVisible(data->geo(), data->lst(), so))
+        batch.first = i;
+        batch.positions.clear();
+        batch.mags.clear();
+        foreach (SkyObject *so, m_InitObjects.mid(i, BatchSize))
         {
-            m_ConModel->addSkyObject(new SkyObjItem(so));
+            CachingDms ra0(so->ra0()), dec0(so->dec0());
+            if (so->type() == SkyObject::STAR)
+                static_cast<StarObject *>(so)->getIndexCoords(&num, ra0, dec0);
+            batch.positions.append(SkyPoint(ra0, dec0));
+            batch.mags.append(so->mag());
         }
+        batches.append(batch);
     }
 
-    foreach (SkyObject *so, m_InitObjects.value(Cluster_Model))
+    m_NextBatch = 0;
+    m_Watcher.setFuture(QtConcurrent::mapped(batches, &ModelManager::filterBatch));
+}
+
+ModelManager::VisibilityBatch ModelManager::filterBatch(const VisibilityBatch &batch)
+{
+    VisibilityBatch result(batch);
+    KSNumbers num(batch.jd);
+
+    for (int i = 0; i < batch.positions.size(); ++i)
     {
-        if (m_ObsConditions->isVisible(data->geo(), data->lst(), so))
-        {
-            m_ClustModel->addSkyObject(new SkyObjItem(so));
-        }
+        SkyPoint sp = batch.positions.at(i);
+        sp.precessFromAnyEpoch(J2000, batch.jd);
+        sp.nutate(&num);
+        sp.aberrate(&num);
+
+        //check altitude of object at this time.
+        sp.EquatorialToHorizontal(&batch.lst, &batch.lat);
+        if (sp.alt().Degrees() > 6.0 && batch.mags.at(i) < batch.magLim)
+            result.visible.append(batch.first + i);
     }
+    return result;
+}
 
-    foreach (SkyObject *so, m_InitObjects.value(Nebula_Model))
+void ModelManager::slotBatchReady()
+{
+    // Results may come in any order, keep the order of Interesting.dat
+    while (m_Watcher.future().isResultReadyAt(m_NextBatch))
     {
-        if (m_ObsConditions->isVisible(data->geo(), data->lst(), so))
+        VisibilityBatch batch = m_Watcher.resultAt(m_NextBatch++);
+        foreach (int index, batch.visible)
         {
-            m_NebModel->addSkyObject(new SkyObjItem(so));
+            SkyObject *so = m_InitObjects.at(index);
+            //qDebug()<<so->longname()<<so->typeName();
+            SkyObjListModel *model = modelFor(so);
+            if (model)
+                model->addSkyObject(new SkyObjItem(so));
         }
     }
+}
 
-    foreach (const QString &name, data->skyComposite()->objectNames(SkyObject::PLANET))
+void ModelManager::slotUpdateFinished()
+{
+    if (m_Watcher.isCanceled())
+        return;
+
+    slotBatchReady();
+    emit modelsUpdated();
+}
+
+SkyObjListModel* ModelManager::modelFor(SkyObject *so)
+{
+    switch(so->type())
     {
-        SkyObject *so = data->skyComposite()->findByName(name);
-        //qDebug()<<so->name()<<so->mag();
-        if (m_ObsConditions->isVisible(data->geo(), data->lst(), so))
-        {
-            if (so->name() == "Sun") continue;
-            m_PlanetsModel->addSkyObject(new SkyObjItem(so));
-        }
+        case SkyObject::OPEN_CLUSTER:
+        case SkyObject::GLOBULAR_CLUSTER:
+        case SkyObject::GALAXY_CLUSTER:
+            return m_ClustModel;
+        case SkyObject::PLANETARY_NEBULA:
+        case SkyObject::DARK_NEBULA:
+        case SkyObject::GASEOUS_NEBULA:
+            return m_NebModel;
+        case SkyObject::STAR:
+            return m_StarsModel;
+        case SkyObject::CONSTELLATION:
+            return m_ConModel;
+        case SkyObject::GALAXY:
+            return m_GalModel;
+        default:
+            return 0;
     }
 }
 
@@ -18,6 +18,8 @@
 #ifndef MODEL_MANAGER_H
 #define MODEL_MANAGER_H
 
+#include <QFutureWatcher>
+
 #include "skyobjlistmodel.h"
 #include "kstarsdata.h"
 #include "obsconditions.h"
@@ -25,10 +27,15 @@
 /**
  * \class ModelManager
  * \brief Manages models for QML listviews of different types of sky-objects.
+ *
+ * The objects listed in Interesting.dat are resolved once and cached. Checking which of them
+ * are visible is done in the background, in small batches of coordinates, and the models are
+ * filled as the batches complete, so that the What's Interesting view opens without waiting.
  * \author Samikshan Bairagya
  */
-class ModelManager
+class ModelManager : public QObject
 {
+    Q_OBJECT
 public:
     /**
      * \enum ModelType
@@ -39,8 +46,9 @@ public:
     /**
      * \brief Constructor - Creates models for different sky-object types.
      * \param obs   Pointer to an ObsConditions object.
+     * \param parent   Parent object.
      */
-    ModelManager(ObsConditions *obs);
+    explicit ModelManager(ObsConditions *obs, QObject *parent = 0);
 
     /**
      * \brief Destructor
@@ -49,6 +57,7 @@ public:
 
     /**
      * \brief Updates sky-object list models.
+     * The models are cleared and filled again in the background. A running update is cancelled.
      */
     void updateModels(ObsConditions *obs);
 
@@ -64,10 +73,57 @@ public:
      */
     SkyObjListModel *returnModel(int type);
 
+signals:
+    /**
+     * \brief Emitted when all the models have been filled.
+     */
+    void modelsUpdated();
+
+private slots:
+    /**
+     * \brief Adds the visible objects of the batches completed so far to the models, in catalogue order.
+     */
+    void slotBatchReady();
+
+    /**
+     * \brief Emits modelsUpdated() unless the update was cancelled.
+     */
+    void slotUpdateFinished();
+
 private:
+    /**
+     * \struct VisibilityBatch
+     * \brief A batch of interesting objects checked for visibility by a worker thread.
+     */
+    struct VisibilityBatch
+    {
+        int first;                      ///Index of the first object of the batch in m_InitObjects
+        QVector<SkyPoint> positions;    ///Catalogue coordinates of the objects
+        QVector<float> mags;            ///Magnitudes of the objects
+        QList<int> visible;             ///Result: indices of the objects visible now
+        long double jd;
+        dms lst;
+        dms lat;
+        double magLim;
+    };
+
+    /**
+     * \brief Keeps the objects of a batch that are above the horizon and brighter than the limiting magnitude.
+     * This is run from worker threads, and only reads the copies of the coordinates in the batch.
+     */
+    static VisibilityBatch filterBatch(const VisibilityBatch &batch);
+
+    /**
+     * \return The model for the given sky-object, or 0 if it is not listed in What's Interesting.
+     */
+    SkyObjListModel *modelFor(SkyObject *so);
+
     ObsConditions *m_ObsConditions;
     SkyObjListModel *m_PlanetsModel, *m_StarsModel, *m_GalModel, *m_ConModel, *m_ClustModel, *m_NebModel;
-    QHash< ModelType, QList <SkyObject *> > m_InitObjects;
+    QList<SkyObject *> m_InitObjects;    ///Interesting objects, resolved on the first update
+    bool m_Resolved;
+    QFutureWatcher<VisibilityBatch> m_Watcher;
+    int m_NextBatch;
 };
 
 #endif
@@ -70,5 +70,7 @@ SkyObjItem* SkyObjListModel::getSkyObjItem(int index)
 
 void SkyObjListModel::resetModel()
 {
+    beginResetModel();
     m_SoItemList.clear();
+    endResetModel();
 }